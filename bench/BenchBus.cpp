@@ -0,0 +1,124 @@
+//
+//  BenchBus.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <initializer_list>
+#include "BenchMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// register device -----------------------------------------------------------------------------------------------------
+
+/// A block of 4 I/O registers. Does not allow direct access, so every access goes through the bus device lookup.
+class Registers: public Addressable {
+public:
+
+    Registers(word addressStart): _addressStart(addressStart) {}
+
+    virtual bool isReadable()   { return true; }
+    virtual bool isWritable()   { return true; }
+    virtual word addressStart() { return _addressStart; }
+    virtual word addressEnd()   { return _addressStart + 3; }
+
+    virtual bool read(word address, byte &data) {
+        if (address < _addressStart || address > _addressStart + 3) {
+            return false;
+        }
+        data = _registers[address - _addressStart];
+        return true;
+    }
+
+    virtual bool write(word address, byte data) {
+        if (address < _addressStart || address > _addressStart + 3) {
+            return false;
+        }
+        _registers[address - _addressStart] = data;
+        return true;
+    }
+
+private:
+    word _addressStart;
+    byte _registers[4] = {};
+};
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static const uint64_t INSTRUCTIONS = 10000000;
+
+static CPU *_cpu;
+
+BenchSetUp({
+    _cpu = new CPU();
+})
+
+BenchTearDown({
+    delete _cpu;
+})
+
+/// Attaches the given number of register blocks to page 0xD0 followed by 64K of RAM, then runs a loop that reads &
+/// writes the register block with the lowest priority, or RAM if there are none.
+static BenchResult _run(std::size_t devices) {
+    for (std::size_t i = 0; i < devices; i++) {
+        _cpu->attach(std::make_shared<Registers>(word(0xD000 + i * 4)));
+    }
+    _cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+
+    word address = devices > 0 ? word(0xD000 + (devices - 1) * 4) : 0x0200;
+    word pc      = 0x0400;
+    for (byte data : std::initializer_list<byte>{
+        0xAD, byte(address), byte(address >> 8),            // LDA address
+        0x69, 0x01,                                         // ADC #$01
+        0x8D, byte(address), byte(address >> 8),            // STA address
+        0x4C, 0x00, 0x04,                                   // JMP $0400
+    }) {
+        _cpu->write(pc++, data);
+    }
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x04);
+    _cpu->reset();
+    _cpu->step();
+
+    uint64_t start        = _cpu->getCycles();
+    uint64_t instructions = 0;
+    _cpu->runUntil([&instructions](CPU &cpu) {
+        return instructions++ == INSTRUCTIONS;
+    });
+    return (BenchResult){_cpu->getCycles() - start, INSTRUCTIONS};
+}
+
+
+// benchmarks ----------------------------------------------------------------------------------------------------------
+
+BenchCase(direct, "Direct page", {
+    return _run(0);
+})
+
+BenchCase(devices_1, "1 device", {
+    return _run(1);
+})
+
+BenchCase(devices_8, "8 devices", {
+    return _run(8);
+})
+
+BenchCase(devices_64, "64 devices", {
+    return _run(64);
+})
+
+
+// benchmark suite -----------------------------------------------------------------------------------------------------
+
+BenchSuite(BenchBus, {
+    bench_direct();
+    bench_devices_1();
+    bench_devices_8();
+    bench_devices_64();
+});
@@ -0,0 +1,114 @@
+//
+//  BenchCores.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include "BenchMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static const uint64_t CYCLES = 20000000;
+
+static CPU *_cpu;
+
+BenchSetUp({
+    _cpu = new CPU();
+    _cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+
+    // copies a page with indirect indexed addressing, then calls a subroutine using the stack
+    word address = 0x0400;
+    for (byte data : {
+        0xA0, 0x00,                     // LDY #$00
+        0xB1, 0x20,                     // LDA ($20),Y
+        0x91, 0x22,                     // STA ($22),Y
+        0xC8,                           // INY
+        0xD0, 0xF9,                     // BNE $0402
+        0xE6, 0x24,                     // INC $24
+        0x20, 0x20, 0x04,               // JSR $0420
+        0x4C, 0x00, 0x04,               // JMP $0400
+    }) {
+        _cpu->write(address++, data);
+    }
+
+    address = 0x0420;
+    for (byte data : {
+        0x48,                           // PHA
+        0x68,                           // PLA
+        0x60,                           // RTS
+    }) {
+        _cpu->write(address++, data);
+    }
+
+    _cpu->write(0x0020, 0x00);          // ($20) -> 0x1000
+    _cpu->write(0x0021, 0x10);
+    _cpu->write(0x0022, 0x00);          // ($22) -> 0x2000
+    _cpu->write(0x0023, 0x20);
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x04);
+    _cpu->reset();
+})
+
+BenchTearDown({
+    delete _cpu;
+})
+
+
+// benchmarks ----------------------------------------------------------------------------------------------------------
+
+BenchCase(instruction_run, "Instruction level, run", {
+    _cpu->run(CYCLES);
+    return (BenchResult){_cpu->getCycles(), 0};
+})
+
+BenchCase(instruction_tick, "Instruction level, tick", {
+    for (uint64_t i = 0; i < CYCLES; i++) {
+        _cpu->tick();
+    }
+    return (BenchResult){_cpu->getCycles(), 0};
+})
+
+BenchCase(predecoded_run, "Predecoded, run", {
+    _cpu->setPredecoding(true);
+    _cpu->run(CYCLES);
+    return (BenchResult){_cpu->getCycles(), 0};
+})
+
+BenchCase(recompiled_run, "Recompiled, run", {
+    _cpu->setRecompiling(true);
+    _cpu->run(CYCLES);
+    return (BenchResult){_cpu->getCycles(), 0};
+})
+
+BenchCase(cycle_accurate_run, "Cycle accurate, run", {
+    _cpu->setCycleAccurate(true);
+    _cpu->run(CYCLES);
+    return (BenchResult){_cpu->getCycles(), 0};
+})
+
+BenchCase(cycle_accurate_tick, "Cycle accurate, tick", {
+    _cpu->setCycleAccurate(true);
+    for (uint64_t i = 0; i < CYCLES; i++) {
+        _cpu->tick();
+    }
+    return (BenchResult){_cpu->getCycles(), 0};
+})
+
+
+// benchmark suite -----------------------------------------------------------------------------------------------------
+
+BenchSuite(BenchCores, {
+    bench_instruction_run();
+    bench_instruction_tick();
+    bench_predecoded_run();
+    bench_recompiled_run();
+    bench_cycle_accurate_run();
+    bench_cycle_accurate_tick();
+});
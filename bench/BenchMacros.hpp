@@ -0,0 +1,79 @@
+//
+//  BenchMacros.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __BENCH_MACROS_HPP__
+#define __BENCH_MACROS_HPP__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+/// The amount of emulated work a benchmark ran. Benchmarks that do not count instructions leave them as 0.
+typedef struct _BenchResult {
+    uint64_t cycles;                    // emulated clock cycles
+    uint64_t instructions;              // emulated instructions
+} BenchResult;
+
+/// Output format of the benchmark report.
+typedef enum _BENCH_FORMAT {
+    BENCH_FORMAT_TEXT,
+    BENCH_FORMAT_JSON,
+    BENCH_FORMAT_CSV,
+} BENCH_FORMAT;
+
+/// Benchmark options, set from the command line. See `bench.cpp`.
+extern BENCH_FORMAT _benchFormat;
+extern unsigned     _benchSamples;
+extern const char  *_benchSuite;
+
+/// Reports the samples of a benchmark in the selected format. See `bench.cpp`.
+void _benchReport(const char *name, const char *label, const std::vector<BenchResult> &results,
+                  const std::vector<double> &seconds);
+
+#define RunBenchSuite(name) \
+    extern void _bench_##name(); _bench_##name();
+
+#define BenchSuite(name, block) \
+    void _bench_##name() { \
+        _benchSuite = #name; \
+        if (_benchFormat == BENCH_FORMAT_TEXT) { \
+            printf("\n[SUITE] ------- %s -------\n", #name); \
+        } \
+        block \
+    }
+
+#define BenchSetUp(block) \
+    static void _setup_() block
+
+#define BenchTearDown(block) \
+    static void _teardown_() block \
+
+/// Defines a benchmark. The block runs the workload & returns a `BenchResult` with the amount of emulated work it
+/// ran. The benchmark is sampled `_benchSamples` times, each with a fresh set up, & reported in emulated MHz and
+/// millions of instructions per second. The block is variadic so that it can contain unparenthesized commas.
+#define BenchCase(name, label, ...) \
+    static BenchResult __block__bench__##name() { \
+        __VA_ARGS__ \
+    } \
+    static void bench_##name() { \
+        std::vector<BenchResult> results; \
+        std::vector<double>      seconds; \
+        for (unsigned sample = 0; sample < _benchSamples; sample++) { \
+            _setup_(); \
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); \
+            results.push_back(__block__bench__##name()); \
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start; \
+            seconds.push_back(elapsed.count()); \
+            _teardown_(); \
+        } \
+        _benchReport(#name, label, results, seconds); \
+    }
+
+
+#endif // __BENCH_MACROS_HPP__
@@ -0,0 +1,182 @@
+//
+//  BenchWorkloads.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <assert.h>
+#include <initializer_list>
+#include "BenchMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static const uint64_t INSTRUCTIONS = 10000000;
+static const uint64_t CYCLES       = 30000000;
+
+static CPU  *_cpu;
+static bool  _predecoded = false;
+
+BenchSetUp({
+    _cpu = new CPU();
+    _cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x04);
+})
+
+BenchTearDown({
+    delete _cpu;
+})
+
+static void _load(word address, std::initializer_list<byte> program) {
+    for (byte data : program) {
+        _cpu->write(address++, data);
+    }
+}
+
+/// Completes the reset & runs the loaded program for `INSTRUCTIONS` instructions on the instruction level core, or
+/// for `CYCLES` clock cycles with the block cache in the predecoded suite.
+static BenchResult _run() {
+    _cpu->reset();
+    _cpu->step();
+
+    if (_predecoded) {
+        uint64_t start = _cpu->getCycles();
+        _cpu->setPredecoding(true);
+        _cpu->run(CYCLES);
+        return (BenchResult){_cpu->getCycles() - start, 0};
+    }
+
+    uint64_t start        = _cpu->getCycles();
+    uint64_t instructions = 0;
+    _cpu->runUntil([&instructions](CPU &cpu) {
+        return instructions++ == INSTRUCTIONS;
+    });
+    return (BenchResult){_cpu->getCycles() - start, INSTRUCTIONS};
+}
+
+
+// benchmarks ----------------------------------------------------------------------------------------------------------
+
+BenchCase(tight_loop, "Tight loop", {
+    _load(0x0400, {
+        0xCA,                           // DEX
+        0xD0, 0xFD,                     // BNE $0400
+        0x4C, 0x00, 0x04,               // JMP $0400
+    });
+    return _run();
+})
+
+BenchCase(memory_copy, "Memory copy", {
+
+    // copies the 8 pages at 0x1000 to 0x2000 a page at a time, over & over
+    _load(0x0400, {
+        0xA2, 0x00,                     // LDX #$00
+        0xBD, 0x00, 0x10,               // LDA $1000,X
+        0x9D, 0x00, 0x20,               // STA $2000,X
+        0xE8,                           // INX
+        0xD0, 0xF7,                     // BNE $0402
+        0xEE, 0x04, 0x04,               // INC $0404
+        0xEE, 0x07, 0x04,               // INC $0407
+        0xAD, 0x04, 0x04,               // LDA $0404
+        0xC9, 0x18,                     // CMP #$18
+        0xD0, 0xE8,                     // BNE $0400
+        0xA9, 0x10,                     // LDA #$10
+        0x8D, 0x04, 0x04,               // STA $0404
+        0xA9, 0x20,                     // LDA #$20
+        0x8D, 0x07, 0x04,               // STA $0407
+        0x4C, 0x00, 0x04,               // JMP $0400
+    });
+    for (word offset = 0; offset < 0x0800; offset++) {
+        _cpu->write(word(0x1000 + offset), byte(offset * 7 + 3));
+    }
+
+    BenchResult result = _run();
+    for (word offset = 0; offset < 0x0800; offset++) {
+        byte data = 0;
+        _cpu->read(word(0x2000 + offset), data);
+        assert(data == byte(offset * 7 + 3));
+    }
+    return result;
+})
+
+BenchCase(subroutines, "Subroutines & stack", {
+    _load(0x0400, {
+        0x20, 0x10, 0x04,               // JSR $0410
+        0x4C, 0x00, 0x04,               // JMP $0400
+    });
+    _load(0x0410, {
+        0x48,                           // PHA
+        0x20, 0x20, 0x04,               // JSR $0420
+        0x68,                           // PLA
+        0x60,                           // RTS
+    });
+    _load(0x0420, {
+        0x08,                           // PHP
+        0x28,                           // PLP
+        0x60,                           // RTS
+    });
+    return _run();
+})
+
+BenchCase(branches, "Branches", {
+    _load(0x0400, {
+        0xE8,                           // INX
+        0x8A,                           // TXA
+        0x29, 0x01,                     // AND #$01
+        0xF0, 0x01,                     // BEQ $0407
+        0xC8,                           // INY
+        0x30, 0x02,                     // BMI $040B
+        0x10, 0xF5,                     // BPL $0400
+        0x4C, 0x00, 0x04,               // JMP $0400
+    });
+    return _run();
+})
+
+BenchCase(indirect, "Indirect addressing", {
+    _load(0x0400, {
+        0xA0, 0x00,                     // LDY #$00
+        0xB1, 0x20,                     // LDA ($20),Y
+        0x91, 0x22,                     // STA ($22),Y
+        0xA1, 0x24,                     // LDA ($24,X)
+        0xC8,                           // INY
+        0xD0, 0xF7,                     // BNE $0402
+        0x6C, 0x30, 0x00,               // JMP ($0030)
+    });
+    _load(0x0020, {
+        0x00, 0x10,                     // ($20) -> 0x1000
+        0x00, 0x20,                     // ($22) -> 0x2000
+        0x00, 0x30,                     // ($24) -> 0x3000
+    });
+    _load(0x0030, {
+        0x00, 0x04,                     // ($30) -> 0x0400
+    });
+    return _run();
+})
+
+
+// benchmark suite -----------------------------------------------------------------------------------------------------
+
+BenchSuite(BenchWorkloads, {
+    bench_tight_loop();
+    bench_memory_copy();
+    bench_subroutines();
+    bench_branches();
+    bench_indirect();
+});
+
+BenchSuite(BenchWorkloadsPredecoded, {
+    _predecoded = true;
+    bench_tight_loop();
+    bench_memory_copy();
+    bench_subroutines();
+    bench_branches();
+    bench_indirect();
+    _predecoded = false;
+});
@@ -0,0 +1,127 @@
+//
+//  bench.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "BenchMacros.hpp"
+
+
+// options -------------------------------------------------------------------------------------------------------------
+
+BENCH_FORMAT _benchFormat  = BENCH_FORMAT_TEXT;
+unsigned     _benchSamples = 5;
+const char  *_benchSuite   = "";
+
+static bool  _benchFirst   = true;
+
+
+// statistics ----------------------------------------------------------------------------------------------------------
+
+static double _median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    std::size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+static double _stddev(const std::vector<double> &values) {
+    double mean = 0;
+    for (double value : values) {
+        mean += value;
+    }
+    mean /= values.size();
+
+    double variance = 0;
+    for (double value : values) {
+        variance += (value - mean) * (value - mean);
+    }
+    return values.size() > 1 ? sqrt(variance / (values.size() - 1)) : 0;
+}
+
+
+// report --------------------------------------------------------------------------------------------------------------
+
+void _benchReport(const char *name, const char *label, const std::vector<BenchResult> &results,
+                  const std::vector<double> &seconds) {
+
+    // throughput of each sample
+    std::vector<double> mhz, mips;
+    for (std::size_t i = 0; i < results.size(); i++) {
+        mhz.push_back(double(results[i].cycles) / seconds[i] / 1e6);
+        mips.push_back(double(results[i].instructions) / seconds[i] / 1e6);
+    }
+
+    double mhzMedian  = _median(mhz),  mhzStddev  = _stddev(mhz);
+    double mipsMedian = _median(mips), mipsStddev = _stddev(mips);
+
+    switch (_benchFormat) {
+    case BENCH_FORMAT_TEXT:
+        printf("[BENCH] %-40s %9.2f MHz ±%6.2f", label, mhzMedian, mhzStddev);
+        if (mipsMedian > 0) {
+            printf(" %9.2f MIPS ±%6.2f", mipsMedian, mipsStddev);
+        }
+        printf("\n");
+        break;
+
+    case BENCH_FORMAT_JSON:
+        printf("%s\n  {\"suite\": \"%s\", \"name\": \"%s\", \"samples\": %zu, "
+               "\"mhz_median\": %.3f, \"mhz_stddev\": %.3f, \"mips_median\": %.3f, \"mips_stddev\": %.3f}",
+               _benchFirst ? "" : ",", _benchSuite, name, results.size(),
+               mhzMedian, mhzStddev, mipsMedian, mipsStddev);
+        break;
+
+    case BENCH_FORMAT_CSV:
+        printf("%s,%s,%zu,%.3f,%.3f,%.3f,%.3f\n", _benchSuite, name, results.size(),
+               mhzMedian, mhzStddev, mipsMedian, mipsStddev);
+        break;
+    }
+    _benchFirst = false;
+}
+
+
+// main ----------------------------------------------------------------------------------------------------------------
+
+static int _usage(const char *program) {
+    fprintf(stderr, "usage: %s [--json | --csv] [--samples N]\n", program);
+    return 1;
+}
+
+int main(int argc, const char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            _benchFormat = BENCH_FORMAT_JSON;
+        }
+        else if (strcmp(argv[i], "--csv") == 0) {
+            _benchFormat = BENCH_FORMAT_CSV;
+        }
+        else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            _benchSamples = atoi(argv[++i]);
+        }
+        else {
+            return _usage(argv[0]);
+        }
+    }
+
+    if (_benchFormat == BENCH_FORMAT_JSON) {
+        printf("[");
+    }
+    else if (_benchFormat == BENCH_FORMAT_CSV) {
+        printf("suite,name,samples,mhz_median,mhz_stddev,mips_median,mips_stddev\n");
+    }
+
+    RunBenchSuite(BenchCores);
+    RunBenchSuite(BenchWorkloads);
+    RunBenchSuite(BenchWorkloadsPredecoded);
+    RunBenchSuite(BenchBus);
+
+    if (_benchFormat == BENCH_FORMAT_JSON) {
+        printf("\n]\n");
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+//
+//  Addressable.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+#include "Addressable.hpp"
+#include "Bus.hpp"
+
+namespace rt_6502_emulator {
+
+    // buses -----------------------------------------------------------------------------------------------------------
+
+    void Addressable::addBus(Bus *bus) {
+        _buses.push_back(bus);
+    }
+
+    void Addressable::removeBus(Bus *bus) {
+        std::vector<Bus *>::iterator it = std::find(_buses.begin(), _buses.end(), bus);
+        if (it != _buses.end()) {
+            _buses.erase(it);
+        }
+    }
+
+    void Addressable::_pageChanged(byte page) {
+        for (Bus *bus : _buses) {
+            bus->refreshPage(page);
+        }
+    }
+
+    void Addressable::_contentsChanged(byte page) {
+        for (Bus *bus : _buses) {
+            bus->contentsChanged(page);
+        }
+    }
+
+
+    // block access ----------------------------------------------------------------------------------------------------
+
+    bool Addressable::readBlock(word address, byte *buffer, size_t length) {
+        assert(size_t(address) + length <= 0x10000);
+
+        // copy page by page, falling back to `read` for pages that cannot be read directly
+        bool   success = true;
+        size_t end     = size_t(address) + length;
+        for (size_t current = address; current < end; ) {
+            size_t size = std::min<size_t>(end - current, 0x0100 - (current & 0x00FF));
+            byte  *page = readPage(byte(current >> 8));
+            if (page) {
+                memcpy(buffer, page + (current & 0x00FF), size);
+            } else {
+                for (size_t i = 0; i < size; i++) {
+                    buffer[i] = 0x00;
+                    success  &= read(word(current + i), buffer[i]);
+                }
+            }
+            buffer  += size;
+            current += size;
+        }
+        return success;
+    }
+
+    bool Addressable::writeBlock(word address, const byte *buffer, size_t length) {
+        assert(size_t(address) + length <= 0x10000);
+
+        // copy page by page, falling back to `write` for pages that cannot be written directly
+        bool   success = true;
+        size_t end     = size_t(address) + length;
+        for (size_t current = address; current < end; ) {
+            size_t size = std::min<size_t>(end - current, 0x0100 - (current & 0x00FF));
+            byte  *page = writePage(byte(current >> 8));
+            if (page) {
+                memcpy(page + (current & 0x00FF), buffer, size);
+            } else {
+                for (size_t i = 0; i < size; i++) {
+                    success &= write(word(current + i), buffer[i]);
+                }
+            }
+            buffer  += size;
+            current += size;
+        }
+        return success;
+    }
+
+    const byte *Addressable::span(word address, size_t length) {
+        assert(size_t(address) + length <= 0x10000);
+        if (length == 0) {
+            return nullptr;
+        }
+
+        // every page of the block must be readable directly & follow on from the previous one
+        byte *start = readPage(byte(address >> 8));
+        if (start == nullptr) {
+            return nullptr;
+        }
+        size_t last = (size_t(address) + length - 1) >> 8;
+        for (size_t page = (address >> 8) + 1; page <= last; page++) {
+            if (readPage(byte(page)) != start + ((page - (address >> 8)) << 8)) {
+                return nullptr;
+            }
+        }
+        return start + (address & 0x00FF);
+    }
+}
@@ -9,14 +9,29 @@
 #ifndef __RT_6502_EMULATOR_ADDRESSABLE_HPP__
 #define __RT_6502_EMULATOR_ADDRESSABLE_HPP__
 
+#include <stddef.h>
+#include <vector>
 #include "types.hpp"
 
 namespace rt_6502_emulator {
 
+    class Bus;
+    class Snapshot;
+
     /// Abstract class to be implemented by peripherals attached to the bus.
     class Addressable {
     public:
 
+        /// Constructor
+        Addressable() {}
+
+        /// Copy constructor. The copy is not attached to the buses the original is attached to.
+        Addressable(const Addressable &orig) {}
+
+        /// Assignment operator. Keeps the buses this peripheral is attached to.
+        Addressable &operator=(const Addressable &orig) { return *this; }
+
+
         /// Returns `true` if this peripheral can be read from.
         virtual bool isReadable()    = 0;
 
@@ -44,6 +59,98 @@ namespace rt_6502_emulator {
         ///
         /// @returns `true` if address was written to
         virtual bool write(word address, byte data) = 0;
+
+
+        /// Returns a pointer to the backing store of the given page (a 256 byte block of the address space) if it
+        /// can be read directly without going through `read`. The bus uses this to serve reads from pages entirely
+        /// covered by this peripheral with a single load.
+        ///
+        /// Peripherals with side effects on read (I/O registers etc.) must not implement this.
+        ///
+        /// @param page the page to look up (MSB of the address)
+        ///
+        /// @returns pointer to the byte at address `page << 8` or `nullptr` if the page cannot be read directly
+        virtual byte *readPage(byte page)  { return nullptr; }
+
+        /// Returns a pointer to the backing store of the given page if it can be written directly without going
+        /// through `write`. See `readPage`.
+        ///
+        /// @param page the page to look up (MSB of the address)
+        ///
+        /// @returns pointer to the byte at address `page << 8` or `nullptr` if the page cannot be written directly
+        virtual byte *writePage(byte page) { return nullptr; }
+
+
+        /// Reads a block of bytes from the peripherals address space, for host side access. Pages that can be read
+        /// directly are copied with `memcpy`, the others are read a byte at a time through `read`.
+        ///
+        /// @param address the address from which to read
+        /// @param buffer  the buffer to read into. bytes that cannot be read are set to 0x00
+        /// @param length  number of bytes to read. the block must not extend past 0xFFFF
+        ///
+        /// @returns `true` if every byte of the block was read
+        virtual bool readBlock(word address, byte *buffer, size_t length);
+
+        /// Writes a block of bytes to the peripherals address space, for host side access. Pages that can be written
+        /// directly are copied with `memcpy`, the others are written a byte at a time through `write`.
+        ///
+        /// @param address the address to which to write
+        /// @param buffer  the bytes to write
+        /// @param length  number of bytes to write. the block must not extend past 0xFFFF
+        ///
+        /// @returns `true` if every byte of the block was written
+        virtual bool writeBlock(word address, const byte *buffer, size_t length);
+
+        /// Returns a read only view of a block of the address space, if the block is backed by contiguous storage
+        /// that can be read directly. See `readPage`. The view is valid until the peripheral is next written to or
+        /// remaps its pages.
+        ///
+        /// @param address start of the block
+        /// @param length  length of the block. the block must not extend past 0xFFFF
+        ///
+        /// @returns pointer to the byte at `address` or `nullptr` if the block cannot be viewed directly
+        virtual const byte *span(word address, size_t length);
+
+        /// Registers a bus this peripheral is attached to, to be notified when the pointers returned by `readPage`
+        /// or `writePage` change. Called by `Bus::attach`.
+        void addBus(Bus *bus);
+
+        /// Unregisters a bus added with `addBus`.
+        void removeBus(Bus *bus);
+
+
+        /// Appends the state of this peripheral to the given snapshot. Peripherals without state need not implement
+        /// this.
+        ///
+        /// @param snapshot the snapshot to append to
+        virtual void save(Snapshot &snapshot) {}
+
+        /// Restores the state of this peripheral from the given snapshot, as appended by `save`.
+        ///
+        /// @param snapshot the snapshot to restore from
+        /// @param offset   read position in the snapshot. advanced past the state of this peripheral
+        ///
+        /// @returns `false` if the snapshot does not hold a valid state for this peripheral
+        virtual bool restore(const Snapshot &snapshot, size_t &offset) { return true; }
+
+    protected:
+
+        /// Notifies the buses this peripheral is attached to that the pointers returned by `readPage` or `writePage`
+        /// for the given page changed. Peripherals implementing direct page access must call this whenever they do.
+        ///
+        /// @param page the page that changed (MSB of the address)
+        void _pageChanged(byte page);
+
+        /// Notifies the buses this peripheral is attached to that the contents shown in the given page changed other
+        /// than by a write to the page, eg. by a write to another page showing the same storage.
+        ///
+        /// @param page the page that changed (MSB of the address)
+        void _contentsChanged(byte page);
+
+    private:
+
+        /// Buses this peripheral is attached to
+        std::vector<Bus *> _buses;
     };
 }
 
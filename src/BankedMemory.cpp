@@ -0,0 +1,237 @@
+//
+//  BankedMemory.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <assert.h>
+#include "BankedMemory.hpp"
+#include "ROM.hpp"
+#include "Snapshot.hpp"
+
+namespace rt_6502_emulator {
+
+    // constructors & destructor ---------------------------------------------------------------------------------------
+
+    BankedMemory::BankedMemory(size_t size, word addressStart, word addressEnd, uint32_t bankSize) {
+        assert(bankSize > 0 && size >= bankSize && size % bankSize == 0);
+
+        _contents.assign(size, 0x00);
+        _data = _contents.data();
+        _size = size;
+        _init(addressStart, addressEnd, bankSize);
+    }
+
+    BankedMemory::BankedMemory(std::shared_ptr<MappedImage> image, word addressStart, word addressEnd,
+                               uint32_t bankSize) {
+        assert(image && bankSize > 0 && image->size() >= bankSize);
+
+        // the mapping is read only. see `writePage`
+        _image = image;
+        _data  = const_cast<byte *>(image->data());
+        _size  = image->size();
+        _init(addressStart, addressEnd, bankSize);
+    }
+
+    BankedMemory::BankedMemory(const BankedMemory &orig): Addressable() {
+        _contents     = orig._contents;
+        _image        = orig._image;
+        _data         = _image ? orig._data : _contents.data();
+        _size         = orig._size;
+        _bankSize     = orig._bankSize;
+        _banks        = orig._banks;
+        _addressStart = orig._addressStart;
+        _addressEnd   = orig._addressEnd;
+        _slots        = orig._slots;
+        _registers    = orig._registers;
+    }
+
+    BankedMemory::~BankedMemory() {}
+
+    void BankedMemory::_init(word addressStart, word addressEnd, uint32_t bankSize) {
+        uint32_t window = uint32_t(addressEnd) - addressStart + 1;
+        assert((addressStart & 0x00FF) == 0 && bankSize % 0x0100 == 0 && window % bankSize == 0);
+
+        _bankSize     = bankSize;
+        _banks        = uint32_t(_size / bankSize);
+        _addressStart = addressStart;
+        _addressEnd   = addressEnd;
+
+        // show the first banks in order
+        for (uint32_t slot = 0; slot < window / bankSize; slot++) {
+            _slots.push_back(slot % _banks);
+        }
+    }
+
+
+    // accessors -------------------------------------------------------------------------------------------------------
+
+    bool BankedMemory::isReadable()   { return true; }
+    bool BankedMemory::isWritable()   { return _image == nullptr; }
+    word BankedMemory::addressStart() { return _addressStart; }
+    word BankedMemory::addressEnd()   { return _addressEnd; }
+
+    uint32_t BankedMemory::getBanks()         { return _banks; }
+    uint32_t BankedMemory::getSlots()         { return uint32_t(_slots.size()); }
+    uint32_t BankedMemory::getBank(byte slot) { return _slots[slot]; }
+
+    byte  *BankedMemory::data() { return _data; }
+    size_t BankedMemory::size() { return _size; }
+
+
+    // bank switching --------------------------------------------------------------------------------------------------
+
+    void BankedMemory::select(byte slot, uint32_t bank) {
+        assert(slot < _slots.size());
+
+        bank %= _banks;
+        uint32_t previous = _slots[slot];
+        if (previous == bank) {
+            return;
+        }
+
+        // the slots showing either bank may have become aliased or stopped being so, which changes their write
+        // pointers
+        _slots[slot] = bank;
+        for (uint32_t other = 0; other < _slots.size(); other++) {
+            if (other == slot || _slots[other] == previous || _slots[other] == bank) {
+                _slotChanged(byte(other));
+            }
+        }
+    }
+
+    void BankedMemory::addRegister(word address, byte slot) {
+        assert(address >= _addressStart && address <= _addressEnd && slot < _slots.size());
+
+        // writes to the page of the register now have to go through `write`
+        _registers.push_back((Register){address, slot});
+        _pageChanged(byte(address >> 8));
+    }
+
+    void BankedMemory::_slotChanged(byte slot) {
+        uint32_t start = _addressStart + slot * _bankSize;
+        for (uint32_t page = start >> 8; page < (start + _bankSize) >> 8; page++) {
+            _pageChanged(byte(page));
+        }
+    }
+
+    bool BankedMemory::_isAliased(uint32_t slot) {
+        for (uint32_t other = 0; other < _slots.size(); other++) {
+            if (other != slot && _slots[other] == _slots[slot]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    // read / write ----------------------------------------------------------------------------------------------------
+
+    bool BankedMemory::read(word address, byte &data) {
+        if (address >= _addressStart && address <= _addressEnd) {
+            data = *_byte(address);
+            return true;
+        }
+        return false;
+    }
+
+    bool BankedMemory::write(word address, byte data) {
+        if (address < _addressStart || address > _addressEnd) {
+            return false;
+        }
+
+        for (const Register &reg : _registers) {
+            if (reg.address == address) {
+                select(reg.slot, data);
+                return true;
+            }
+        }
+
+        if (_image) {
+            return false;
+        }
+        *_byte(address) = data;
+
+        // the same byte is shown at the same offset of every other slot showing the bank
+        uint32_t offset = address - _addressStart;
+        uint32_t slot   = offset / _bankSize;
+        for (uint32_t other = 0; other < _slots.size(); other++) {
+            if (other != slot && _slots[other] == _slots[slot]) {
+                _contentsChanged(byte((_addressStart + other * _bankSize + offset % _bankSize) >> 8));
+            }
+        }
+        return true;
+    }
+
+    byte *BankedMemory::_byte(word address) {
+        uint32_t offset = address - _addressStart;
+        return _data + size_t(_slots[offset / _bankSize]) * _bankSize + offset % _bankSize;
+    }
+
+
+    // direct page access ----------------------------------------------------------------------------------------------
+
+    byte *BankedMemory::readPage(byte page) {
+        word start = word(page) << 8;
+        if (start >= _addressStart && (start | 0x00FF) <= _addressEnd) {
+            return _byte(start);
+        }
+        return nullptr;
+    }
+
+    byte *BankedMemory::writePage(byte page) {
+        if (_image) {
+            return nullptr;
+        }
+        for (const Register &reg : _registers) {
+            if (reg.address >> 8 == page) {
+                return nullptr;
+            }
+        }
+
+        // writes to a bank shown in more than one slot have to be seen at each address showing it
+        word start = word(page) << 8;
+        if (start >= _addressStart && (start | 0x00FF) <= _addressEnd &&
+            _isAliased((start - _addressStart) / _bankSize)) {
+            return nullptr;
+        }
+        return readPage(page);
+    }
+
+
+    // snapshot --------------------------------------------------------------------------------------------------------
+
+    void BankedMemory::save(Snapshot &snapshot) {
+        snapshot.appendUInt64(_size);
+        snapshot.appendUInt32(_bankSize);
+        snapshot.appendWord(word(_slots.size()));
+        for (uint32_t bank : _slots) {
+            snapshot.appendUInt32(bank);
+        }
+        if (_image == nullptr) {
+            snapshot.appendBytes(_data, _size);
+        }
+    }
+
+    bool BankedMemory::restore(const Snapshot &snapshot, size_t &offset) {
+        uint64_t size;
+        uint32_t bankSize;
+        word     slots;
+        if (snapshot.readUInt64(offset, size)     == false || size     != _size     ||
+            snapshot.readUInt32(offset, bankSize) == false || bankSize != _bankSize ||
+            snapshot.readWord(offset, slots)      == false || slots    != _slots.size()) {
+            return false;
+        }
+
+        for (uint32_t slot = 0; slot < slots; slot++) {
+            uint32_t bank;
+            if (snapshot.readUInt32(offset, bank) == false || bank >= _banks) {
+                return false;
+            }
+            select(byte(slot), bank);
+        }
+        return _image != nullptr || snapshot.readBytes(offset, _data, _size);
+    }
+}
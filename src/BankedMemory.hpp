@@ -0,0 +1,158 @@
+//
+//  BankedMemory.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_BANKED_MEMORY_HPP__
+#define __RT_6502_EMULATOR_BANKED_MEMORY_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "types.hpp"
+#include "Addressable.hpp"
+
+namespace rt_6502_emulator {
+
+    class MappedImage;
+
+    /// Bank switched RAM or ROM, for systems with more memory than the 6502 can address (cartridge mappers, paged
+    /// RAM etc).
+    ///
+    /// The contents are a single contiguous buffer, owned for RAM or a mapped image file for ROM, divided into banks.
+    /// The address window of the memory is divided into slots of the same size, each of which shows one bank. Banks
+    /// are selected with `select` or by writing to a bank register in the window. Selecting a bank only updates the
+    /// page map of the buses the memory is attached to, which is linear in the number of pages of a bank. Accesses
+    /// through the bus are served from the direct page pointers & cost no more than for plain memory.
+    class BankedMemory: public Addressable {
+    public:
+
+        /// Constructs bank switched RAM. The contents are zeroed.
+        ///
+        /// @param size         size of the contents in bytes. a multiple of `bankSize`
+        /// @param addressStart start of the window. must be at the start of a page
+        /// @param addressEnd   end of the window. the window must be a multiple of `bankSize`
+        /// @param bankSize     size of a bank in bytes. a multiple of 256
+        BankedMemory(size_t size, word addressStart, word addressEnd, uint32_t bankSize);
+
+        /// Constructs bank switched ROM backed by the given image. A partial bank at the end of the image is not
+        /// mapped.
+        ///
+        /// @param image        the image to map, at least one bank in size
+        /// @param addressStart start of the window. must be at the start of a page
+        /// @param addressEnd   end of the window. the window must be a multiple of `bankSize`
+        /// @param bankSize     size of a bank in bytes. a multiple of 256
+        BankedMemory(std::shared_ptr<MappedImage> image, word addressStart, word addressEnd, uint32_t bankSize);
+
+        /// Copy constructor. The copy has its own copy of RAM contents & shares ROM contents. It is not attached to
+        /// the buses the original is attached to.
+        BankedMemory(const BankedMemory &orig);
+
+        /// Destructor
+        ~BankedMemory();
+
+
+        /// Returns `true` always.
+        virtual bool isReadable();
+
+        /// Returns `true` if configured as RAM.
+        virtual bool isWritable();
+
+        /// Start of the window.
+        virtual word addressStart();
+
+        /// End of the window.
+        virtual word addressEnd();
+
+
+        /// Gets the number of banks.
+        uint32_t getBanks();
+
+        /// Gets the number of slots in the window.
+        uint32_t getSlots();
+
+        /// Gets the bank shown in the given slot.
+        uint32_t getBank(byte slot);
+
+        /// Shows the given bank in the given slot. The same bank can be shown in more than one slot. Its pages are
+        /// then written through `write`, so that the buses see the change at every address showing it.
+        ///
+        /// @param slot the slot, counted from the start of the window
+        /// @param bank the bank to show, modulo the number of banks
+        void select(byte slot, uint32_t bank);
+
+        /// Adds a bank register. Writing `n` to the register shows bank `n` in the given slot, in place of writing to
+        /// the memory. The page holding the register is written through `write`, the other pages are unaffected.
+        ///
+        /// @param address address of the register, within the window
+        /// @param slot    the slot the register selects the bank of
+        void addRegister(word address, byte slot);
+
+        /// Gets the contents, for host side access.
+        byte *data();
+
+        /// Gets the size of the contents in bytes.
+        size_t size();
+
+
+        /// Read a byte from the bank shown at the given address.
+        virtual bool read(word address, byte &data);
+
+        /// Write a byte to the bank shown at the given address, or to a bank register.
+        ///
+        /// If configured as a ROM, only bank registers are written to.
+        virtual bool write(word address, byte data);
+
+        /// Returns a pointer to the given page of the bank it shows.
+        virtual byte *readPage(byte page);
+
+        /// Returns a pointer to the given page of the bank it shows if configured as RAM, the page does not hold a
+        /// bank register & the bank is not shown in another slot.
+        virtual byte *writePage(byte page);
+
+
+        /// Appends the selected banks & the RAM contents to the given snapshot. ROM contents are not saved.
+        virtual void save(Snapshot &snapshot);
+
+        /// Restores the selected banks & the RAM contents from the given snapshot. Fails if the snapshot was saved
+        /// from a memory of a different configuration.
+        virtual bool restore(const Snapshot &snapshot, size_t &offset);
+
+    private:
+
+        /// A bank register.
+        typedef struct _Register {
+            word address;
+            byte slot;
+        } Register;
+
+        std::vector<byte>            _contents;     // RAM contents
+        std::shared_ptr<MappedImage> _image;        // ROM contents
+        byte                        *_data;         // start of the contents
+        size_t                       _size;
+        uint32_t                     _bankSize;
+        uint32_t                     _banks;
+        word                         _addressStart;
+        word                         _addressEnd;
+        std::vector<uint32_t>        _slots;        // bank shown in each slot
+        std::vector<Register>        _registers;
+
+        /// Sets up the window & shows the banks in order.
+        void _init(word addressStart, word addressEnd, uint32_t bankSize);
+
+        /// Gets the byte shown at the given address in the window.
+        byte *_byte(word address);
+
+        /// Notifies the buses of the pages of the given slot.
+        void _slotChanged(byte slot);
+
+        /// Gets whether the bank shown in the given slot is shown in another slot too.
+        bool _isAliased(uint32_t slot);
+    };
+}
+
+#endif // __RT_6502_EMULATOR_BANKED_MEMORY_HPP__
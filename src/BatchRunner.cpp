@@ -0,0 +1,202 @@
+//
+//  BatchRunner.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "BatchRunner.hpp"
+#include "CPU.hpp"
+#include "Memory.hpp"
+#include "ROM.hpp"
+
+namespace rt_6502_emulator {
+
+    /* Each worker owns a contiguous share of the jobs, stored as a [next, end) range packed into a single atomic
+     * word. The owner takes jobs from the front of its share & thieves take jobs from the back, each with a single
+     * compare & swap. Since shares only ever shrink, no locks are needed.
+     */
+
+    // job shares ------------------------------------------------------------------------------------------------------
+
+    /// Takes a job from the front or the back of a share.
+    ///
+    /// @param share the share packed as `end << 32 | next`
+    /// @param front `true` to take from the front (owner) or `false` to take from the back (thief)
+    /// @param index set to the index of the job taken
+    ///
+    /// @returns `false` if the share is empty
+    static bool _take(std::atomic<uint64_t> &share, bool front, std::size_t &index) {
+        uint64_t current = share.load(std::memory_order_relaxed);
+        for (;;) {
+            uint32_t next = uint32_t(current);
+            uint32_t end  = uint32_t(current >> 32);
+            if (next >= end) {
+                return false;
+            }
+
+            uint64_t updated = front ? current + 1 : current - (uint64_t(1) << 32);
+            if (share.compare_exchange_weak(current, updated, std::memory_order_relaxed)) {
+                index = front ? next : end - 1;
+                return true;
+            }
+        }
+    }
+
+
+    // constructors & destructor ---------------------------------------------------------------------------------------
+
+    BatchRunner::BatchRunner(unsigned threads) {
+        _threads = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    BatchRunner::~BatchRunner() {}
+
+
+    // run -------------------------------------------------------------------------------------------------------------
+
+    std::vector<BatchRunner::Result> BatchRunner::run(const std::vector<Job> &jobs) {
+        std::vector<Result> results(jobs.size());
+        if (jobs.empty()) {
+            return results;
+        }
+
+        // split the jobs into a contiguous share per worker. shares are padded to separate cache lines.
+        std::size_t threads = std::min<std::size_t>(_threads, jobs.size());
+        struct alignas(64) Share {
+            std::atomic<uint64_t> range;
+        };
+        std::unique_ptr<Share[]> shares(new Share[threads]);
+        for (std::size_t i = 0; i < threads; i++) {
+            uint64_t next = jobs.size() *  i      / threads;
+            uint64_t end  = jobs.size() * (i + 1) / threads;
+            shares[i].range.store((end << 32) | next, std::memory_order_relaxed);
+        }
+
+        // each result is written by exactly one worker. joining the workers publishes them to this thread.
+        auto worker = [&](std::size_t self) {
+            std::size_t index;
+            while (_take(shares[self].range, true, index)) {
+                results[index] = runJob(jobs[index]);
+            }
+
+            // steal from the other workers until all shares are empty
+            for (std::size_t i = 1; i < threads; i++) {
+                std::atomic<uint64_t> &victim = shares[(self + i) % threads].range;
+                while (_take(victim, false, index)) {
+                    results[index] = runJob(jobs[index]);
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < threads; i++) {
+            workers.emplace_back(worker, i);
+        }
+        worker(0);
+        for (std::thread &thread : workers) {
+            thread.join();
+        }
+
+        return results;
+    }
+
+    BatchRunner::Result BatchRunner::runJob(const Job &job) {
+
+        // build the system
+        CPU cpu;
+        for (const Region &region : job.memoryMap) {
+
+            // mapped images are shared by all jobs, so nothing is loaded
+            if (region.path.empty() == false) {
+                std::shared_ptr<ROM> rom = ROM::map(region.path, region.addressStart, region.addressEnd);
+                if (rom) {
+                    cpu.attach(rom);
+                    continue;
+                }
+            }
+
+            std::shared_ptr<Memory> memory = std::make_shared<Memory>(region.isWritable, region.addressStart,
+                                                                      region.addressEnd);
+            if (region.image) {
+
+                // load in chunks since a region can be larger than a load can address
+                std::size_t size   = std::min<std::size_t>(region.image->size(),
+                                                           std::size_t(region.addressEnd) - region.addressStart + 1);
+                std::size_t offset = 0;
+                while (offset < size) {
+                    std::size_t length = std::min<std::size_t>(size - offset, 0x8000);
+                    memory->load(region.image->data() + offset, word(region.addressStart + offset), word(length));
+                    offset += length;
+                }
+            }
+            cpu.attach(memory);
+        }
+
+        // complete the reset
+        cpu.reset();
+        cpu.step();
+
+        // stop on the first watched access by the program
+        bool watched      = false;
+        word watchAddress = 0x0000;
+        for (const Watch &watch : job.watches) {
+            cpu.getWatchpoints().add(watch.addressStart, watch.addressEnd, watch.types,
+                                     [&cpu, &watched, &watchAddress](word address, byte type) {
+                if (watched == false) {
+                    watched      = true;
+                    watchAddress = address;
+                }
+                cpu.stop();
+            });
+        }
+
+        // run until the program traps or the budget is spent
+        bool     trapped  = false;
+        uint32_t previous = 0x10000;
+        cpu.runUntil([&trapped, &previous](CPU &cpu) {
+            word pc  = cpu.getProgramCounter();
+            trapped  = pc == previous;
+            previous = pc;
+            return trapped;
+        }, job.cycleBudget);
+
+        Result result;
+        result.acc          = cpu.getAccumulator();
+        result.idx          = cpu.getIndexX();
+        result.idy          = cpu.getIndexY();
+        result.stackP       = cpu.getStackPointer();
+        result.status       = cpu.getStatus();
+        result.pc           = cpu.getProgramCounter();
+        result.cycles       = cpu.getCycles();
+        result.completed    = trapped;
+        result.halted       = cpu.isHalted();
+        result.watched      = watched;
+        result.watchAddress = watchAddress;
+        result.memoryDigest = _digest(cpu, job.memoryMap);
+        return result;
+    }
+
+
+    // digest ----------------------------------------------------------------------------------------------------------
+
+    uint64_t BatchRunner::_digest(CPU &cpu, const std::vector<Region> &memoryMap) {
+        uint64_t hash = 0xCBF29CE484222325;
+        for (const Region &region : memoryMap) {
+            for (uint32_t address = region.addressStart; address <= region.addressEnd; ) {
+                byte     block[0x0100];
+                uint32_t length = std::min<uint32_t>(region.addressEnd - address + 1, sizeof(block));
+                cpu.readBlock(word(address), block, length);
+                for (uint32_t i = 0; i < length; i++) {
+                    hash = (hash ^ block[i]) * 0x100000001B3;
+                }
+                address += length;
+            }
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,107 @@
+//
+//  BatchRunner.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_BATCH_RUNNER_HPP__
+#define __RT_6502_EMULATOR_BATCH_RUNNER_HPP__
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "types.hpp"
+
+namespace rt_6502_emulator {
+
+    class CPU;
+
+    /// Runs batches of independent 6502 programs in parallel.
+    ///
+    /// Each job gets its own CPU & memory, so jobs share nothing but their (read only) images. Jobs are spread over
+    /// a pool of worker threads. A worker that runs out of jobs steals from the workers that still have some left,
+    /// which keeps all cores busy when run times vary. Job distribution is lock free.
+    class BatchRunner {
+    public:
+
+        /// A memory module mapped into a job's address space.
+        typedef struct _Region {
+            word                                     addressStart;  // start range of the memory address space
+            word                                     addressEnd;    // end range of the memory address space
+            bool                                     isWritable;    // `true` for RAM, `false` for ROM
+            std::shared_ptr<const std::vector<byte> > image;        // loaded at `addressStart` if not `nullptr`
+            std::string                              path;          // image file mapped read only in place of
+                                                                    // `image` if not empty. see `ROM`. left
+                                                                    // zeroed if the file cannot be mapped
+        } Region;
+
+        /// An address range watched for accesses by a job's program. See `Watchpoints`.
+        typedef struct _Watch {
+            word addressStart;                  // start of the address range to watch
+            word addressEnd;                    // end of the address range to watch
+            byte types;                         // access types to watch for. see `Watchpoints::WATCH_TYPE`
+        } Watch;
+
+        /// A program to run.
+        typedef struct _Job {
+            std::vector<Region> memoryMap;      // memory modules, in order of priority. includes the reset vector
+            uint64_t            cycleBudget;    // maximum number of clock cycles to run the program for
+            std::vector<Watch>  watches;        // the program stops after the instruction that first accesses one
+        } Job;
+
+        /// The state of a program after it was run.
+        typedef struct _Result {
+            byte     acc;                       // accumulator
+            byte     idx;                       // x index register
+            byte     idy;                       // y index register
+            byte     stackP;                    // stack pointer
+            byte     status;                    // status register
+            word     pc;                        // program counter
+            uint64_t cycles;                    // clock cycles elapsed, including the reset
+            bool     completed;                 // `true` if the program completed within its cycle budget
+            bool     halted;                    // `true` if the program halted on a KIL op code
+            bool     watched;                   // `true` if the program stopped on a watched access
+            word     watchAddress;              // address of the watched access if `watched`
+            uint64_t memoryDigest;              // FNV-1a hash of the memory map contents, in order of the map
+        } Result;
+
+
+        /// Constructs a batch runner.
+        ///
+        /// @param threads number of worker threads. 0 uses one thread per hardware thread.
+        BatchRunner(unsigned threads = 0);
+
+        /// Destructor
+        ~BatchRunner();
+
+        /// Runs the given jobs & waits for all of them to finish.
+        ///
+        /// A program is considered complete when it traps, i.e. an instruction jumps or branches to itself, which is
+        /// how test ROMs conventionally signal success or failure. A program that halts or accesses a watched address
+        /// stops at once. Otherwise it runs until its cycle budget is spent.
+        ///
+        /// @param jobs the jobs to run
+        ///
+        /// @returns the results, in the same order as the jobs
+        std::vector<Result> run(const std::vector<Job> &jobs);
+
+        /// Runs a single job on the calling thread.
+        ///
+        /// @param job the job to run
+        ///
+        /// @returns the result
+        static Result runJob(const Job &job);
+
+    private:
+
+        unsigned _threads;
+
+        /// Computes the digest of the contents of the given memory map.
+        static uint64_t _digest(CPU &cpu, const std::vector<Region> &memoryMap);
+    };
+}
+
+#endif // __RT_6502_EMULATOR_BATCH_RUNNER_HPP__
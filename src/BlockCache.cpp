@@ -0,0 +1,241 @@
+//
+//  BlockCache.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <string.h>
+#include <algorithm>
+#include "BlockCache.hpp"
+
+namespace rt_6502_emulator {
+
+    /// Most instructions in a block.
+    static const size_t MAX_OPERATIONS = 32;
+
+
+    // constructor & destructor ----------------------------------------------------------------------------------------
+
+    BlockCache::BlockCache(CPU *cpu) {
+        _cpu  = cpu;
+        _size = 0;
+        for (Page &page : _pages) {
+            page.generation = 0;
+            page.hooked     = false;
+            memset(page.codeBytes, 0, sizeof(page.codeBytes));
+        }
+    }
+
+    BlockCache::~BlockCache() {
+        flush();
+    }
+
+
+    // blocks ----------------------------------------------------------------------------------------------------------
+
+    uint64_t BlockCache::run(uint64_t cycles) {
+        CPU      *cpu      = _cpu;
+        uint64_t  start    = cpu->_cycles;
+        uint64_t  end      = start + cycles;
+        uint64_t  deadline = std::min(end, cpu->_scheduler.nextEvent());
+
+        // a block running to its end chains into the next one, unless the recompiler has to be given the chance to
+        // run it. idle loops are left to the interpreter
+        do {
+            word   pc    = cpu->_pc;
+            Page  &page  = _pages[pc >> 8];
+            Block *block = page.blocks.empty() ? nullptr : page.blocks[pc & 0xFF].get();
+            if (block == nullptr || block->generation != page.generation) {
+                block = _decode(pc);
+                if (block == nullptr) {
+                    break;
+                }
+            }
+
+            // the same checks as the interpreter's run loop, between every operation. a write to the code of the
+            // page bumps its generation & ends the block, so that the changed code is decoded again
+            uint32_t            generation = page.generation;
+            const CPU::Decoded *decoded    = block->operations.data();
+            const CPU::Decoded *last       = decoded + block->operations.size();
+            if (decoded == last) {
+                break;
+            }
+            while (decoded < last) {
+                decoded += (cpu->*decoded->execute)(decoded, deadline);
+
+                deadline = std::min(end, cpu->_scheduler.nextEvent());
+                if (cpu->_cycles >= deadline || page.generation != generation || cpu->_isInterruptRequested() ||
+                    cpu->_stopped || cpu->_halted) {
+                    return cpu->_cycles - start;
+                }
+            }
+        } while (cpu->_recompiler == nullptr);
+        return cpu->_cycles - start;
+    }
+
+    void BlockCache::written(word address) {
+        const Page &page = _pages[address >> 8];
+        if (page.codeBytes[(address & 0xFF) >> 5] & (uint32_t(1) << (address & 31))) {
+            invalidatePage(address >> 8);
+        }
+    }
+
+    void BlockCache::invalidatePage(byte index) {
+        Page &page = _pages[index];
+        page.generation++;
+        memset(page.codeBytes, 0, sizeof(page.codeBytes));
+
+        // hooked again once the page holds current code
+        if (page.hooked) {
+            page.hooked = false;
+            _cpu->unhookPage(index, false, true);
+        }
+    }
+
+    void BlockCache::flush() {
+        for (uint32_t index = 0; index < 256; index++) {
+            invalidatePage(byte(index));
+            _pages[index].blocks.clear();
+        }
+        _size = 0;
+    }
+
+    std::size_t BlockCache::size() {
+        return _size;
+    }
+
+
+    // decoding --------------------------------------------------------------------------------------------------------
+
+    BlockCache::Block *BlockCache::_decode(word pc) {
+        byte  index = pc >> 8;
+        Page &page  = _pages[index];
+
+        // code is read straight from memory. pages with side effects on read, including watched ones, are left to
+        // the interpreter
+        const byte *data = _cpu->Bus::readPage(index);
+        if (data == nullptr) {
+            return nullptr;
+        }
+
+        // stale blocks are decoded again in place
+        if (page.blocks.empty()) {
+            page.blocks.resize(256);
+        }
+        std::unique_ptr<Block> &slot = page.blocks[pc & 0xFF];
+        if (slot == nullptr) {
+            slot.reset(new Block());
+            _size++;
+        }
+        Block *block      = slot.get();
+        block->generation = page.generation;
+        block->operations.clear();
+
+        // up to the first instruction that may change the control flow, or the last one entirely within the page
+        uint32_t offset = pc & 0xFF;
+        while (block->operations.size() < MAX_OPERATIONS) {
+            byte                  code      = data[offset];
+            const CPU::Operation &operation = _cpu->_operations[code];
+
+            uint32_t length;
+            switch (operation.mode) {
+            case CPU::ADDRESSING_IMP:
+            case CPU::ADDRESSING_ACC:
+                length = 1;
+                break;
+            case CPU::ADDRESSING_ABS:
+            case CPU::ADDRESSING_ABX:
+            case CPU::ADDRESSING_ABY:
+            case CPU::ADDRESSING_IND:
+                length = 3;
+                break;
+            default:
+                length = 2;
+                break;
+            }
+            if (offset + length > 0x100) {
+                break;
+            }
+
+            word address = word(index << 8 | offset);
+            word next    = word(address + length);
+            word operand = length == 1 ? 0x0000 :
+                           length == 2 ? data[offset + 1] :
+                                         word(data[offset + 1] | data[offset + 2] << 8);
+            if (operation.mode == CPU::ADDRESSING_REL) {
+                operand = word(next + int8_t(operand));
+            }
+
+            // a branch or jump to itself is left to the interpreter, which skips idle loops
+            if (block->operations.empty() && (operation.mode == CPU::ADDRESSING_REL || code == 0x4C) &&
+                operand == address) {
+                break;
+            }
+
+            bool terminator;
+            switch (operation.sequence) {
+            case CPU::SEQUENCE_READ:
+            case CPU::SEQUENCE_WRITE:
+            case CPU::SEQUENCE_READ_MODIFY_WRITE:
+            case CPU::SEQUENCE_PUSH:
+            case CPU::SEQUENCE_PULL:
+                terminator = false;
+                break;
+            default:
+                terminator = true;
+                break;
+            }
+
+            block->operations.push_back((CPU::Decoded){CPU::_decodedOperations[code], operand, next, code, 0});
+            for (uint32_t i = offset; i < offset + length; i++) {
+                page.codeBytes[i >> 5] |= uint32_t(1) << (i & 31);
+            }
+
+            offset += length;
+            if (terminator || offset == 0x100) {
+                break;
+            }
+        }
+
+        _fuse(block);
+
+        // writes to the code have to be seen
+        if (page.hooked == false && block->operations.empty() == false) {
+            page.hooked = true;
+            _cpu->hookPage(index, false, true);
+        }
+        return block;
+    }
+
+    void BlockCache::_fuse(Block *block) {
+        std::vector<CPU::Decoded> &operations = block->operations;
+        for (size_t i = 0; i < operations.size(); i++) {
+            for (const CPU::Fusion *fusion = CPU::_fusions; fusion->length > 0; fusion++) {
+                if (i + fusion->length > operations.size()) {
+                    continue;
+                }
+
+                bool matches = true;
+                for (byte j = 0; j < fusion->length && matches; j++) {
+                    matches = operations[i + j].code == fusion->codes[j];
+                }
+                if (matches == false) {
+                    continue;
+                }
+
+                // the budget & the next event are checked before running the idiom, against the most cycles it
+                // takes before its last instruction: the base cycles plus a page crossing penalty, or two for a branch
+                uint32_t lead = 0;
+                for (byte j = 0; j + 1 < fusion->length; j++) {
+                    const CPU::Operation &operation = _cpu->_operations[fusion->codes[j]];
+                    lead += operation.cycles + (operation.mode == CPU::ADDRESSING_REL ? 2 : 1);
+                }
+                operations[i].execute = fusion->execute;
+                operations[i].lead    = byte(lead);
+                break;
+            }
+        }
+    }
+}
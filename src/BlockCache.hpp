@@ -0,0 +1,101 @@
+//
+//  BlockCache.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_BLOCK_CACHE_HPP__
+#define __RT_6502_EMULATOR_BLOCK_CACHE_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "types.hpp"
+#include "CPU.hpp"
+
+namespace rt_6502_emulator {
+
+    /// Cache of predecoded blocks of 6502 code. See `CPU::setPredecoding`.
+    ///
+    /// A block is a straight-line run of instructions within a page, up to the first instruction that may change
+    /// the control flow. It is decoded the first time its start address is reached at an instruction boundary of
+    /// `CPU::run`: each instruction becomes an operation specialized on its addressing mode & instruction, with the
+    /// operand bytes fetched & branch targets computed ahead of time. Running a block calls the operations back to
+    /// back, checking for events, interrupt requests & the end of the budget between them as the interpreter does.
+    /// A block run to its end continues with the block at the new program counter, unless the `Recompiler` is on.
+    ///
+    /// Common idioms (`DEX; BNE`, `LDA; STA`, `CLC; ADC`, `INY; CPY; BNE` etc, see `CPU::_fusions`) are recognized
+    /// when decoding & run by a fused handler, which inlines their instructions into one function. A fused handler
+    /// only runs if neither the budget nor the next event can be reached within it, & checks for interrupt requests
+    /// after instructions accessing the bus, so cycle counts & the points at which interrupts are serviced do not
+    /// change.
+    ///
+    /// Each page has a write generation, bumped when a byte of decoded code in the page is written to or a bank is
+    /// switched into the page. Blocks record the generation they were decoded at & are decoded again when it no
+    /// longer matches, reusing their storage. Writes to other bytes leave the blocks alone. Pages holding decoded
+    /// code have their writes hooked, the same as for the `Recompiler`. Memory changed by other means than the CPU
+    /// & its bus needs `CPU::flushTranslations`.
+    class BlockCache {
+    public:
+
+        /// Constructs an empty cache for the given CPU.
+        BlockCache(CPU *cpu);
+
+        /// Destructor. Releases the pages hooked on the CPU's bus.
+        ~BlockCache();
+
+
+        /// Runs the block starting at the program counter & the blocks it continues with, decoding them first if
+        /// needed. Called by `CPU::run` at instruction boundaries where no interrupt is requested.
+        ///
+        /// @param cycles the clock cycles left in the budget. the block exits once they have elapsed
+        ///
+        /// @returns the number of clock cycles run, already added to the CPU's clock. 0 if no block was run
+        uint64_t run(uint64_t cycles);
+
+        /// Notes a write to the given address. Bumps the generation of the page if the address holds decoded code.
+        void written(word address);
+
+        /// Bumps the generation of the given page, so that its blocks are decoded again.
+        void invalidatePage(byte page);
+
+        /// Discards all blocks.
+        void flush();
+
+        /// Gets the number of blocks decoded since the last flush, including stale ones.
+        std::size_t size();
+
+    private:
+
+        /// A predecoded block.
+        typedef struct _Block {
+            uint32_t                  generation;   // generation of the page when decoded
+            std::vector<CPU::Decoded> operations;   // empty if the block is left to the interpreter
+        } Block;
+
+        /// Blocks & generation of a page.
+        typedef struct _Page {
+            uint32_t                             generation;
+            uint32_t                             codeBytes[8];  // bytes holding decoded code
+            bool                                 hooked;        // set while the writes of the page are hooked
+            std::vector<std::unique_ptr<Block> > blocks;        // block starting at each address, if any
+        } Page;
+
+        CPU         *_cpu;
+        Page         _pages[256];
+        std::size_t  _size;
+
+        /// Decodes the block starting at the given address.
+        ///
+        /// @returns the block or `nullptr` if the page cannot be read directly
+        Block *_decode(word pc);
+
+        /// Finds the idioms in the given block & sets up their fused handlers.
+        void _fuse(Block *block);
+    };
+}
+
+#endif // __RT_6502_EMULATOR_BLOCK_CACHE_HPP__
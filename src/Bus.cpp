@@ -6,21 +6,88 @@
 //  Copyright (c) 2020 Rakesh Ayyaswami. All rights reserved.
 //
 
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
 #include "Bus.hpp"
+#include "Snapshot.hpp"
 
 namespace rt_6502_emulator {
 
 
     // constructors & destructor ---------------------------------------------------------------------------------------
 
-    Bus::Bus() {}
-    Bus::~Bus() {}
+    Bus::Bus() {
+        for (std::size_t page = 0; page < 256; page++) {
+            _readHooked[page]  = 0;
+            _writeHooked[page] = 0;
+        }
+        _buildPageMap();
+    }
+
+    Bus::~Bus() {
+        for (const std::shared_ptr<Addressable> &device : _devices) {
+            device->removeBus(this);
+        }
+    }
 
 
     // attach ----------------------------------------------------------------------------------------------------------
 
     void Bus::attach(std::shared_ptr<Addressable> device) {
         _devices.push_back(device);
+        device->addBus(this);
+        _buildPageMap();
+    }
+
+    void Bus::refreshPage(byte page) {
+        word pageStart = word(page << 8);
+        word pageEnd   = pageStart | 0x00FF;
+
+        // the page can only be accessed directly if the highest priority device covers the entire page. the device
+        // decides whether it allows direct access. a device that does not (eg. a ROM for writes) leaves the access to
+        // the slow path, which falls through to the lower priority devices.
+        byte *readPage    = _readPages[page];
+        _readPages[page]  = nullptr;
+        _writePages[page] = nullptr;
+        if (_pageMappingIndex[page + 1] > _pageMappingIndex[page]) {
+            const Mapping &first = _pageMappings[_pageMappingIndex[page]];
+            if (first.addressStart <= pageStart && first.addressEnd >= pageEnd) {
+                _readPages[page]  = _readHooked[page]  ? nullptr : first.device->readPage(page);
+                _writePages[page] = _writeHooked[page] ? nullptr : first.device->writePage(page);
+            }
+        }
+
+        // pass the change on to the buses this bus is attached to
+        _pageChanged(page);
+
+        if (_readPages[page] != readPage) {
+            _readPageChanged(page);
+        }
+    }
+
+    void Bus::contentsChanged(byte page) {
+
+        // pass the change on to the buses this bus is attached to
+        _contentsChanged(page);
+        _readPageChanged(page);
+    }
+
+    void Bus::_readPageChanged(byte page) {}
+
+
+    void Bus::hookPage(byte page, bool read, bool write) {
+        _readHooked[page]  += read;
+        _writeHooked[page] += write;
+        refreshPage(page);
+    }
+
+    void Bus::unhookPage(byte page, bool read, bool write) {
+        assert(_readHooked[page] >= read && _writeHooked[page] >= write);
+
+        _readHooked[page]  -= read;
+        _writeHooked[page] -= write;
+        refreshPage(page);
     }
 
 
@@ -32,17 +99,128 @@ namespace rt_6502_emulator {
     word Bus::addressEnd()   { return 0xFFFF; }
 
 
-    // read / write ----------------------------------------------------------------------------------------------------
+    // block access ----------------------------------------------------------------------------------------------------
+
+    bool Bus::readBlock(word address, byte *buffer, size_t length) {
+        assert(size_t(address) + length <= 0x10000);
+
+        // copy page by page, splitting the block across devices only where a page is not backed directly
+        bool   success = true;
+        size_t end     = size_t(address) + length;
+        for (size_t current = address; current < end; ) {
+            size_t       size   = std::min<size_t>(end - current, 0x0100 - (current & 0x00FF));
+            byte         page   = byte(current >> 8);
+            Addressable *device = nullptr;
+            if (_readPages[page]) {
+                memcpy(buffer, _readPages[page] + (current & 0x00FF), size);
+            } else if ((device = _soleDevice(page, word(current), word(current + size - 1))) != nullptr) {
+                success &= device->readBlock(word(current), buffer, size);
+            } else {
+                for (size_t i = 0; i < size; i++) {
+                    buffer[i] = 0x00;
+                    success  &= _readDevices(word(current + i), buffer[i]);
+                }
+            }
+            buffer  += size;
+            current += size;
+        }
+        return success;
+    }
+
+    bool Bus::writeBlock(word address, const byte *buffer, size_t length) {
+        assert(size_t(address) + length <= 0x10000);
+
+        bool   success = true;
+        size_t end     = size_t(address) + length;
+        for (size_t current = address; current < end; ) {
+            size_t       size   = std::min<size_t>(end - current, 0x0100 - (current & 0x00FF));
+            byte         page   = byte(current >> 8);
+            Addressable *device = nullptr;
+            if (_writePages[page]) {
+                memcpy(_writePages[page] + (current & 0x00FF), buffer, size);
+            } else if ((device = _soleDevice(page, word(current), word(current + size - 1))) != nullptr) {
+                success &= device->writeBlock(word(current), buffer, size);
+            } else {
+                for (size_t i = 0; i < size; i++) {
+                    success &= _writeDevices(word(current + i), buffer[i]);
+                }
+            }
+            buffer  += size;
+            current += size;
+        }
+        return success;
+    }
+
+
+    // snapshot --------------------------------------------------------------------------------------------------------
+
+    void Bus::save(Snapshot &snapshot) {
+        snapshot.appendWord(word(_devices.size()));
+        for (const std::shared_ptr<Addressable> &device : _devices) {
+            snapshot.appendWord(device->addressStart());
+            snapshot.appendWord(device->addressEnd());
+            device->save(snapshot);
+        }
+    }
+
+    bool Bus::restore(const Snapshot &snapshot, size_t &offset) {
+        word count;
+        if (snapshot.readWord(offset, count) == false || count != _devices.size()) {
+            return false;
+        }
+
+        // the address range of each device identifies it, so that a snapshot is not restored into a different system
+        for (const std::shared_ptr<Addressable> &device : _devices) {
+            word start, end;
+            if (snapshot.readWord(offset, start) == false || start != device->addressStart() ||
+                snapshot.readWord(offset, end)   == false || end   != device->addressEnd()   ||
+                device->restore(snapshot, offset) == false) {
+                return false;
+            }
+        }
+        return true;
+    }
 
-    bool Bus::read(word address, byte &data) {
-        for (std::size_t i = 0; i < _devices.size(); i++) {
-            std::shared_ptr<Addressable> device = _devices[i];
 
-            if (address < device->addressStart() || address > device->addressEnd()) {
+    // page map --------------------------------------------------------------------------------------------------------
+
+    void Bus::_buildPageMap() {
+        _pageMappings.clear();
+
+        for (std::size_t page = 0; page < 256; page++) {
+            word pageStart = word(page << 8);
+            word pageEnd   = pageStart | 0x00FF;
+
+            // collect the devices overlapping the page in order of priority
+            _pageMappingIndex[page] = _pageMappings.size();
+            for (std::size_t i = 0; i < _devices.size(); i++) {
+                Addressable *device = _devices[i].get();
+                word start = device->addressStart();
+                word end   = device->addressEnd();
+                if (end < pageStart || start > pageEnd) {
+                    continue;
+                }
+                _pageMappings.push_back((Mapping){device, start, end});
+            }
+        }
+        _pageMappingIndex[256] = _pageMappings.size();
+
+        // resolve the direct pointers
+        for (std::size_t page = 0; page < 256; page++) {
+            refreshPage(byte(page));
+        }
+    }
+
+    bool Bus::_readDevices(word address, byte &data) {
+        std::size_t page = address >> 8;
+        for (std::size_t i = _pageMappingIndex[page]; i < _pageMappingIndex[page + 1]; i++) {
+            const Mapping &mapping = _pageMappings[i];
+
+            if (address < mapping.addressStart || address > mapping.addressEnd) {
                 continue;
             }
 
-            bool success = device->read(address, data);
+            bool success = mapping.device->read(address, data);
             if (success) {
                 return true;
             }
@@ -50,15 +228,27 @@ namespace rt_6502_emulator {
         return false;
     }
 
-    bool Bus::write(word address, byte data) {
-        for (std::size_t i = 0; i < _devices.size(); i++) {
-            std::shared_ptr<Addressable> device = _devices[i];
+    Addressable *Bus::_soleDevice(byte page, word start, word end) {
+
+        // with more than one device on the page, accesses that fail on one device fall through to the next. these
+        // are left to the byte at a time path
+        if (_pageMappingIndex[page + 1] - _pageMappingIndex[page] != 1) {
+            return nullptr;
+        }
+        const Mapping &mapping = _pageMappings[_pageMappingIndex[page]];
+        return mapping.addressStart <= start && mapping.addressEnd >= end ? mapping.device : nullptr;
+    }
+
+    bool Bus::_writeDevices(word address, byte data) {
+        std::size_t page = address >> 8;
+        for (std::size_t i = _pageMappingIndex[page]; i < _pageMappingIndex[page + 1]; i++) {
+            const Mapping &mapping = _pageMappings[i];
 
-            if (address < device->addressStart() || address > device->addressEnd()) {
+            if (address < mapping.addressStart || address > mapping.addressEnd) {
                 continue;
             }
 
-            bool success = device->write(address, data);
+            bool success = mapping.device->write(address, data);
             if (success) {
                 return true;
             }
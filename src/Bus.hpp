@@ -43,6 +43,9 @@ namespace rt_6502_emulator {
         /// Read a byte from the specified memory address. If the address does not fall in the range of any connected
         /// device, the method reads 0x00.
         ///
+        /// Pages backed directly by memory are served inline with a single load. Subclasses can call `Bus::read`
+        /// directly to skip the virtual call.
+        ///
         /// @param address the address from which to read
         /// @param data    reference to data byte variable to read into
         ///
@@ -52,6 +55,8 @@ namespace rt_6502_emulator {
         /// Write a byte to the specified memory address. If the address does not fall in the range of any connected
         /// device, the method does nothing.
         ///
+        /// Pages backed directly by memory are served inline with a single store.
+        ///
         /// @param address the address to which to write
         /// @param data    the data byte to write
         ///
@@ -59,16 +64,146 @@ namespace rt_6502_emulator {
         virtual bool write(word address, byte data);
 
 
+        /// Returns the direct read pointer resolved for the given page. See `Addressable::readPage`.
+        ///
+        /// Subclasses can call `Bus::readPage` directly to skip the virtual call.
+        virtual byte *readPage(byte page);
+
+        /// Returns the direct write pointer resolved for the given page. See `Addressable::writePage`.
+        virtual byte *writePage(byte page);
+
+
+        /// Reads a block of bytes from the bus. Pages backed directly by memory are copied with `memcpy`, pages
+        /// covered by a single device are read with the block access of the device & the rest are read a byte at a
+        /// time. Bytes that do not map to a device are set to 0x00. See `Addressable::readBlock`.
+        virtual bool readBlock(word address, byte *buffer, size_t length);
+
+        /// Writes a block of bytes to the bus. Pages are written as for `readBlock`. See `Addressable::writeBlock`.
+        virtual bool writeBlock(word address, const byte *buffer, size_t length);
+
+
         /// Attaches the given device to the bus.
         ///
+        /// Devices attached earlier take priority over devices attached later for overlapping address ranges.
+        ///
         /// @param device the device to attach
         void attach(std::shared_ptr<Addressable> device);
 
+        /// Resolves the direct pointers of the given page again. Called by attached devices when the pointers they
+        /// return for the page change. See `Addressable::_pageChanged`.
+        ///
+        /// @param page the page to resolve (MSB of the address)
+        void refreshPage(byte page);
+
+        /// Notes that the contents shown in the given page changed other than by a write to the page. Called by
+        /// attached devices. See `Addressable::_contentsChanged`.
+        ///
+        /// @param page the page that changed (MSB of the address)
+        void contentsChanged(byte page);
+
+        /// Forces reads and / or writes of the given page to be resolved through the devices instead of through the
+        /// direct pointers, so that accesses to the page can be intercepted. See `Watchpoints` & `Recompiler`.
+        ///
+        /// Hooks are counted, so that more than one client can hook a page. Each hook is released with
+        /// `unhookPage`.
+        ///
+        /// @param page  the page to hook (MSB of the address)
+        /// @param read  `true` to hook reads
+        /// @param write `true` to hook writes
+        void hookPage(byte page, bool read, bool write);
+
+        /// Releases hooks added with `hookPage`. The page is accessed directly again once all of its hooks are
+        /// released.
+        ///
+        /// @param page  the page to unhook (MSB of the address)
+        /// @param read  `true` to release a read hook
+        /// @param write `true` to release a write hook
+        void unhookPage(byte page, bool read, bool write);
+
+
+        /// Appends the state of the attached devices to the given snapshot, in the order they were attached.
+        virtual void save(Snapshot &snapshot);
+
+        /// Restores the state of the attached devices from the given snapshot. The devices attached must match the
+        /// ones attached when the snapshot was saved, in number, order & address range.
+        virtual bool restore(const Snapshot &snapshot, size_t &offset);
+
+    protected:
+
+        /// Direct pointers to the backing store of each page. A `nullptr` entry means accesses to the page have to be
+        /// resolved through the devices mapped onto it. Read by translated code in place of `readPage` & `writePage`.
+        byte *_readPages[256];
+        byte *_writePages[256];
+
+        /// Called by `refreshPage` when the direct read pointer of the given page changes, eg. when a bank is
+        /// switched in, & by `contentsChanged`. Does nothing by default.
+        virtual void _readPageChanged(byte page);
+
     private:
 
+        /// A device mapped onto a page along with its cached address range.
+        typedef struct _Mapping {
+            Addressable *device;
+            word         addressStart;
+            word         addressEnd;
+        } Mapping;
+
         /// List of devices attached to the bus
         std::vector<std::shared_ptr<Addressable> > _devices;
+
+        /// Number of hooks on the reads & writes of each page. See `hookPage`.
+        byte _readHooked[256];
+        byte _writeHooked[256];
+
+        /// Devices overlapping each page, in order of priority. The mappings for page `n` are stored in the range
+        /// `[_pageMappingIndex[n], _pageMappingIndex[n + 1])`.
+        std::vector<Mapping> _pageMappings;
+        std::size_t          _pageMappingIndex[257];
+
+        /// Rebuilds the page map from the list of attached devices.
+        void _buildPageMap();
+
+        /// Reads from the devices mapped onto the page of the given address. Used when the page cannot be read
+        /// directly.
+        bool _readDevices(word address, byte &data);
+
+        /// Writes to the devices mapped onto the page of the given address. Used when the page cannot be written
+        /// directly.
+        bool _writeDevices(word address, byte data);
+
+        /// Gets the only device mapped onto the given page if it covers the given range of the page, or `nullptr`.
+        Addressable *_soleDevice(byte page, word start, word end);
     };
+
+
+    // inline implementations ------------------------------------------------------------------------------------------
+
+    inline byte *Bus::readPage(byte page)  { return _readPages[page]; }
+    inline byte *Bus::writePage(byte page) { return _writePages[page]; }
+
+    inline bool Bus::read(word address, byte &data) {
+
+        // fast path: page is backed directly by a memory device
+        byte *page = _readPages[address >> 8];
+        if (page) {
+            data = page[address & 0xFF];
+            return true;
+        }
+
+        return _readDevices(address, data);
+    }
+
+    inline bool Bus::write(word address, byte data) {
+
+        // fast path: page is backed directly by a memory device
+        byte *page = _writePages[address >> 8];
+        if (page) {
+            page[address & 0xFF] = data;
+            return true;
+        }
+
+        return _writeDevices(address, data);
+    }
 }
 
 #endif // __RT_6502_EMULATOR_BUS_HPP__
@@ -6,14 +6,123 @@
 //  Copyright (c) 2020 Rakesh Ayyaswami. All rights reserved.
 //
 
+#include <assert.h>
+#include <algorithm>
+#include <initializer_list>
+#include "BlockCache.hpp"
 #include "CPU.hpp"
+#include "Recompiler.hpp"
+#include "Snapshot.hpp"
 
 namespace rt_6502_emulator {
 
+    /// Identifies CPU snapshots ("6502" in ASCII, little endian).
+    static const uint32_t SNAPSHOT_MAGIC   = 0x32303536;
+
+    /// Version of the snapshot format. Increment when the saved state changes.
+    static const byte     SNAPSHOT_VERSION = 4;
+
+
+    // decimal mode tables ---------------------------------------------------------------------------------------------
+
+    /* Decimal mode results are precomputed for every carry, accumulator & operand. Each entry holds the result in
+     * the LSB & the carry, zero, overflow & negative flags in the MSB, so that decimal ADC & SBC take a single load.
+     *
+     * The NMOS 6502 computes the flags from intermediate results. ADC sets zero from the binary sum & negative &
+     * overflow from the sum before the high nibble is adjusted. SBC sets all flags from the binary difference.
+     *
+     * SEE: "Appendix A" in http://www.6502.org/tutorials/decimal_mode.html
+     */
+
+    /// Status flags held in the MSB of the decimal mode tables.
+    static const byte DECIMAL_FLAGS = CPU::STATUS_FLAG_CARRY | CPU::STATUS_FLAG_ZERO | CPU::STATUS_FLAG_OVERFLOW |
+                                      CPU::STATUS_FLAG_NEGATIVE;
+
+    typedef struct _DecimalTables {
+        word adc[2][256][256];      // indexed by [carry][accumulator][operand]
+        word sbc[2][256][256];
+
+        _DecimalTables() {
+            for (int c = 0; c < 2; c++) {
+                for (int a = 0; a < 256; a++) {
+                    for (int m = 0; m < 256; m++) {
+                        adc[c][a][m] = _adc(c, a, m);
+                        sbc[c][a][m] = _sbc(c, a, m);
+                    }
+                }
+            }
+        }
+
+        static word _adc(int c, int a, int m) {
+            int lo  = (a & 0x0F) + (m & 0x0F) + c;
+            if (lo > 0x09) {
+                lo += 0x06;
+            }
+            int res = (a & 0xF0) + (m & 0xF0) + (lo > 0x0F ? 0x10 : 0x00) + (lo & 0x0F);
+
+            byte flags = 0x00;
+            if (((a + m + c) & 0xFF) == 0x00) {
+                flags |= CPU::STATUS_FLAG_ZERO;
+            }
+            if (res & 0x80) {
+                flags |= CPU::STATUS_FLAG_NEGATIVE;
+            }
+            if (~(a ^ m) & (a ^ res) & 0x80) {
+                flags |= CPU::STATUS_FLAG_OVERFLOW;
+            }
+            if (res > 0x9F) {
+                res   += 0x60;
+            }
+            if (res > 0xFF) {
+                flags |= CPU::STATUS_FLAG_CARRY;
+            }
+            return (word(flags) << 8) | (res & 0xFF);
+        }
+
+        static word _sbc(int c, int a, int m) {
+            int bin = a - m - (1 - c);
+            int lo  = (a & 0x0F) - (m & 0x0F) - (1 - c);
+            int hi  = (a >> 4) - (m >> 4);
+            if (lo & 0x10) {
+                lo -= 0x06;
+                hi--;
+            }
+            if (hi & 0x10) {
+                hi -= 0x06;
+            }
+
+            byte flags = 0x00;
+            if (bin >= 0) {
+                flags |= CPU::STATUS_FLAG_CARRY;
+            }
+            if ((bin & 0xFF) == 0x00) {
+                flags |= CPU::STATUS_FLAG_ZERO;
+            }
+            if (bin & 0x80) {
+                flags |= CPU::STATUS_FLAG_NEGATIVE;
+            }
+            if ((a ^ m) & (a ^ bin) & 0x80) {
+                flags |= CPU::STATUS_FLAG_OVERFLOW;
+            }
+            return (word(flags) << 8) | ((unsigned(hi) << 4) & 0xF0) | (lo & 0x0F);
+        }
+    } DecimalTables;
+
+    /// Returns the decimal mode tables, built on first use.
+    static const DecimalTables &_decimalTables() {
+        static const DecimalTables *tables = new DecimalTables();
+        return *tables;
+    }
+
     // constructor & destructor ----------------------------------------------------------------------------------------
 
-    CPU::CPU() {
-        _initOperations();
+    CPU::CPU(): _watchpoints(this) {
+        _cycles        = 0;
+        _interrupts    = 0;
+        _nmiSources    = 0;
+        _cycleAccurate = false;
+        _stopped       = false;
+        _decimalTables();
         reset();
     }
 
@@ -28,11 +137,81 @@ namespace rt_6502_emulator {
     byte CPU::getIndexX()         { return _idx; }
     byte CPU::getIndexY()         { return _idy; }
     byte CPU::getStackPointer()   { return _stackP; }
-    byte CPU::getStatus()         { return _status; }
+    byte CPU::getStatus()         { return _packStatus(); }
     word CPU::getProgramCounter() { return _pc; }
+    uint64_t CPU::getCycles()     { return _cycles; }
+
+    bool CPU::isHalted() {
+        return _halted;
+    }
 
     bool CPU::isOperationComplete() {
-        return _opCycles == 0;
+        return _opCycles == 0 && _cycleStep == 0;
+    }
+
+    bool CPU::isCycleAccurate() {
+        return _cycleAccurate;
+    }
+
+    void CPU::setCycleAccurate(bool cycleAccurate) {
+        _cycleAccurate = cycleAccurate;
+    }
+
+    bool CPU::isRecompiling() {
+        return _recompiler != nullptr;
+    }
+
+    void CPU::setRecompiling(bool recompiling) {
+        if (recompiling == false) {
+            _recompiler.reset();
+        } else if (_recompiler == nullptr && Recompiler::isSupported()) {
+            _recompiler.reset(new Recompiler(this));
+        }
+    }
+
+    bool CPU::isPredecoding() {
+        return _blockCache != nullptr;
+    }
+
+    void CPU::setPredecoding(bool predecoding) {
+        if (predecoding == false) {
+            _blockCache.reset();
+        } else if (_blockCache == nullptr) {
+            _blockCache.reset(new BlockCache(this));
+        }
+    }
+
+    void CPU::flushTranslations() {
+        if (_recompiler) {
+            _recompiler->flush();
+        }
+        if (_blockCache) {
+            _blockCache->flush();
+        }
+    }
+
+    Scheduler &CPU::getScheduler() {
+        return _scheduler;
+    }
+
+    Watchpoints &CPU::getWatchpoints() {
+        return _watchpoints;
+    }
+
+    std::shared_ptr<TraceRecorder> CPU::getTraceRecorder() {
+        return _traceRecorder;
+    }
+
+    void CPU::setTraceRecorder(std::shared_ptr<TraceRecorder> traceRecorder) {
+        _traceRecorder = traceRecorder;
+    }
+
+    std::shared_ptr<Profiler> CPU::getProfiler() {
+        return _profiler;
+    }
+
+    void CPU::setProfiler(std::shared_ptr<Profiler> profiler) {
+        _profiler = profiler;
     }
 
 
@@ -44,9 +223,12 @@ namespace rt_6502_emulator {
         _acc           = 0x00;
         _idx           = 0x00;
         _idy           = 0x00;
-        _stackP        = 0x00;
-        _status        = STATUS_FLAG_UNUSED | STATUS_FLAG_DISABLE_INTERRUPTS;
-        _interruptType = INTERRUPT_TYPE_NONE;
+        _stackP        = 0xFD;
+        _unpackStatus(STATUS_FLAG_UNUSED | STATUS_FLAG_DISABLE_INTERRUPTS);
+        _halted        = false;
+
+        // discard latched interrupts. the lines stay asserted by their sources
+        _interrupts   &= ~(INTERRUPT_IRQ_PULSE | INTERRUPT_NMI_LATCH);
 
         // read program start address from 0xFFFC to initialize the program counter
         _pc            = word(_read(0xFFFC)) | (word(_read(0xFFFD)) << 8);
@@ -54,87 +236,314 @@ namespace rt_6502_emulator {
         // reset current op addressing
         _opTargetAcc   = false;
         _opAddress     = 0x0000;
+        _opLatched     = false;
+        _opPC          = _pc;
+        _opOperandCount = 0;
+        _cycleStep     = 0;
 
         // reset takes 8 clock cycles
         _opCycles      = 8;
     }
 
     void CPU::irq() {
-        _interruptType = INTERRUPT_TYPE_MASKABLE;
+        _interrupts |= INTERRUPT_IRQ_PULSE;
     }
 
     void CPU::nmi() {
-        _interruptType = INTERRUPT_TYPE_NON_MASKABLE;
+        _interrupts |= INTERRUPT_NMI_LATCH;
+    }
+
+    void CPU::assertIRQ(byte source) {
+        assert(source < INTERRUPT_SOURCES);
+        _interrupts |= uint32_t(1) << source;
+    }
+
+    void CPU::releaseIRQ(byte source) {
+        assert(source < INTERRUPT_SOURCES);
+        _interrupts &= ~(uint32_t(1) << source);
+    }
+
+    bool CPU::isIRQAsserted() {
+        return (_interrupts & ~(INTERRUPT_IRQ_PULSE | INTERRUPT_NMI_LATCH)) != 0;
+    }
+
+    void CPU::assertNMI(byte source) {
+        assert(source < INTERRUPT_SOURCES);
+
+        // latch on the edge of the line going from released to asserted
+        if (_nmiSources == 0) {
+            _interrupts |= INTERRUPT_NMI_LATCH;
+        }
+        _nmiSources |= uint32_t(1) << source;
+    }
+
+    void CPU::releaseNMI(byte source) {
+        assert(source < INTERRUPT_SOURCES);
+        _nmiSources &= ~(uint32_t(1) << source);
+    }
+
+    void CPU::stop() {
+        _stopped = true;
+    }
+
+    bool CPU::isStopped() {
+        return _stopped;
     }
 
     void CPU::tick() {
 
-        // execute next instruction or interrupt request if the clock ticks
-        // required for the previous instruction have elapsed.
-        if (_opCycles == 0) {
+        // events are only dispatched at instruction boundaries, as by `run`. every tick is one for a halted CPU
+        if (_halted || isOperationComplete()) {
+            _dispatchEvents();
+        }
 
-            // execute interrupt request or instruction
-            if (_isInterruptRequested()) {
-                _interrupt();
-            }
-            else {
-                _execute();
-            }
+        // a halted CPU does nothing but let the clock run
+        if (_halted) {
+            _cycles++;
+            return;
+        }
 
-            // reset interrupt request
-            _interruptType = INTERRUPT_TYPE_NONE;
+        // perform a single bus access if in the cycle accurate mode
+        if (_cycleStep > 0 || (_cycleAccurate && _opCycles == 0)) {
+            _tickCycle();
+            _cycles++;
+            return;
+        }
 
-            // ensure unused flag is always set in the status register
-            _setStatusFlag(STATUS_FLAG_UNUSED, true);
+        // execute next instruction or interrupt request if the clock ticks
+        // required for the previous instruction have elapsed.
+        if (_opCycles == 0) {
+            _dispatch();
         }
 
         // decrement cycles for operation
         if (_opCycles > 0) {
             _opCycles--;
         }
+        _cycles++;
     }
 
     byte CPU::step() {
+        if (_halted) {
+            return 0;
+        }
+
         byte count = 0;
         do {
             tick();
             count++;
-        } while(_opCycles > 0);
+        } while(isOperationComplete() == false);
         return count;
     }
 
+    uint64_t CPU::run(uint64_t cycles) {
+        uint64_t elapsed = 0;
+        _stopped         = false;
+        while (elapsed < cycles && !_stopped) {
+            _dispatchEvents();
 
-    // execution helpers -----------------------------------------------------------------------------------------------
+            // a halted CPU stays halted until reset, so time skips to the next event or the end of the budget
+            if (_halted) {
+                uint64_t skipped = std::min(cycles - elapsed, _cyclesToNextEvent());
+                elapsed += skipped;
+                _cycles += skipped;
+                continue;
+            }
 
-    bool CPU::_isInterruptRequested() {
-        switch (_interruptType) {
-        case INTERRUPT_TYPE_MASKABLE:
-            return _getStatusFlag(STATUS_FLAG_DISABLE_INTERRUPTS) == false;
+            // hot code runs translated. a block only runs if it cannot overrun the budget or the next event
+            if (_recompiler && _canRunTranslated()) {
+                uint32_t count = _recompiler->run(std::min(cycles - elapsed, _cyclesToNextEvent()));
+                if (count > 0) {
+                    elapsed += count;
+                    _cycles += count;
+                    continue;
+                }
+            }
 
-        case INTERRUPT_TYPE_NON_MASKABLE:
-            return true;
+            // the rest runs predecoded. a block checks the budget & the next event between its instructions
+            if (_blockCache && _canRunTranslated()) {
+                uint64_t count = _blockCache->run(cycles - elapsed);
+                if (count > 0) {
+                    elapsed += count;
+                    continue;
+                }
+            }
 
-        default:
+            word pc       = _pc;
+            byte stackP   = _stackP;
+            bool boundary = isOperationComplete();
+            byte count    = _runOperation();
+            elapsed      += count;
+
+            // an idle loop repeats with the same cycle count until an event is due or the budget is spent, so skip
+            // its iterations
+            if (_pc == pc && _stackP == stackP && boundary && elapsed < cycles && !_stopped && _isIdleLoop()) {
+                uint64_t limit   = std::min(cycles - elapsed, _cyclesToNextEvent());
+                uint64_t skipped = (limit + count - 1) / count * count;
+                elapsed += skipped;
+                _cycles += skipped;
+            }
+        }
+
+        // events due by the end of the run are dispatched before returning. a stopped run has no excess
+        _dispatchEvents();
+        return elapsed > cycles ? elapsed - cycles : 0;
+    }
+
+
+    // read / write ----------------------------------------------------------------------------------------------------
+
+    bool CPU::write(word address, byte data) {
+        bool success = Bus::write(address, data);
+        if (_recompiler) {
+            _recompiler->written(address);
+        }
+        if (_blockCache) {
+            _blockCache->written(address);
+        }
+        return success;
+    }
+
+    bool CPU::writeBlock(word address, const byte *buffer, size_t length) {
+        bool success = Bus::writeBlock(address, buffer, length);
+        for (size_t i = 0; i < length; i++) {
+            if (_recompiler) {
+                _recompiler->written(word(address + i));
+            }
+            if (_blockCache) {
+                _blockCache->written(word(address + i));
+            }
+        }
+        return success;
+    }
+
+    void CPU::_readPageChanged(byte page) {
+        if (_recompiler) {
+            _recompiler->invalidatePage(page);
+        }
+        if (_blockCache) {
+            _blockCache->invalidatePage(page);
+        }
+    }
+
+
+    // snapshots -------------------------------------------------------------------------------------------------------
+
+    void CPU::save(Snapshot &snapshot) {
+        snapshot.appendUInt32(SNAPSHOT_MAGIC);
+        snapshot.appendByte(SNAPSHOT_VERSION);
+
+        // registers
+        snapshot.appendByte(_acc);
+        snapshot.appendByte(_idx);
+        snapshot.appendByte(_idy);
+        snapshot.appendByte(_stackP);
+        snapshot.appendByte(_packStatus());
+        snapshot.appendWord(_pc);
+
+        // execution state
+        snapshot.appendByte(_opCycles);
+        snapshot.appendUInt64(_cycles);
+        snapshot.appendByte(_opTargetAcc);
+        snapshot.appendWord(_opAddress);
+        snapshot.appendUInt32(_interrupts);
+        snapshot.appendUInt32(_nmiSources);
+        snapshot.appendByte(_halted);
+
+        // cycle accurate execution state
+        snapshot.appendByte(_cycleAccurate);
+        snapshot.appendByte(_cycleStep);
+        snapshot.appendByte(_opCode);
+        snapshot.appendByte(_opInterrupt);
+        snapshot.appendWord(_opBase);
+        snapshot.appendByte(_opData);
+        snapshot.appendByte(_opLatched);
+        snapshot.appendWord(_opPC);
+
+        Bus::save(snapshot);
+    }
+
+    bool CPU::restore(const Snapshot &snapshot, size_t &offset) {
+        uint32_t magic;
+        byte     version;
+        if (snapshot.readUInt32(offset, magic)  == false || magic   != SNAPSHOT_MAGIC ||
+            snapshot.readByte(offset, version)  == false || version != SNAPSHOT_VERSION) {
+            return false;
+        }
+
+        byte targetAcc, halted, cycleAccurate, latched;
+        bool success =
+            snapshot.readByte  (offset, _acc)           &&
+            snapshot.readByte  (offset, _idx)           &&
+            snapshot.readByte  (offset, _idy)           &&
+            snapshot.readByte  (offset, _stackP)        &&
+            snapshot.readByte  (offset, _status)        &&
+            snapshot.readWord  (offset, _pc)            &&
+            snapshot.readByte  (offset, _opCycles)      &&
+            snapshot.readUInt64(offset, _cycles)        &&
+            snapshot.readByte  (offset, targetAcc)      &&
+            snapshot.readWord  (offset, _opAddress)     &&
+            snapshot.readUInt32(offset, _interrupts)    &&
+            snapshot.readUInt32(offset, _nmiSources)    &&
+            snapshot.readByte  (offset, halted)         &&
+            snapshot.readByte  (offset, cycleAccurate)  &&
+            snapshot.readByte  (offset, _cycleStep)     &&
+            snapshot.readByte  (offset, _opCode)        &&
+            snapshot.readByte  (offset, _opInterrupt)   &&
+            snapshot.readWord  (offset, _opBase)        &&
+            snapshot.readByte  (offset, _opData)        &&
+            snapshot.readByte  (offset, latched)        &&
+            snapshot.readWord  (offset, _opPC);
+        if (success == false) {
             return false;
         }
+        _opTargetAcc   = targetAcc;
+        _halted        = halted;
+        _cycleAccurate = cycleAccurate;
+        _opLatched     = latched;
+        _unpackStatus(_status);
+
+        // memory is restored by block copies, which the recompiler & the block cache do not see
+        success = Bus::restore(snapshot, offset);
+        flushTranslations();
+        return success;
     }
 
-    void CPU::_interrupt() {
+    bool CPU::restore(const Snapshot &snapshot) {
+        size_t offset = 0;
+        return restore(snapshot, offset);
+    }
+
+
+    // execution helpers -----------------------------------------------------------------------------------------------
+
+    byte CPU::_acknowledgeInterrupt() {
+
+        // NMI takes priority. an IRQ line asserted by a source stays asserted until the source releases it
+        if (_interrupts & INTERRUPT_NMI_LATCH) {
+            _interrupts &= ~INTERRUPT_NMI_LATCH;
+            return INTERRUPT_TYPE_NON_MASKABLE;
+        }
+        _interrupts &= ~INTERRUPT_IRQ_PULSE;
+        return INTERRUPT_TYPE_MASKABLE;
+    }
+
+    void CPU::_interrupt(byte interruptType) {
 
         // decode interrupt request
         word vector;
-        switch (_interruptType) {
+        switch (interruptType) {
         case INTERRUPT_TYPE_MASKABLE:     vector = 0xFFFE; _opCycles = 7; break;
-        case INTERRUPT_TYPE_NON_MASKABLE: vector = 0xFFFA; _opCycles = 8; break;
+        case INTERRUPT_TYPE_NON_MASKABLE: vector = 0xFFFA; _opCycles = 7; break;
         case INTERRUPT_TYPE_NONE:
         default:
             return;
         }
 
 
-        // push program counter & status on the stack
+        // push program counter & status (with BREAK status cleared) on the stack
         _pushWord(_pc);
-        _pushWord(_status);
+        _pushByte(_packStatus() & ~STATUS_FLAG_BREAK);
 
         // disable interrupts
         _setStatusFlag(STATUS_FLAG_DISABLE_INTERRUPTS, true);
@@ -143,11 +552,112 @@ namespace rt_6502_emulator {
         _pc = word(_read(vector)) | (word(_read(vector + 1)) << 8);
     }
 
+    template <bool (CPU::*addr)(), bool (CPU::*inst)(), byte cycles>
+    void CPU::_executeOperation() {
+
+        // same as the table driven path in `_execute` but with the addressing mode & instruction known at compile
+        // time, which allows the compiler to inline both & drop the unused parts of the addressing state
+        _opCycles     = cycles;
+        _opTargetAcc  = false;
+        _opAddress    = 0x0000;
+
+        bool extraCycleAddr = (this->*addr)();
+        bool extraCycleInst = (this->*inst)();
+        _opLatched          = false;
+
+        if (extraCycleAddr && extraCycleInst) {
+            _opCycles++;
+        }
+    }
+
+    template <byte mode, bool (CPU::*inst)(), byte cycles>
+    inline void CPU::_executeDecoded(word operand) {
+        _opCycles     = cycles;
+        _opTargetAcc  = false;
+        _opAddress    = 0x0000;
+
+        bool extraCycleAddr = _addrDecoded<mode>(operand);
+        bool extraCycleInst = (this->*inst)();
+
+        if (extraCycleAddr && extraCycleInst) {
+            _opCycles++;
+        }
+    }
+
+    template <byte code>
+    inline void CPU::_executeCode(word operand) {
+
+        // the op code is known at compile time, so only one case remains
+        switch (code) {
+        #define CPU_OP(code, inst, addr, cycles) \
+            case code: _executeDecoded<ADDRESSING_##addr, &CPU::_inst_##inst, cycles>(operand); break;
+        #include "CPUOperations.def"
+        #undef CPU_OP
+        }
+    }
+
+    template <byte code>
+    constexpr bool CPU::_isRegisterOnly() {
+
+        // immediate operands are read from the page of the block, which has no side effects
+        switch (code) {
+        #define CPU_OP(code, inst, addr, cycles) \
+            case code: return (ADDRESSING_##addr == ADDRESSING_IMP || ADDRESSING_##addr == ADDRESSING_IMM) && \
+                              SEQUENCE(SEQUENCE_OF_##inst) == SEQUENCE_READ;
+        #include "CPUOperations.def"
+        #undef CPU_OP
+        }
+        return false;
+    }
+
+    template <byte code, byte... codes>
+    byte CPU::_runDecoded(const Decoded *decoded, uint64_t deadline) {
+
+        // an idiom that could reach the deadline runs one instruction at a time
+        if constexpr (sizeof...(codes) > 0) {
+            if (_cycles + decoded->lead >= deadline) {
+                return (this->*_decodedOperations[code])(decoded, deadline);
+            }
+        }
+        return _runIdiom<code, codes...>(decoded);
+    }
+
+    template <byte code, byte... codes>
+    inline byte CPU::_runIdiom(const Decoded *decoded) {
+        _pc     = decoded->next;
+        _opCode = code;
+        _executeCode<code>(decoded->operand);
+        _completeDecoded();
+
+        // the idiom is inlined into a single function, so flags set by an instruction & tested by the next stay in
+        // registers. only reads through the bus can have side effects before the last instruction
+        if constexpr (sizeof...(codes) > 0) {
+            if (_isRegisterOnly<code>() ||
+                (_isInterruptRequested() == false && _stopped == false && _cycles < _scheduler.nextEvent())) {
+                return 1 + _runIdiom<codes...>(decoded + 1);
+            }
+        }
+        return 1;
+    }
+
     void CPU::_execute() {
 
         // read next operation
-        byte opcode = _readNextByte();
-        CPU::Operation op = _operations[opcode];
+        byte opcode = _fetchOpCode();
+        _opCode     = opcode;
+
+    #ifdef RT_6502_EMULATOR_SWITCH_DISPATCH
+
+        switch (opcode) {
+        #define CPU_OP(code, inst, addr, cycles) \
+            case code: _executeOperation<&CPU::_addr_##addr, &CPU::_inst_##inst, cycles>(); break;
+        #include "CPUOperations.def"
+        #undef CPU_OP
+        }
+
+    #else
+
+        const CPU::Operation &op = _operations[opcode];
 
         // set the number of cycles required for the op
         _opCycles = op.cycles;
@@ -160,58 +670,258 @@ namespace rt_6502_emulator {
         // require an extra cycle if both the addressing & instruction ask for it
         bool extraCycleAddr = (this->*op.addr)();
         bool extraCycleInst = (this->*op.inst)();
+        _opLatched          = false;
 
         if (extraCycleAddr && extraCycleInst) {
             _opCycles++;
         }
+
+    #endif
+    }
+
+    void CPU::_dispatch() {
+    #ifndef RT_6502_EMULATOR_NO_TRACE
+        word pc            = _pc;
+        _opOperandCount    = 0;
+    #endif
+        byte interruptType = INTERRUPT_TYPE_NONE;
+
+        // execute interrupt request or instruction
+        if (_isInterruptRequested()) {
+            interruptType = _acknowledgeInterrupt();
+            _interrupt(interruptType);
+        }
+        else {
+            _execute();
+        }
+
+        // an IRQ pulse lasts until the next instruction boundary
+        _interrupts &= ~INTERRUPT_IRQ_PULSE;
+
+        // ensure unused flag is always set in the status register
+        _setStatusFlag(STATUS_FLAG_UNUSED, true);
+
+    #ifndef RT_6502_EMULATOR_NO_TRACE
+        if (_traceRecorder) {
+            _trace(pc, interruptType);
+        }
+        if (_profiler) {
+            _profile(pc, interruptType, _opCycles > 0 ? _opCycles : 1);
+        }
+    #endif
+    }
+
+    void CPU::_trace(word pc, byte interruptType) {
+        TraceRecorder::Entry entry;
+        entry.pc            = pc;
+        entry.interruptType = interruptType;
+        entry.opCode        = _opCode;
+        entry.length        = 0;
+        entry.hasAddress    = false;
+        entry.address       = 0x0000;
+
+        if (interruptType == INTERRUPT_TYPE_NONE) {
+            byte mode = _operations[_opCode].mode;
+
+            // the operand bytes are kept as the operation read them
+            switch (mode) {
+            case ADDRESSING_IMP:
+            case ADDRESSING_ACC:
+                break;
+            case ADDRESSING_ABS:
+            case ADDRESSING_ABX:
+            case ADDRESSING_ABY:
+            case ADDRESSING_IND:
+                entry.length = 2;
+                break;
+            default:
+                entry.length = 1;
+                break;
+            }
+            for (byte i = 0; i < entry.length; i++) {
+                entry.operand[i] = _opOperand[i];
+            }
+
+            entry.hasAddress = mode != ADDRESSING_IMP && mode != ADDRESSING_ACC && mode != ADDRESSING_IMM;
+            entry.address    = entry.hasAddress ? _opAddress : 0x0000;
+        }
+
+        entry.acc    = _acc;
+        entry.idx    = _idx;
+        entry.idy    = _idy;
+        entry.stackP = _stackP;
+        entry.status = _packStatus();
+        _traceRecorder->record(entry);
+    }
+
+    void CPU::_profile(word pc, byte interruptType, byte cycles) {
+        const Operation &op = _operations[_opCode];
+
+        // the page crossing penalty is the cycle taken on top of the base cycles. taken branches take another one.
+        bool pageCrossed = false;
+        if (interruptType == INTERRUPT_TYPE_NONE) {
+            switch (op.mode) {
+            case ADDRESSING_ABX:
+            case ADDRESSING_ABY:
+            case ADDRESSING_IZY:
+                pageCrossed = cycles == op.cycles + 1;
+                break;
+            case ADDRESSING_REL:
+                pageCrossed = cycles == op.cycles + 2;
+                break;
+            }
+        }
+
+        _profiler->record(pc, _pc, _opCode, interruptType, cycles, pageCrossed);
+    }
+
+    bool CPU::_isIdleLoop() {
+
+    #ifndef RT_6502_EMULATOR_NO_TRACE
+        // every iteration has to be recorded
+        if (_traceRecorder || _profiler) {
+            return false;
+        }
+    #endif
+
+        // the loop is left as soon as an interrupt is serviced
+        if (_isInterruptRequested()) {
+            return false;
+        }
+
+        // fetching the loop must not have side effects, i.e. it must be read directly from memory. this also rules out
+        // watched pages
+        if (Bus::readPage(_pc >> 8) == nullptr || Bus::readPage((_pc + 2) >> 8) == nullptr) {
+            return false;
+        }
+
+        // `JMP *` or a branch to itself. the branch condition cannot change since the loop does not touch the flags
+        return _opCode == 0x4C || _operations[_opCode].mode == ADDRESSING_REL;
+    }
+
+    byte CPU::_runOperation() {
+
+        // finish the operation left in progress by `tick`
+        byte cycles = _opCycles;
+        if (cycles == 0 && (_cycleAccurate || _cycleStep > 0)) {
+
+            // run the cycle accurate operation to completion one bus access at a time
+            do {
+                _tickCycle();
+                cycles++;
+            } while (_cycleStep > 0);
+        }
+        else if (cycles == 0) {
+
+            // like `tick`, an operation takes at least one clock cycle
+            _dispatch();
+            cycles = _opCycles > 0 ? _opCycles : 1;
+        }
+
+        _opCycles = 0;
+        _cycles  += cycles;
+        return cycles;
     }
 
 
-    // status register helpers -----------------------------------------------------------------------------------------
+    // arithmetic helpers ----------------------------------------------------------------------------------------------
 
-    bool CPU::_getStatusFlag(STATUS_FLAG bit) {
-        return (_status & bit) > 0 ? 1 : 0;
+    void CPU::_decimal(word entry) {
+        _unpackStatus((_status & ~DECIMAL_FLAGS) | (entry >> 8));
+        _acc = entry;
     }
 
-    void CPU::_setStatusFlag(STATUS_FLAG bit, bool value) {
-        if (value) {
-            _status |= bit;
+    void CPU::_add(byte data) {
+        byte carry = _getStatusFlag(STATUS_FLAG_CARRY) ? 0x01 : 0x00;
+        if (_status & STATUS_FLAG_DECIMAL) {
+            _decimal(_decimalTables().adc[carry][_acc][data]);
+            return;
         }
-        else {
-            _status &= ~bit;
+
+        word res  = word(_acc) + word(data) + carry;
+
+        // overflow occurs when both operands are the same sign but the result is of a different sign
+        _setStatusFlag(STATUS_FLAG_CARRY, res > 0xFF);
+        _setStatusFlag(STATUS_FLAG_OVERFLOW, (~(_acc ^ data) & (_acc ^ res)) & 0x80);
+        _setResultStatusFlags(res);
+        _acc      = res;
+    }
+
+    void CPU::_subtract(byte data) {
+        if (_status & STATUS_FLAG_DECIMAL) {
+            _decimal(_decimalTables().sbc[_getStatusFlag(STATUS_FLAG_CARRY) ? 1 : 0][_acc][data]);
+            return;
         }
+
+        // binary subtraction is addition of the inverted operand. see `_inst_SBC`
+        _add(data ^ 0xFF);
     }
 
-    void CPU::_setResultStatusFlags(byte data) {
-        _setStatusFlag(STATUS_FLAG_ZERO,     data == 0x00);
-        _setStatusFlag(STATUS_FLAG_NEGATIVE, data & 0x80);
+    void CPU::_compare(byte reg, byte data) {
+        _setStatusFlag(STATUS_FLAG_CARRY, reg >= data);
+        _setResultStatusFlags(reg - data);
+    }
+
+    void CPU::_storeHigh(byte data, byte index) {
+
+        // the value is ANDed with the MSB of the base address + 1. if the index crosses a page, the MSB of the
+        // target address is replaced with the value as well.
+        word base = _opAddress - index;
+        data     &= (base >> 8) + 1;
+        if ((base & 0xFF00) != (_opAddress & 0xFF00)) {
+            _opAddress = (word(data) << 8) | (_opAddress & 0x00FF);
+        }
+        _store(data);
     }
 
 
     // bus access convenience methods ----------------------------------------------------------------------------------
 
-    byte CPU::_read(word address) {
-        byte data;
-        bool success = read(address, data);
-        return success ? data : 0x00;
+    byte CPU::_readHooked(word address) {
+        byte data = 0x00;
+        Bus::read(address, data);
+        if (_watchpoints.isWatched(address >> 8, Watchpoints::WATCH_READ)) {
+            _watchpoints.hit(address, Watchpoints::WATCH_READ);
+        }
+        return data;
     }
 
-    void CPU::_write(word address, byte data) {
-        write(address, data);
+    void CPU::_writeHooked(word address, byte data) {
+        Bus::write(address, data);
+        if (_recompiler) {
+            _recompiler->written(address);
+        }
+        if (_blockCache) {
+            _blockCache->written(address);
+        }
+        if (_watchpoints.isWatched(address >> 8, Watchpoints::WATCH_WRITE)) {
+            _watchpoints.hit(address, Watchpoints::WATCH_WRITE);
+        }
+    }
+
+    byte CPU::_fetchOpCodeHooked() {
+        word pc   = _pc;
+        byte code = _read(_pc++);
+        if (_watchpoints.isWatched(pc >> 8, Watchpoints::WATCH_EXECUTE)) {
+            _watchpoints.hit(pc, Watchpoints::WATCH_EXECUTE);
+        }
+        return code;
     }
 
     byte CPU::_readNextByte() {
-        return _read(_pc++);
+        byte data = _read(_pc++);
+        _traceOperand(data);
+        return data;
     }
 
     word CPU::_readNextWord() {
-        word lsb = _read(_pc++);
-        word msb = _read(_pc++);
+        word lsb = _readNextByte();
+        word msb = _readNextByte();
         return (msb << 8) | lsb;
     }
 
     void CPU::_pushByte(byte data) {
-        _write(0x0100 & _stackP, data);
+        _write(0x0100 | _stackP, data);
         _stackP--;
     }
 
@@ -221,21 +931,25 @@ namespace rt_6502_emulator {
     }
 
     byte CPU::_popByte() {
-        byte data = _read(0x0100 & _stackP);
         _stackP++;
-        return data;
+        return _read(0x0100 | _stackP);
     }
 
     word CPU::_popWord() {
-        return _popByte() | word(_popByte()) << 8;
+        word lsb = _popByte();
+        word msb = _popByte();
+        return (msb << 8) | lsb;
     }
 
 
     // addressing modes ------------------------------------------------------------------------------------------------
 
     byte CPU::_fetch() {
-        return _opTargetAcc
-            ? _acc
+        if (_opTargetAcc) {
+            return _acc;
+        }
+        return _opLatched
+            ? _opData
             : _read(_opAddress);
     }
 
@@ -258,7 +972,11 @@ namespace rt_6502_emulator {
     }
 
     bool CPU::_addr_IMM() {
-        _opAddress    = ++_pc;
+
+        // the operand is latched as it is read, like the cycle accurate core does
+        _opAddress    = _pc;
+        _opData       = _readNextByte();
+        _opLatched    = true;
         return false;
     }
 
@@ -336,84 +1054,244 @@ namespace rt_6502_emulator {
     }
 
 
+    template <byte mode>
+    inline bool CPU::_addrDecoded(word operand) {
+
+        // the mode is known at compile time, so only one case remains
+        switch (mode) {
+        case ADDRESSING_ACC:
+            _opTargetAcc  = true;
+            return false;
+
+        case ADDRESSING_IMM:
+            _opAddress    = _pc - 1;
+            return false;
+
+        case ADDRESSING_ZPG:
+        case ADDRESSING_ABS:
+            _opAddress    = operand;
+            return false;
+
+        case ADDRESSING_ZPX:
+            _opAddress    = 0x00FF & (operand + _idx);
+            return false;
+
+        case ADDRESSING_ZPY:
+            _opAddress    = 0x00FF & (operand + _idy);
+            return false;
+
+        case ADDRESSING_REL:
+            _opAddress    = operand;
+            return (0xFF00 & _pc) != (0xFF00 & _opAddress);
+
+        case ADDRESSING_ABX:
+            _opAddress    = operand + _idx;
+            return (0xFF00 & operand) != (0xFF00 & _opAddress);
+
+        case ADDRESSING_ABY:
+            _opAddress    = operand + _idy;
+            return (0xFF00 & operand) != (0xFF00 & _opAddress);
+
+        case ADDRESSING_IND: {
+            word lsb      = _read(operand);
+            word msb      = (operand & 0x00FF) == 0x00FF ? _read(operand & 0xFF00) : _read(operand + 1);
+            _opAddress    = (msb << 8) | lsb;
+            return false;
+        }
+
+        case ADDRESSING_IZX: {
+            word address  = operand + _idx;
+            word lsb      = _read(address & 0x00FF);
+            word msb      = _read((address + 1) & 0x00FF);
+            _opAddress    = (msb << 8) | lsb;
+            return false;
+        }
+
+        case ADDRESSING_IZY: {
+            word lsb      = _read(operand & 0x00FF);
+            word msb      = _read((operand + 1) & 0x00FF);
+            _opAddress    = _idy + ((msb << 8) | lsb);
+            return (msb << 8) != (_opAddress & 0xFF00);
+        }
+
+        case ADDRESSING_IMP:
+        default:
+            return false;
+        }
+    }
+
+
     // instructions ----------------------------------------------------------------------------------------------------
 
     /* Instructions for Illegal Op Codes */
 
     bool CPU::_inst_KIL() {
+
+        // the CPU locks up until reset. the program counter is left at the op code
+        _halted = true;
+        _pc--;
         return false;
     }
 
     bool CPU::_inst_SLO() {
+
+        // ASL memory, then ORA with the result
+        byte data = _fetch();
+        _setStatusFlag(STATUS_FLAG_CARRY, data & 0x80);
+        data    <<= 1;
+        _store(data);
+        _acc     |= data;
+        _setResultStatusFlags(_acc);
         return false;
     }
 
     bool CPU::_inst_RLA() {
+
+        // ROL memory, then AND with the result
+        byte data = _fetch();
+        byte res  = (data << 1) | _getStatusFlag(STATUS_FLAG_CARRY);
+        _setStatusFlag(STATUS_FLAG_CARRY, data & 0x80);
+        _store(res);
+        _acc     &= res;
+        _setResultStatusFlags(_acc);
         return false;
     }
 
     bool CPU::_inst_SRE() {
+
+        // LSR memory, then EOR with the result
+        byte data = _fetch();
+        _setStatusFlag(STATUS_FLAG_CARRY, data & 0x01);
+        data    >>= 1;
+        _store(data);
+        _acc     ^= data;
+        _setResultStatusFlags(_acc);
         return false;
     }
 
     bool CPU::_inst_RRA() {
+
+        // ROR memory, then ADC the result. the carry out of the rotate is the carry into the addition
+        byte data = _fetch();
+        byte res  = (data >> 1) | (_getStatusFlag(STATUS_FLAG_CARRY) << 7);
+        _setStatusFlag(STATUS_FLAG_CARRY, data & 0x01);
+        _store(res);
+        _add(res);
         return false;
     }
 
     bool CPU::_inst_SAX() {
+
+        // store A & X without affecting any flags
+        _store(_acc & _idx);
         return false;
     }
 
     bool CPU::_inst_LAX() {
-        return false;
+
+        // LDA & LDX with the same operand
+        _acc = _idx = _fetch();
+        _setResultStatusFlags(_acc);
+        return true;
     }
 
     bool CPU::_inst_DCP() {
+
+        // DEC memory, then CMP with the result
+        byte data = _fetch() - 1;
+        _store(data);
+        _compare(_acc, data);
         return false;
     }
 
     bool CPU::_inst_ISC() {
+
+        // INC memory, then SBC the result
+        byte data = _fetch() + 1;
+        _store(data);
+        _subtract(data);
         return false;
     }
 
     bool CPU::_inst_ANC() {
+
+        // AND, then copy the negative flag to carry as if the result was shifted out by ASL
+        _acc &= _fetch();
+        _setResultStatusFlags(_acc);
+        _setStatusFlag(STATUS_FLAG_CARRY, _acc & 0x80);
         return false;
     }
 
     bool CPU::_inst_ALR() {
+
+        // AND, then LSR the accumulator
+        byte data = _acc & _fetch();
+        _setStatusFlag(STATUS_FLAG_CARRY, data & 0x01);
+        _acc      = data >> 1;
+        _setResultStatusFlags(_acc);
         return false;
     }
 
     bool CPU::_inst_ARR() {
+
+        /* AND, then ROR the accumulator. The result goes through the adder, which sets carry from bit 6 & overflow
+         * from bit 6 XOR bit 5 of the result instead of the rotated out bit.
+         */
+        byte data = _acc & _fetch();
+        _acc      = (data >> 1) | (_getStatusFlag(STATUS_FLAG_CARRY) << 7);
+        _setResultStatusFlags(_acc);
+        _setStatusFlag(STATUS_FLAG_CARRY,    _acc & 0x40);
+        _setStatusFlag(STATUS_FLAG_OVERFLOW, ((_acc >> 6) ^ (_acc >> 5)) & 0x01);
         return false;
     }
 
     bool CPU::_inst_XAA() {
+
+        /* UNSTABLE: The accumulator is ORed with a chip & temperature dependent "magic" constant before being ANDed
+         * with X & the operand. 0xEE is the value observed on most NMOS 6502s.
+         */
+        _acc = (_acc | 0xEE) & _idx & _fetch();
+        _setResultStatusFlags(_acc);
         return false;
     }
 
     bool CPU::_inst_AXS() {
+
+        // X = (A & X) - operand. sets carry like CMP, ignores the carry & decimal flags
+        byte data = _fetch();
+        byte base = _acc & _idx;
+        _compare(base, data);
+        _idx      = base - data;
         return false;
     }
 
     bool CPU::_inst_AHX() {
+        _storeHigh(_acc & _idx, _idy);
         return false;
     }
 
     bool CPU::_inst_SHY() {
+        _storeHigh(_idy, _idx);
         return false;
     }
 
     bool CPU::_inst_SHX() {
+        _storeHigh(_idx, _idy);
         return false;
     }
 
     bool CPU::_inst_TAS() {
+        _stackP = _acc & _idx;
+        _storeHigh(_stackP, _idy);
         return false;
     }
 
     bool CPU::_inst_LAS() {
-        return false;
+
+        // AND the operand with the stack pointer & load the result into A, X & SP
+        _acc = _idx = _stackP = _fetch() & _stackP;
+        _setResultStatusFlags(_acc);
+        return true;
     }
 
 
@@ -427,16 +1305,7 @@ namespace rt_6502_emulator {
          */
 
         // add fetched data with accumulator & carry bit
-        byte data = _fetch();
-        word res  = word(_acc) + word(data) + (_getStatusFlag(STATUS_FLAG_CARRY) ? 0x01 : 0x00);
-
-        // set status flags for result
-        _setStatusFlag(STATUS_FLAG_CARRY, res > 0xFF);
-        _setStatusFlag(STATUS_FLAG_OVERFLOW, (~(_acc ^ data) & (_acc ^ res)) & 0x80);
-        _setResultStatusFlags(res);
-
-        // save result in accumulator
-        _acc      = res;
+        _add(_fetch());
 
         // operation can use extra cycle
         return true;
@@ -456,7 +1325,9 @@ namespace rt_6502_emulator {
     }
 
     bool CPU::_inst_ASL() {
-        word data = word(_fetch()) << 1;
+        byte data = _fetch();
+        _setStatusFlag(STATUS_FLAG_CARRY, data & 0x80);
+        data    <<= 1;
         _setResultStatusFlags(data);
         _store(data);
         return false;
@@ -563,7 +1434,7 @@ namespace rt_6502_emulator {
 
         // push return address & status (with BREAK status set) on the stack
         _pushWord(_pc);
-        _pushByte(_status & STATUS_FLAG_BREAK);
+        _pushByte(_packStatus() | STATUS_FLAG_BREAK);
 
         // disable interrupts until return (RTI)
         _setStatusFlag(STATUS_FLAG_DISABLE_INTERRUPTS, true);
@@ -620,26 +1491,17 @@ namespace rt_6502_emulator {
     }
 
     bool CPU::_inst_CMP() {
-        byte data = _fetch();
-        word res  = word(_acc) - word(data);
-        _setStatusFlag(STATUS_FLAG_CARRY, _acc > data);
-        _setResultStatusFlags(res);
+        _compare(_acc, _fetch());
         return true;
     }
 
     bool CPU::_inst_CPX() {
-        byte data = _fetch();
-        word res  = word(_idx) - word(data);
-        _setStatusFlag(STATUS_FLAG_CARRY, _idx > data);
-        _setResultStatusFlags(res);
+        _compare(_idx, _fetch());
         return false;
     }
 
     bool CPU::_inst_CPY() {
-        byte data = _fetch();
-        word res  = word(_idy) - word(data);
-        _setStatusFlag(STATUS_FLAG_CARRY, _idy > data);
-        _setResultStatusFlags(res);
+        _compare(_idy, _fetch());
         return false;
     }
 
@@ -726,7 +1588,9 @@ namespace rt_6502_emulator {
     }
 
     bool CPU::_inst_NOP() {
-        return false;
+
+        // illegal NOPs with indexed addressing take an extra cycle on page crossing
+        return true;
     }
 
     bool CPU::_inst_ORA() {
@@ -741,7 +1605,7 @@ namespace rt_6502_emulator {
     }
 
     bool CPU::_inst_PHP() {
-        _pushByte(_status | STATUS_FLAG_BREAK);
+        _pushByte(_packStatus() | STATUS_FLAG_BREAK);
         return false;
     }
 
@@ -752,7 +1616,7 @@ namespace rt_6502_emulator {
     }
 
     bool CPU::_inst_PLP() {
-        _status = _popByte();
+        _unpackStatus(_popByte() & ~STATUS_FLAG_BREAK);
         return false;
     }
 
@@ -775,13 +1639,15 @@ namespace rt_6502_emulator {
     }
 
     bool CPU::_inst_RTI() {
-        _status = _popByte() & ~STATUS_FLAG_BREAK;
+        _unpackStatus(_popByte() & ~STATUS_FLAG_BREAK);
         _pc     = _popWord();
         return false;
     }
 
     bool CPU::_inst_RTS() {
-        _pc = _popWord();
+
+        // JSR pushes the address of the last byte of the instruction
+        _pc = _popWord() + 1;
         return false;
     }
 
@@ -792,11 +1658,7 @@ namespace rt_6502_emulator {
          * With this, we can execute the whole thing similar to addition
          * R = A + (M ^ 0xFF) + c
          */
-        byte data = _fetch();
-        word res  = _acc + (data ^ 0xFF) + (_getStatusFlag(STATUS_FLAG_CARRY) ? 0x01 : 0x00);
-        _setStatusFlag(STATUS_FLAG_CARRY, res > 0xFF);
-        _setStatusFlag(STATUS_FLAG_OVERFLOW, (~(_acc ^ data) & (_acc ^ res)) & 0x80);
-        _setResultStatusFlags(res);
+        _subtract(_fetch());
         return true;
     }
 
@@ -869,279 +1731,48 @@ namespace rt_6502_emulator {
     // operations ------------------------------------------------------------------------------------------------------
 
     #define CPU_OP(code, inst, addr, cycles) \
-        _operations[code] = (CPU::Operation){code, #inst, &CPU::_inst_##inst, &CPU::_addr_##addr, cycles}
-
-    void CPU::_initOperations() {
-        CPU_OP(0x00, BRK, IMP, 7);
-        CPU_OP(0x01, ORA, IZX, 6);
-        CPU_OP(0x02, KIL, IMP, 0);
-        CPU_OP(0x03, SLO, IZX, 8);
-        CPU_OP(0x04, NOP, ZPG, 3);
-        CPU_OP(0x05, ORA, ZPG, 3);
-        CPU_OP(0x06, ASL, ZPG, 5);
-        CPU_OP(0x07, SLO, ZPG, 5);
-        CPU_OP(0x08, PHP, IMP, 3);
-        CPU_OP(0x09, ORA, IMM, 2);
-        CPU_OP(0x0A, ASL, IMP, 2);
-        CPU_OP(0x0B, ANC, IMM, 2);
-        CPU_OP(0x0C, NOP, ABS, 4);
-        CPU_OP(0x0D, ORA, ABS, 4);
-        CPU_OP(0x0E, ASL, ABS, 6);
-        CPU_OP(0x0F, SLO, ABS, 6);
-
-        CPU_OP(0x10, BPL, REL, 2); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x11, ORA, IZY, 5); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x12, KIL, IMP, 0);
-        CPU_OP(0x13, SLO, IZY, 8);
-        CPU_OP(0x14, NOP, ZPX, 4);
-        CPU_OP(0x15, ORA, ZPX, 4);
-        CPU_OP(0x16, ASL, ZPX, 6);
-        CPU_OP(0x17, SLO, ZPX, 6);
-        CPU_OP(0x18, CLC, IMP, 2);
-        CPU_OP(0x19, ORA, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x1A, NOP, IMP, 2);
-        CPU_OP(0x1B, SLO, ABY, 7);
-        CPU_OP(0x1C, NOP, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x1D, ORA, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x1E, ASL, ABX, 7);
-        CPU_OP(0x1F, SLO, ABX, 7);
-
-        CPU_OP(0x20, JSR, ABS, 6);
-        CPU_OP(0x21, AND, IZX, 6);
-        CPU_OP(0x22, KIL, IMP, 0);
-        CPU_OP(0x23, RLA, IZX, 8);
-        CPU_OP(0x24, BIT, ZPG, 3);
-        CPU_OP(0x25, AND, ZPG, 3);
-        CPU_OP(0x26, ROL, ZPG, 5);
-        CPU_OP(0x27, RLA, ZPG, 5);
-        CPU_OP(0x28, PLP, IMP, 4);
-        CPU_OP(0x29, AND, IMM, 2);
-        CPU_OP(0x2A, ROL, IMP, 2);
-        CPU_OP(0x2B, ANC, IMM, 2);
-        CPU_OP(0x2C, BIT, ABS, 4);
-        CPU_OP(0x2D, AND, ABS, 4);
-        CPU_OP(0x2E, ROL, ABS, 6);
-        CPU_OP(0x2F, RLA, ABS, 6);
-
-        CPU_OP(0x30, BMI, REL, 2); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x31, AND, IZY, 5); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x32, KIL, IMP, 0);
-        CPU_OP(0x33, RLA, IZY, 8);
-        CPU_OP(0x34, NOP, ZPX, 4);
-        CPU_OP(0x35, AND, ZPX, 4);
-        CPU_OP(0x36, ROL, ZPX, 6);
-        CPU_OP(0x37, RLA, ZPX, 6);
-        CPU_OP(0x38, SEC, IMP, 2);
-        CPU_OP(0x39, AND, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x3A, NOP, IMP, 2);
-        CPU_OP(0x3B, RLA, ABY, 7);
-        CPU_OP(0x3C, NOP, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x3D, AND, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x3E, ROL, ABX, 7);
-        CPU_OP(0x3F, RLA, ABX, 7);
-
-        CPU_OP(0x40, RTI, IMP, 6);
-        CPU_OP(0x41, EOR, IZX, 6);
-        CPU_OP(0x42, KIL, IMP, 0);
-        CPU_OP(0x43, SRE, IZX, 8);
-        CPU_OP(0x44, NOP, ZPG, 3);
-        CPU_OP(0x45, EOR, ZPG, 3);
-        CPU_OP(0x46, LSR, ZPG, 5);
-        CPU_OP(0x47, SRE, ZPG, 5);
-        CPU_OP(0x48, PHA, IMP, 3);
-        CPU_OP(0x49, EOR, IMM, 2);
-        CPU_OP(0x4A, LSR, IMP, 2);
-        CPU_OP(0x4B, ALR, IMM, 2);
-        CPU_OP(0x4C, JMP, ABS, 3);
-        CPU_OP(0x4D, EOR, ABS, 4);
-        CPU_OP(0x4E, LSR, ABS, 6);
-        CPU_OP(0x4F, SRE, ABS, 6);
-
-        CPU_OP(0x50, BVC, REL, 2); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x51, EOR, IZY, 5); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x52, KIL, IMP, 0);
-        CPU_OP(0x53, SRE, IZY, 8);
-        CPU_OP(0x54, NOP, ZPX, 4);
-        CPU_OP(0x55, EOR, ZPX, 4);
-        CPU_OP(0x56, LSR, ZPX, 6);
-        CPU_OP(0x57, SRE, ZPX, 6);
-        CPU_OP(0x58, CLI, IMP, 2);
-        CPU_OP(0x59, EOR, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x5A, NOP, IMP, 2);
-        CPU_OP(0x5B, SRE, ABY, 7);
-        CPU_OP(0x5C, NOP, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x5D, EOR, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x5E, LSR, ABX, 7);
-        CPU_OP(0x5F, SRE, ABX, 7);
-
-        CPU_OP(0x60, RTS, IMP, 6);
-        CPU_OP(0x61, ADC, IZX, 6);
-        CPU_OP(0x62, KIL, IMP, 0);
-        CPU_OP(0x63, RRA, IZX, 8);
-        CPU_OP(0x64, NOP, ZPG, 3);
-        CPU_OP(0x65, ADC, ZPG, 3);
-        CPU_OP(0x66, ROR, ZPG, 5);
-        CPU_OP(0x67, RRA, ZPG, 5);
-        CPU_OP(0x68, PLA, IMP, 4);
-        CPU_OP(0x69, ADC, IMM, 2);
-        CPU_OP(0x6A, ROR, IMP, 2);
-        CPU_OP(0x6B, ARR, IMM, 2);
-        CPU_OP(0x6C, JMP, IND, 5);
-        CPU_OP(0x6D, ADC, ABS, 4);
-        CPU_OP(0x6E, ROR, ABS, 6);
-        CPU_OP(0x6F, RRA, ABS, 6);
-
-        CPU_OP(0x70, BVS, REL, 2); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x71, ADC, IZY, 5); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x72, KIL, IMP, 0);
-        CPU_OP(0x73, RRA, IZY, 8);
-        CPU_OP(0x74, NOP, ZPX, 4);
-        CPU_OP(0x75, ADC, ZPX, 4);
-        CPU_OP(0x76, ROR, ZPX, 6);
-        CPU_OP(0x77, RRA, ZPX, 6);
-        CPU_OP(0x78, SEI, IMP, 2);
-        CPU_OP(0x79, ADC, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x7A, NOP, IMP, 2);
-        CPU_OP(0x7B, RRA, ABY, 7);
-        CPU_OP(0x7C, NOP, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x7D, ADC, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x7E, ROR, ABX, 7);
-        CPU_OP(0x7F, RRA, ABX, 7);
-
-        CPU_OP(0x80, NOP, IMM, 2);
-        CPU_OP(0x81, STA, IZX, 6);
-        CPU_OP(0x82, NOP, IMM, 2);
-        CPU_OP(0x83, SAX, IZX, 6);
-        CPU_OP(0x84, STY, ZPG, 3);
-        CPU_OP(0x85, STA, ZPG, 3);
-        CPU_OP(0x86, STX, ZPG, 3);
-        CPU_OP(0x87, SAX, ZPG, 3);
-        CPU_OP(0x88, DEY, IMP, 2);
-        CPU_OP(0x89, NOP, IMM, 2);
-        CPU_OP(0x8A, TXA, IMP, 2);
-        CPU_OP(0x8B, XAA, IMM, 2);
-        CPU_OP(0x8C, STY, ABS, 4);
-        CPU_OP(0x8D, STA, ABS, 4);
-        CPU_OP(0x8E, STX, ABS, 4);
-        CPU_OP(0x8F, SAX, ABS, 4);
-
-        CPU_OP(0x90, BCC, REL, 2); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0x91, STA, IZY, 6);
-        CPU_OP(0x92, KIL, IMP, 0);
-        CPU_OP(0x93, AHX, IZY, 6);
-        CPU_OP(0x94, STY, ZPX, 4);
-        CPU_OP(0x95, STA, ZPX, 4);
-        CPU_OP(0x96, STX, ZPY, 4);
-        CPU_OP(0x97, SAX, ZPY, 4);
-        CPU_OP(0x98, TYA, IMP, 2);
-        CPU_OP(0x99, STA, ABY, 5);
-        CPU_OP(0x9A, TXS, IMP, 2);
-        CPU_OP(0x9B, TAS, ABY, 5);
-        CPU_OP(0x9C, SHY, ABX, 5);
-        CPU_OP(0x9D, STA, ABX, 5);
-        CPU_OP(0x9E, SHX, ABY, 5);
-        CPU_OP(0x9F, AHX, ABY, 5);
-
-        CPU_OP(0xA0, LDY, IMM, 2);
-        CPU_OP(0xA1, LDA, IZX, 6);
-        CPU_OP(0xA2, LDX, IMM, 2);
-        CPU_OP(0xA3, LAX, IZX, 6);
-        CPU_OP(0xA4, LDY, ZPG, 3);
-        CPU_OP(0xA5, LDA, ZPG, 3);
-        CPU_OP(0xA6, LDX, ZPG, 3);
-        CPU_OP(0xA7, LAX, ZPG, 3);
-        CPU_OP(0xA8, TAY, IMP, 2);
-        CPU_OP(0xA9, LDA, IMM, 2);
-        CPU_OP(0xAA, TAX, IMP, 2);
-        CPU_OP(0xAB, LAX, IMM, 2);
-        CPU_OP(0xAC, LDY, ABS, 4);
-        CPU_OP(0xAD, LDA, ABS, 4);
-        CPU_OP(0xAE, LDX, ABS, 4);
-        CPU_OP(0xAF, LAX, ABS, 4);
-
-        CPU_OP(0xB0, BCS, REL, 2); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xB1, LDA, IZY, 5); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xB2, KIL, IMP, 0);
-        CPU_OP(0xB3, LAX, IZY, 5); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xB4, LDY, ZPX, 4);
-        CPU_OP(0xB5, LDA, ZPX, 4);
-        CPU_OP(0xB6, LDX, ZPY, 4);
-        CPU_OP(0xB7, LAX, ZPY, 4);
-        CPU_OP(0xB8, CLV, IMP, 2);
-        CPU_OP(0xB9, LDA, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xBA, TSX, IMP, 2);
-        CPU_OP(0xBB, LAS, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xBC, LDY, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xBD, LDA, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xBE, LDX, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xBF, LAX, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-
-        CPU_OP(0xC0, CPY, IMM, 2);
-        CPU_OP(0xC1, CMP, IZX, 6);
-        CPU_OP(0xC2, NOP, IMM, 2);
-        CPU_OP(0xC3, DCP, IZX, 8);
-        CPU_OP(0xC4, CPY, ZPG, 3);
-        CPU_OP(0xC5, CMP, ZPG, 3);
-        CPU_OP(0xC6, DEC, ZPG, 5);
-        CPU_OP(0xC7, DCP, ZPG, 5);
-        CPU_OP(0xC8, INY, IMP, 2);
-        CPU_OP(0xC9, CMP, IMM, 2);
-        CPU_OP(0xCA, DEX, IMP, 2);
-        CPU_OP(0xCB, AXS, IMM, 2);
-        CPU_OP(0xCC, CPY, ABS, 4);
-        CPU_OP(0xCD, CMP, ABS, 4);
-        CPU_OP(0xCE, DEC, ABS, 6);
-        CPU_OP(0xCF, DCP, ABS, 6);
-
-        CPU_OP(0xD0, BNE, REL, 2); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xD1, CMP, IZY, 5); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xD2, KIL, IMP, 0);
-        CPU_OP(0xD3, DCP, IZY, 8);
-        CPU_OP(0xD4, NOP, ZPX, 4);
-        CPU_OP(0xD5, CMP, ZPX, 4);
-        CPU_OP(0xD6, DEC, ZPX, 6);
-        CPU_OP(0xD7, DCP, ZPX, 6);
-        CPU_OP(0xD8, CLD, IMP, 2);
-        CPU_OP(0xD9, CMP, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xDA, NOP, IMP, 2);
-        CPU_OP(0xDB, DCP, ABY, 7);
-        CPU_OP(0xDC, NOP, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xDD, CMP, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xDE, DEC, ABX, 7);
-        CPU_OP(0xDF, DCP, ABX, 7);
-
-        CPU_OP(0xE0, CPX, IMM, 2);
-        CPU_OP(0xE1, SBC, IZX, 6);
-        CPU_OP(0xE2, NOP, IMM, 2);
-        CPU_OP(0xE3, ISC, IZX, 8);
-        CPU_OP(0xE4, CPX, ZPG, 3);
-        CPU_OP(0xE5, SBC, ZPG, 3);
-        CPU_OP(0xE6, INC, ZPG, 5);
-        CPU_OP(0xE7, ISC, ZPG, 5);
-        CPU_OP(0xE8, INX, IMP, 2);
-        CPU_OP(0xE9, SBC, IMM, 2);
-        CPU_OP(0xEA, NOP, IMP, 2);
-        CPU_OP(0xEB, SBC, IMM, 2);
-        CPU_OP(0xEC, CPX, ABS, 4);
-        CPU_OP(0xED, SBC, ABS, 4);
-        CPU_OP(0xEE, INC, ABS, 6);
-        CPU_OP(0xEF, ISC, ABS, 6);
-
-        CPU_OP(0xF0, BEQ, REL, 2); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xF1, SBC, IZY, 5); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xF2, KIL, IMP, 0);
-        CPU_OP(0xF3, ISC, IZY, 8);
-        CPU_OP(0xF4, NOP, ZPX, 4);
-        CPU_OP(0xF5, SBC, ZPX, 4);
-        CPU_OP(0xF6, INC, ZPX, 6);
-        CPU_OP(0xF7, ISC, ZPX, 6);
-        CPU_OP(0xF8, SED, IMP, 2);
-        CPU_OP(0xF9, SBC, ABY, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xFA, NOP, IMP, 2);
-        CPU_OP(0xFB, ISC, ABY, 7);
-        CPU_OP(0xFC, NOP, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xFD, SBC, ABX, 4); // TODO: Add 1 cycle if page boundary is crossed
-        CPU_OP(0xFE, INC, ABX, 7);
-        CPU_OP(0xFF, ISC, ABX, 7);
-    }
+        { &CPU::_inst_##inst, &CPU::_addr_##addr, code, #inst, cycles, ADDRESSING_##addr, SEQUENCE_OF_##inst },
+
+    constexpr CPU::Operation CPU::_operations[256] = {
+        #include "CPUOperations.def"
+    };
+
+    #undef CPU_OP
+
+    #define CPU_OP(code, inst, addr, cycles) \
+        &CPU::_runDecoded<code>,
+
+    const CPU::DecodedOperation CPU::_decodedOperations[256] = {
+        #include "CPUOperations.def"
+    };
+
+    #undef CPU_OP
+
+    #define CPU_FUSION(...) \
+        { { __VA_ARGS__ }, byte(std::initializer_list<byte>{ __VA_ARGS__ }.size()), &CPU::_runDecoded<__VA_ARGS__> }
+
+    const CPU::Fusion CPU::_fusions[] = {
+        CPU_FUSION(0xC8, 0xC0, 0xD0),   // INY; CPY #; BNE
+        CPU_FUSION(0xE8, 0xE0, 0xD0),   // INX; CPX #; BNE
+        CPU_FUSION(0xCA, 0xD0),         // DEX; BNE
+        CPU_FUSION(0x88, 0xD0),         // DEY; BNE
+        CPU_FUSION(0xE8, 0xD0),         // INX; BNE
+        CPU_FUSION(0xC8, 0xD0),         // INY; BNE
+        CPU_FUSION(0xCA, 0x10),         // DEX; BPL
+        CPU_FUSION(0x88, 0x10),         // DEY; BPL
+        CPU_FUSION(0xB1, 0x91),         // LDA (zp),Y; STA (zp),Y
+        CPU_FUSION(0xBD, 0x9D),         // LDA abs,X; STA abs,X
+        CPU_FUSION(0xB9, 0x99),         // LDA abs,Y; STA abs,Y
+        CPU_FUSION(0xA9, 0x85),         // LDA #; STA zp
+        CPU_FUSION(0xA9, 0x8D),         // LDA #; STA abs
+        CPU_FUSION(0xA5, 0x85),         // LDA zp; STA zp
+        CPU_FUSION(0xAD, 0x8D),         // LDA abs; STA abs
+        CPU_FUSION(0x18, 0x69),         // CLC; ADC #
+        CPU_FUSION(0x18, 0x65),         // CLC; ADC zp
+        CPU_FUSION(0x38, 0xE9),         // SEC; SBC #
+        CPU_FUSION(0x38, 0xE5),         // SEC; SBC zp
+        { {}, 0, nullptr },
+    };
+
+    #undef CPU_FUSION
 }
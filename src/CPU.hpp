@@ -9,11 +9,20 @@
 #ifndef __RT_6502_EMULATOR_CPU_HPP__
 #define __RT_6502_EMULATOR_CPU_HPP__
 
+#include <stdint.h>
+#include <memory>
 #include "types.hpp"
 #include "Bus.hpp"
+#include "Profiler.hpp"
+#include "Scheduler.hpp"
+#include "TraceRecorder.hpp"
+#include "Watchpoints.hpp"
 
 namespace rt_6502_emulator {
 
+    class BlockCache;
+    class Recompiler;
+
     /// The 6502 CPU.
     ///
     /// References:
@@ -21,6 +30,23 @@ namespace rt_6502_emulator {
     /// - http://www.oxyron.de/html/opcodes02.html
     /// - http://archive.6502.org/datasheets/mos_6501-6505_mpu_preliminary_aug_1975.pdf
     /// - http://nesdev.com/6502bugs.txt
+    ///
+    /// Execution modes:
+    /// - Instruction level (default) - an entire instruction is executed on the first clock tick of the instruction
+    ///   and the remaining ticks are idle. This is the fastest mode.
+    /// - Cycle accurate - each clock tick performs the bus access the 6502 performs on that cycle, including the
+    ///   dummy reads & writes. Use this for peripherals sensitive to bus timing. See `setCycleAccurate`.
+    /// - Predecoded - code run by `run` in the instruction level mode is decoded once into blocks of operations
+    ///   that are run back to back, with common idioms fused into single operations. See `setPredecoding`.
+    /// - Recompiled - hot code run by `run` in the instruction level mode is translated to native code. See
+    ///   `setRecompiling`.
+    ///
+    /// Build options:
+    /// - `RT_6502_EMULATOR_SWITCH_DISPATCH` - dispatch op codes through a switch over operations specialized at
+    ///   compile time on their addressing mode & instruction, instead of through the `_operations` table. This lets
+    ///   the compiler inline the addressing mode into the instruction.
+    /// - `RT_6502_EMULATOR_NO_TRACE` - compile out the trace recorder & profiler hooks. See `setTraceRecorder` &
+    ///   `setProfiler`.
     class CPU : public Bus {
 
     // status flags ----------------------------------------------------------------------------------------------------
@@ -38,13 +64,16 @@ namespace rt_6502_emulator {
             STATUS_FLAG_NEGATIVE           = (1 << 7),
         };
 
-        /// Interrupt type. Used to indicate the last requested interrupt type.
+        /// Interrupt type. Used to indicate the interrupt serviced by an operation.
         enum INTERRUPT_TYPE {
             INTERRUPT_TYPE_NONE,
             INTERRUPT_TYPE_MASKABLE,
             INTERRUPT_TYPE_NON_MASKABLE,
         };
 
+        /// Number of sources that can assert the IRQ & NMI lines. See `assertIRQ` & `assertNMI`.
+        static const byte INTERRUPT_SOURCES = 30;
+
 
     // accessors -------------------------------------------------------------------------------------------------------
     public:
@@ -67,10 +96,84 @@ namespace rt_6502_emulator {
         /// Gets the current address in the program counter
         word getProgramCounter();
 
+        /// Gets the total number of clock cycles elapsed since the CPU was constructed.
+        uint64_t getCycles();
+
+        /// Gets whether the CPU was halted by a KIL op code. A halted CPU does not execute anything nor service any
+        /// interrupt until it is reset.
+        bool isHalted();
+
         /// Gets whether the current operation has completed executing.
         /// This is useful for debugging & single stepping through the program.
         bool isOperationComplete();
 
+        /// Gets whether new instructions are executed one bus access per clock tick.
+        bool isCycleAccurate();
+
+        /// Selects between the instruction level & the cycle accurate execution modes. The mode can be changed at
+        /// any time. An operation already in progress completes in the mode it was started in.
+        ///
+        /// @param cycleAccurate `true` to perform each bus access on the clock tick the 6502 performs it
+        void setCycleAccurate(bool cycleAccurate);
+
+        /// Gets whether hot code is translated to native code.
+        bool isRecompiling();
+
+        /// Turns the dynamic recompiler on or off. See `Recompiler`. Has no effect if the host is not supported.
+        ///
+        /// Translated code only runs in `run`, in the instruction level mode & while no trace recorder or profiler
+        /// is set. It yields the same results, cycle for cycle, as the interpreter. Watched pages & pages that cannot
+        /// be read directly are always interpreted. Do not call from callbacks during a run.
+        ///
+        /// @param recompiling `true` to translate hot code
+        void setRecompiling(bool recompiling);
+
+        /// Gets whether code is predecoded into blocks.
+        bool isPredecoding();
+
+        /// Turns the predecoded block cache on or off. See `BlockCache`. Code the recompiler has translated runs
+        /// translated, the rest runs predecoded.
+        ///
+        /// Like translated code, predecoded code only runs in `run`, in the instruction level mode & while no trace
+        /// recorder or profiler is set. It yields the same results, cycle for cycle, as the interpreter. Pages that
+        /// cannot be read directly are always interpreted. Do not call from callbacks during a run.
+        ///
+        /// @param predecoding `true` to predecode code
+        void setPredecoding(bool predecoding);
+
+        /// Discards the translated & predecoded code. Needed after changing memory holding code other than through
+        /// the CPU & its bus, eg. through a device directly. Writes by the program, `write`, `writeBlock`, bank
+        /// switching & `restore` are taken care of.
+        void flushTranslations();
+
+        /// Gets the scheduler devices register clock cycle deadlines with, in place of polling the CPU's clock. Due
+        /// events are dispatched at instruction boundaries by `tick`, `step`, `run` & `runUntil`, so callbacks can
+        /// raise interrupts that are serviced at the next boundary. Events are not part of snapshots.
+        Scheduler &getScheduler();
+
+        /// Gets the watchpoints memory accesses by the CPU are checked against. Accesses to pages without
+        /// watchpoints are served from the direct page pointers as usual & cost nothing extra. Callbacks can `stop`
+        /// the CPU to break into a debugger. Watchpoints are not part of snapshots.
+        Watchpoints &getWatchpoints();
+
+        /// Gets the trace recorder operations are recorded to, if any.
+        std::shared_ptr<TraceRecorder> getTraceRecorder();
+
+        /// Records every operation executed from now on, including interrupts, to the given trace recorder. Pass
+        /// `nullptr` to stop recording. Tracing costs a single test per operation when off.
+        ///
+        /// @param traceRecorder the recorder to record to
+        void setTraceRecorder(std::shared_ptr<TraceRecorder> traceRecorder);
+
+        /// Gets the profiler operations are counted by, if any.
+        std::shared_ptr<Profiler> getProfiler();
+
+        /// Counts every operation executed from now on, including interrupts, with the given profiler. Pass
+        /// `nullptr` to stop profiling. Like tracing, profiling costs a single test per operation when off.
+        ///
+        /// @param profiler the profiler to count with
+        void setProfiler(std::shared_ptr<Profiler> profiler);
+
 
     // public methods  -------------------------------------------------------------------------------------------------
     public:
@@ -79,6 +182,13 @@ namespace rt_6502_emulator {
         CPU();
         ~CPU();
 
+        /// Writes a byte through the bus. Discards the code translated from the address if any. See `Bus::write`.
+        virtual bool write(word address, byte data);
+
+        /// Writes a block of bytes through the bus. Discards the code translated from the block if any. See
+        /// `Bus::writeBlock`.
+        virtual bool writeBlock(word address, const byte *buffer, size_t length);
+
         /// Resets the 6502 to a known state.
         ///
         /// Resetting the 6502 has the following effects:
@@ -88,7 +198,9 @@ namespace rt_6502_emulator {
         /// - The vector at address 0xFFFC & 0xFFFD is loaded into the program counter
         void reset();
 
-        /// Triggers a maskable interrupt if `DISABLE_INTERRUPTS` status bit is not set.
+        /// Pulses the IRQ line. A maskable interrupt is serviced at the next instruction boundary if the
+        /// `DISABLE_INTERRUPTS` status bit is not set at that point, otherwise the request is lost. Devices that hold
+        /// the line until they are acknowledged should use `assertIRQ` instead.
         ///
         /// Triggering an interrupt causes:
         /// - The program counter & status to be pushed on the stack.
@@ -96,25 +208,115 @@ namespace rt_6502_emulator {
         /// - The address at vector 0xFFFE, 0xFFFF to be loaded onto the program counter.
         void irq();
 
-        /// Triggers a non-maskable interrupt.
+        /// Triggers a non-maskable interrupt, as an edge on the NMI line does. The interrupt is latched until it is
+        /// serviced at the next instruction boundary.
         ///
         /// A non-maskable interrupt is similar to a maskable interrupt except for the following:
         /// - The `DISABLE_INTERRUPTS` status bit does not apply to a non-maskable interrupt.
         /// - The address vector loaded onto the program counter is at 0xFFFA, 0xFFFB.
         void nmi();
 
+        /// Asserts the IRQ line on behalf of the given source. The line is level triggered & shared by all sources,
+        /// so a maskable interrupt is serviced at every instruction boundary where the `DISABLE_INTERRUPTS` status
+        /// bit is not set, until every source has released the line. Asserting the line again has no effect.
+        ///
+        /// @param source the source asserting the line, below `INTERRUPT_SOURCES`
+        void assertIRQ(byte source);
+
+        /// Releases the IRQ line on behalf of the given source. Typically done when the interrupt handler
+        /// acknowledges the device.
+        ///
+        /// @param source the source releasing the line, below `INTERRUPT_SOURCES`
+        void releaseIRQ(byte source);
+
+        /// Gets whether any source asserts the IRQ line.
+        bool isIRQAsserted();
+
+        /// Asserts the NMI line on behalf of the given source. The line is edge triggered: a non-maskable interrupt
+        /// is latched when the line goes from released to asserted. Other sources asserting the line while it is
+        /// asserted do not trigger another one.
+        ///
+        /// @param source the source asserting the line, below `INTERRUPT_SOURCES`
+        void assertNMI(byte source);
+
+        /// Releases the NMI line on behalf of the given source.
+        ///
+        /// @param source the source releasing the line, below `INTERRUPT_SOURCES`
+        void releaseNMI(byte source);
+
         /// Performs one clocks worth of operations.
         ///
-        /// Since this is a behavior level emulation, the entire instruction is executed in one clock tick. The
-        /// remaining ticks required for the current instruction to complete just cause the emulator to wait.
+        /// In the default instruction level mode, the entire instruction is executed in one clock tick. The
+        /// remaining ticks required for the current instruction to complete just cause the emulator to wait. In the
+        /// cycle accurate mode, every tick performs one bus access of the instruction. A halted CPU only counts the
+        /// clock cycle.
         void tick();
 
         /// Executes one instruction before returning. This is useful for debugging and stepping through the program.
         /// It fires as many clock ticks as required to complete the instruction.
         ///
-        /// @returns the number of clock ticks elapsed
+        /// @returns the number of clock ticks elapsed. 0 if the CPU is halted
         byte step();
 
+        /// Executes whole instructions back to back until at least the given number of clock cycles have elapsed.
+        ///
+        /// This is the preferred way of driving the CPU at speed. Any operation left in progress by `tick` is
+        /// completed first. Interrupt requests are serviced at instruction boundaries, the same as with `tick`. Since
+        /// an instruction cannot be split, the last one may run past the requested number of cycles. The excess is
+        /// returned so that callers can deduct it from their next time budget.
+        ///
+        /// Idle loops waiting on an interrupt (`JMP *` or a branch to itself) are detected & skipped in whole
+        /// iterations up to the next scheduled event or the end of the budget, instead of being executed. A halted
+        /// CPU skips straight to the next event or the end of the budget. A call to `stop` ends the run early.
+        ///
+        /// @param cycles the number of clock cycles to run for
+        ///
+        /// @returns the number of clock cycles run in excess of `cycles`. 0 if stopped
+        uint64_t run(uint64_t cycles);
+
+        /// Executes whole instructions back to back until the given predicate returns `true`. The predicate is
+        /// tested at every instruction boundary with a reference to this CPU.
+        ///
+        /// @param predicate callable with signature `bool (CPU &)`
+        /// @param maxCycles stops running once at least this many clock cycles have elapsed even if the predicate
+        ///                  was never satisfied. running also stops if the CPU is halted
+        ///
+        /// @returns the number of clock cycles elapsed
+        template <typename Predicate>
+        uint64_t runUntil(Predicate predicate, uint64_t maxCycles = UINT64_MAX);
+
+        /// Stops the current `run` or `runUntil` at the next instruction boundary, ie. once the current instruction
+        /// completes. Meant to be called from event & watchpoint callbacks. Has no effect outside of a run.
+        void stop();
+
+        /// Gets whether the last `run` or `runUntil` was ended by `stop`.
+        bool isStopped();
+
+
+    // snapshots -------------------------------------------------------------------------------------------------------
+    public:
+
+        /// Appends the state of the CPU, including an operation in progress, followed by the state of the attached
+        /// devices to the given snapshot. The snapshot starts with a magic number & format version.
+        ///
+        /// @param snapshot the snapshot to append to
+        virtual void save(Snapshot &snapshot);
+
+        /// Restores the state of the CPU & the attached devices from the given snapshot. The devices attached must
+        /// match the ones attached when the snapshot was saved. See `Bus::restore`.
+        ///
+        /// Memory contents are restored with a block copy, so restoring is cheap enough to fork many runs from a
+        /// single snapshot. If restoring fails part way, the state is undefined & should be restored again.
+        ///
+        /// @param snapshot the snapshot to restore from
+        /// @param offset   read position in the snapshot. advanced past the restored state
+        ///
+        /// @returns `false` if the snapshot is invalid or does not match the attached devices
+        virtual bool restore(const Snapshot &snapshot, size_t &offset);
+
+        /// Restores the state of the CPU & the attached devices from the start of the given snapshot.
+        bool restore(const Snapshot &snapshot);
+
 
     // internal state  -------------------------------------------------------------------------------------------------
     private:
@@ -123,31 +325,239 @@ namespace rt_6502_emulator {
         byte   _idx;            // x index register
         byte   _idy;            // y index register
         byte   _stackP;         // stack pointer
-        byte   _status;         // status register
+        byte   _status;         // status register. the zero, negative, carry & overflow bits are stale, see `_packStatus`
         word   _pc;             // program counter
 
+        byte   _zeroResult;     // zero flag, set if the byte is 0
+        byte   _negativeResult; // negative flag, in bit 7
+        byte   _carry;          // carry flag, 0 or 1
+        byte   _overflow;       // overflow flag, in bit 7
+
         byte   _opCycles;       // tracks remaining clock cycles in an active operation
+        uint64_t _cycles;       // total clock cycles elapsed
 
         bool   _opTargetAcc;    // set to true by the addressing mode if the target is the accumulator
         word   _opAddress;      // target address computed by the addressing mode of the active operation
 
-        byte   _interruptType;  // tracks the last requested interrupt type
+        uint32_t _interrupts;   // IRQ sources asserting the line, the IRQ pulse & the NMI latch. tested at every
+                                // instruction boundary
+        uint32_t _nmiSources;   // NMI sources asserting the line
+        bool   _halted;         // set to true by KIL until reset
+        bool   _stopped;        // set to true by `stop` to end the current run
+
+        bool   _cycleAccurate;  // set to true to start new operations in the cycle accurate mode
+        byte   _cycleStep;      // clock cycle within the active cycle accurate operation. 0 between operations
+        byte   _opCode;         // op code of the active cycle accurate operation
+        byte   _opInterrupt;    // interrupt type being serviced by the active cycle accurate operation
+        word   _opBase;         // address before indexing or pointer address of the active cycle accurate operation
+        byte   _opData;         // operand latched for immediate & cycle accurate read-modify-write instructions
+        bool   _opLatched;      // set to true when the instruction should operate on `_opData`
+        word   _opPC;           // address of the active cycle accurate operation
+        byte   _opOperand[2];   // operand bytes of the active operation as read, for the trace recorder
+        byte   _opOperandCount; // number of operand bytes read by the active operation
+
+        Scheduler                      _scheduler;      // events due at clock cycle deadlines
+        Watchpoints                    _watchpoints;    // memory accesses watched for
+        std::shared_ptr<TraceRecorder> _traceRecorder;  // records executed operations if set
+        std::shared_ptr<Profiler>      _profiler;       // counts executed operations if set
+        std::unique_ptr<Recompiler>    _recompiler;     // translates hot code if set
+        std::unique_ptr<BlockCache>    _blockCache;     // predecodes code if set
+
+        friend class BlockCache;
+        friend class Recompiler;
 
 
     // execution helpers -----------------------------------------------------------------------------------------------
     private:
 
-        /// Tests if any interrupt has been requested.
+        /// Bits of `_interrupts` above the IRQ sources.
+        static const uint32_t INTERRUPT_IRQ_PULSE = uint32_t(1) << 30;
+        static const uint32_t INTERRUPT_NMI_LATCH = uint32_t(1) << 31;
+
+        /// Tests if an interrupt is to be serviced at this instruction boundary.
         ///
         /// @returns `true` if a pending request exists.
         bool _isInterruptRequested();
 
-        /// Executes interrupt request if any.
-        void _interrupt();
+        /// Acknowledges the interrupt to be serviced, clearing the NMI latch or the IRQ pulse.
+        ///
+        /// @returns the `INTERRUPT_TYPE` to service
+        byte _acknowledgeInterrupt();
+
+        /// Executes an interrupt request.
+        ///
+        /// @param interruptType the `INTERRUPT_TYPE` to service
+        void _interrupt(byte interruptType);
 
         /// Executes the next operation in the program.
         void _execute();
 
+        /// Executes an operation specialized at compile time on its addressing mode & instruction. Used by the
+        /// switch dispatch core.
+        template <bool (CPU::*addr)(), bool (CPU::*inst)(), byte cycles>
+        void _executeOperation();
+
+        /// An instruction predecoded by the `BlockCache`.
+        struct _Decoded;
+        typedef struct _Decoded Decoded;
+
+        /// Runs a predecoded instruction, or all the instructions of an idiom starting at it, & completes each as
+        /// `_completeDecoded` does. An idiom is only run as a whole if the worst case clock cycles before its last
+        /// instruction end before the given deadline, & stops early, like `BlockCache::run`, if an instruction
+        /// accessing the bus raises an interrupt request, stops the CPU or schedules an event that is due.
+        ///
+        /// @param decoded  the instruction
+        /// @param deadline the clock cycle of the end of the budget or the next event, whichever is earlier
+        ///
+        /// @returns the number of instructions run
+        typedef byte (CPU::*DecodedOperation)(const Decoded *decoded, uint64_t deadline);
+
+        struct _Decoded {
+            DecodedOperation execute;       // the operation of the op code or the idiom starting at it
+            word             operand;       // operand bytes, little endian, or the target of a branch
+            word             next;          // address of the next instruction
+            byte             code;          // op code
+            byte             lead;          // worst case clock cycles of the idiom before its last instruction
+        };
+
+        /// An idiom run as a single operation. Only the last instruction of an idiom may write to memory.
+        typedef struct _Fusion {
+            byte             codes[3];
+            byte             length;        // number of instructions. 0 ends the `_fusions` table
+            DecodedOperation execute;
+        } Fusion;
+
+        /// Predecoded operations by op code, specialized at compile time like `_executeOperation`.
+        static const DecodedOperation _decodedOperations[256];
+
+        /// Idioms of common instruction sequences (loop counters, loads & stores, additions), longest first.
+        static const Fusion _fusions[];
+
+        /// Executes a predecoded instruction, with the program counter already past it.
+        ///
+        /// @param operand the operand bytes, or the target of a branch
+        template <byte mode, bool (CPU::*inst)(), byte cycles>
+        void _executeDecoded(word operand);
+
+        /// Executes the predecoded instruction of an op code known at compile time.
+        template <byte code>
+        void _executeCode(word operand);
+
+        /// Runs the predecoded instruction or idiom of the given op codes. See `DecodedOperation`.
+        template <byte code, byte... codes>
+        byte _runDecoded(const Decoded *decoded, uint64_t deadline);
+
+        /// Runs the predecoded instructions of the given op codes, without checking the deadline.
+        template <byte code, byte... codes>
+        byte _runIdiom(const Decoded *decoded);
+
+        /// Gets whether the op code only works on registers once predecoded, ie. it cannot access a device, raise
+        /// an interrupt or schedule an event.
+        template <byte code>
+        static constexpr bool _isRegisterOnly();
+
+        /// Completes a predecoded instruction as `_dispatch` & `_runOperation` do, dropping the IRQ pulse & adding
+        /// the clock cycles taken.
+        void _completeDecoded();
+
+        /// Computes the target address of an addressing mode from an operand fetched ahead of time, as the
+        /// `_addr_*` method of the mode does.
+        ///
+        /// @returns `true` if the page crossing penalty applies
+        template <byte mode>
+        bool _addrDecoded(word operand);
+
+        /// Executes the interrupt request if any or else the next operation in the program. This is done at every
+        /// instruction boundary.
+        void _dispatch();
+
+        /// Records the operation that just completed to the trace recorder.
+        ///
+        /// @param pc            address the operation started at
+        /// @param interruptType the interrupt serviced by the operation, if any
+        void _trace(word pc, byte interruptType);
+
+        /// Keeps an operand byte of the active operation as it is read, so the trace recorder does not read it again.
+        ///
+        /// @param data the operand byte read
+        void _traceOperand(byte data);
+
+        /// Counts the operation that just completed with the profiler.
+        ///
+        /// @param pc            address the operation started at
+        /// @param interruptType the interrupt serviced by the operation, if any
+        /// @param cycles        clock cycles taken by the operation
+        void _profile(word pc, byte interruptType, byte cycles);
+
+        /// Dispatches the scheduled events that are due.
+        void _dispatchEvents();
+
+        /// Gets the number of clock cycles until the next scheduled event is due. 0 if an event is due.
+        uint64_t _cyclesToNextEvent();
+
+        /// Tests if the operation that just completed is an idle loop that will repeat until an interrupt is
+        /// serviced. Called by `run` only if the operation left the program counter & stack pointer unchanged.
+        bool _isIdleLoop();
+
+        /// Completes the operation in progress and executes the next one in its entirety.
+        ///
+        /// @returns the number of clock cycles elapsed
+        byte _runOperation();
+
+        /// Tests if translated or predecoded code can run at this point of `run`, ie. at an instruction boundary in
+        /// the instruction level mode, with no interrupt requested & nothing to trace or profile.
+        bool _canRunTranslated();
+
+        /// Discards the code translated & predecoded from the given page when a bank is switched in or its contents
+        /// are written through another page. See `Bus`.
+        virtual void _readPageChanged(byte page);
+
+
+    // cycle accurate execution ----------------------------------------------------------------------------------------
+    private:
+
+        /// Performs the bus access of the next clock cycle of the active operation, starting a new operation or
+        /// interrupt request if none is active.
+        void _tickCycle();
+
+        /// Performs a cycle of the addressing mode of the active operation. Once the target address is resolved,
+        /// hands over to `_cycleAccess`.
+        ///
+        /// @returns `true` if the operation completed on this cycle
+        bool _cycleAddressing();
+
+        /// Performs a cycle of the instruction's access to the resolved target address.
+        ///
+        /// @param step the cycle counted from the first cycle after the target address was resolved, starting at 1.
+        ///             Indexed addressing modes start at 0 with the cycle that fixes the page of the address.
+        ///
+        /// @returns `true` if the operation completed on this cycle
+        bool _cycleAccess(byte step);
+
+        /// Performs a cycle of a branch instruction.
+        bool _cycleBranch();
+
+        /// Performs a cycle of the BRK instruction or an interrupt request, which share their bus accesses.
+        bool _cycleInterrupt();
+
+        /// Performs a cycle of the JSR instruction.
+        bool _cycleJSR();
+
+        /// Performs a cycle of the RTS instruction.
+        bool _cycleRTS();
+
+        /// Performs a cycle of the RTI instruction.
+        bool _cycleRTI();
+
+        /// Performs a cycle of a stack push instruction (PHA, PHP).
+        bool _cyclePush();
+
+        /// Performs a cycle of a stack pull instruction (PLA, PLP).
+        bool _cyclePull();
+
+        /// Performs a cycle of the JMP instruction.
+        bool _cycleJMP();
+
 
     // status register helpers -----------------------------------------------------------------------------------------
     private:
@@ -171,23 +581,82 @@ namespace rt_6502_emulator {
         /// @param data the result of the last CPU operation
         void _setResultStatusFlags(byte data);
 
+        /// Gets the status register.
+        ///
+        /// The zero, negative, carry & overflow flags change with almost every instruction but are rarely looked at
+        /// as a whole. They are kept apart from `_status`, in the form that is cheapest to record: the zero & negative
+        /// flags as the result they were set from. The status register is only put together when it is observed, ie.
+        /// when pushed, saved, traced or read by the host.
+        byte _packStatus();
+
+        /// Sets the status register, splitting out the flags kept apart from it.
+        void _unpackStatus(byte status);
+
+
+    // arithmetic helpers ----------------------------------------------------------------------------------------------
+    private:
+
+        /// Adds data & the carry bit to the accumulator, setting the carry, overflow, zero & negative flags. Honours
+        /// the decimal flag.
+        ///
+        /// @param data the data to add
+        void _add(byte data);
+
+        /// Subtracts data & the borrow (inverted carry bit) from the accumulator, setting the carry, overflow, zero &
+        /// negative flags. Honours the decimal flag.
+        ///
+        /// @param data the data to subtract
+        void _subtract(byte data);
+
+        /// Applies an entry of the decimal mode tables to the accumulator & status register.
+        void _decimal(word entry);
+
+        /// Compares a register with data, setting the carry, zero & negative flags as CMP does.
+        ///
+        /// @param reg  the register value
+        /// @param data the data to compare with
+        void _compare(byte reg, byte data);
+
+        /// Stores data ANDed with the MSB of the base address + 1, as the unstable AHX, SHX, SHY & TAS do.
+        ///
+        /// @param data  the data to store
+        /// @param index the index register added to the base address
+        void _storeHigh(byte data, byte index);
+
 
     // bus access ------------------------------------------------------------------------------------------------------
     private:
 
         /// Convenience function to read a byte from the given address on the bus.
         ///
+        /// This bypasses the virtual `read` so that reads from memory backed pages compile to a page table lookup &
+        /// an indexed load. With a single 64K RAM attached, all reads take this path.
+        ///
         /// @param address the address to read from
         ///
         /// @return a byte of data read from the given address
         byte _read(word address);
 
-        /// Convenience function to write a byte to the given address on the bus.
+        /// Convenience function to write a byte to the given address on the bus. Bypasses the virtual `write`, see
+        /// `_read`.
         ///
         /// @param address the address to write to
         /// @param data    the data byte to write
         void _write(word address, byte data);
 
+        /// Reads the op code of the next instruction. Same as `_readNextByte` but checks for execute watchpoints.
+        byte _fetchOpCode();
+
+        /// Reads a byte from a page that cannot be read directly, checking for read watchpoints.
+        byte _readHooked(word address);
+
+        /// Writes a byte to a page that cannot be written directly, checking for write watchpoints.
+        void _writeHooked(word address, byte data);
+
+        /// Reads the op code of the next instruction from a page that cannot be read directly, checking for read &
+        /// execute watchpoints.
+        byte _fetchOpCodeHooked();
+
         /// Convenience function to read a byte from the address pointed to by the program counter and increment the
         /// program counter.
         ///
@@ -290,58 +759,58 @@ namespace rt_6502_emulator {
         /// Halts the CPU
         bool _inst_KIL();
 
-        /// TBD - Illegal op code
+        /// Shift left memory, then OR with accumulator (ASL + ORA)
         bool _inst_SLO();
 
-        /// TBD - Illegal op code
+        /// Rotate left memory, then AND with accumulator (ROL + AND)
         bool _inst_RLA();
 
-        /// TBD - Illegal op code
+        /// Shift right memory, then exclusive OR with accumulator (LSR + EOR)
         bool _inst_SRE();
 
-        /// TBD - Illegal op code
+        /// Rotate right memory, then add to accumulator with carry (ROR + ADC)
         bool _inst_RRA();
 
-        /// TBD - Illegal op code
+        /// Store accumulator AND index X
         bool _inst_SAX();
 
-        /// TBD - Illegal op code
+        /// Load accumulator & index X with memory (LDA + LDX)
         bool _inst_LAX();
 
-        /// TBD - Illegal op code
+        /// Decrement memory, then compare with accumulator (DEC + CMP)
         bool _inst_DCP();
 
-        /// TBD - Illegal op code
+        /// Increment memory, then subtract from accumulator with borrow (INC + SBC)
         bool _inst_ISC();
 
-        /// TBD - Illegal op code
+        /// AND memory with accumulator, then copy the negative flag to carry
         bool _inst_ANC();
 
-        /// TBD - Illegal op code
+        /// AND memory with accumulator, then shift right accumulator (AND + LSR)
         bool _inst_ALR();
 
-        /// TBD - Illegal op code
+        /// AND memory with accumulator, then rotate right accumulator (AND + ROR) with adder flags
         bool _inst_ARR();
 
-        /// TBD - Illegal op code
+        /// Transfer index X to accumulator, then AND with memory (unstable)
         bool _inst_XAA();
 
-        /// TBD - Illegal op code
+        /// Store accumulator AND index X minus memory in index X, without borrow
         bool _inst_AXS();
 
-        /// TBD - Illegal op code
+        /// Store accumulator AND index X AND high byte of address + 1 (unstable)
         bool _inst_AHX();
 
-        /// TBD - Illegal op code
+        /// Store index Y AND high byte of address + 1 (unstable)
         bool _inst_SHY();
 
-        /// TBD - Illegal op code
+        /// Store index X AND high byte of address + 1 (unstable)
         bool _inst_SHX();
 
-        /// TBD - Illegal op code
+        /// Transfer accumulator AND index X to stack pointer, then store as AHX (unstable)
         bool _inst_TAS();
 
-        /// TBD - Illegal op code
+        /// AND memory with stack pointer & load into accumulator, index X & stack pointer
         bool _inst_LAS();
 
 
@@ -519,18 +988,273 @@ namespace rt_6502_emulator {
     // operations ------------------------------------------------------------------------------------------------------
     private:
 
+        /// Addressing modes. Mirrors the `_addr_*` methods.
+        enum ADDRESSING_MODE {
+            ADDRESSING_IMP, ADDRESSING_ACC, ADDRESSING_IMM, ADDRESSING_ZPG, ADDRESSING_ZPX, ADDRESSING_ZPY,
+            ADDRESSING_REL, ADDRESSING_ABS, ADDRESSING_ABX, ADDRESSING_ABY, ADDRESSING_IND, ADDRESSING_IZX,
+            ADDRESSING_IZY,
+        };
+
+        /// Bus access sequence of an instruction. Used by the cycle accurate core to order the bus accesses.
+        ///
+        /// Instructions following the read, write & read-modify-write sequences must access their operand through
+        /// `_fetch` & `_store` at most once each.
+        enum SEQUENCE {
+            SEQUENCE_READ,                  // reads the operand
+            SEQUENCE_WRITE,                 // writes the operand without reading it
+            SEQUENCE_READ_MODIFY_WRITE,     // reads, writes back unmodified & then writes the result
+            SEQUENCE_BRANCH,
+            SEQUENCE_JMP,
+            SEQUENCE_JSR,
+            SEQUENCE_RTS,
+            SEQUENCE_RTI,
+            SEQUENCE_BRK,
+            SEQUENCE_PUSH,
+            SEQUENCE_PULL,
+            SEQUENCE_KIL,
+        };
+
+        /// Bus access sequence of each instruction. Referenced by name when building the operations table.
+        enum INSTRUCTION_SEQUENCE {
+            SEQUENCE_OF_KIL = SEQUENCE_KIL,
+            SEQUENCE_OF_SLO = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_RLA = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_SRE = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_RRA = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_SAX = SEQUENCE_WRITE,
+            SEQUENCE_OF_LAX = SEQUENCE_READ,
+            SEQUENCE_OF_DCP = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_ISC = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_ANC = SEQUENCE_READ,
+            SEQUENCE_OF_ALR = SEQUENCE_READ,
+            SEQUENCE_OF_ARR = SEQUENCE_READ,
+            SEQUENCE_OF_XAA = SEQUENCE_READ,
+            SEQUENCE_OF_AXS = SEQUENCE_READ,
+            SEQUENCE_OF_AHX = SEQUENCE_WRITE,
+            SEQUENCE_OF_SHY = SEQUENCE_WRITE,
+            SEQUENCE_OF_SHX = SEQUENCE_WRITE,
+            SEQUENCE_OF_TAS = SEQUENCE_WRITE,
+            SEQUENCE_OF_LAS = SEQUENCE_READ,
+
+            SEQUENCE_OF_ADC = SEQUENCE_READ,
+            SEQUENCE_OF_AND = SEQUENCE_READ,
+            SEQUENCE_OF_ASL = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_BCC = SEQUENCE_BRANCH,
+            SEQUENCE_OF_BCS = SEQUENCE_BRANCH,
+            SEQUENCE_OF_BEQ = SEQUENCE_BRANCH,
+            SEQUENCE_OF_BIT = SEQUENCE_READ,
+            SEQUENCE_OF_BMI = SEQUENCE_BRANCH,
+            SEQUENCE_OF_BNE = SEQUENCE_BRANCH,
+            SEQUENCE_OF_BPL = SEQUENCE_BRANCH,
+            SEQUENCE_OF_BRK = SEQUENCE_BRK,
+            SEQUENCE_OF_BVC = SEQUENCE_BRANCH,
+            SEQUENCE_OF_BVS = SEQUENCE_BRANCH,
+            SEQUENCE_OF_CLC = SEQUENCE_READ,
+            SEQUENCE_OF_CLD = SEQUENCE_READ,
+            SEQUENCE_OF_CLI = SEQUENCE_READ,
+            SEQUENCE_OF_CLV = SEQUENCE_READ,
+            SEQUENCE_OF_CMP = SEQUENCE_READ,
+            SEQUENCE_OF_CPX = SEQUENCE_READ,
+            SEQUENCE_OF_CPY = SEQUENCE_READ,
+            SEQUENCE_OF_DEC = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_DEX = SEQUENCE_READ,
+            SEQUENCE_OF_DEY = SEQUENCE_READ,
+            SEQUENCE_OF_EOR = SEQUENCE_READ,
+            SEQUENCE_OF_INC = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_INX = SEQUENCE_READ,
+            SEQUENCE_OF_INY = SEQUENCE_READ,
+            SEQUENCE_OF_JMP = SEQUENCE_JMP,
+            SEQUENCE_OF_JSR = SEQUENCE_JSR,
+            SEQUENCE_OF_LDA = SEQUENCE_READ,
+            SEQUENCE_OF_LDX = SEQUENCE_READ,
+            SEQUENCE_OF_LDY = SEQUENCE_READ,
+            SEQUENCE_OF_LSR = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_NOP = SEQUENCE_READ,
+            SEQUENCE_OF_ORA = SEQUENCE_READ,
+            SEQUENCE_OF_PHA = SEQUENCE_PUSH,
+            SEQUENCE_OF_PHP = SEQUENCE_PUSH,
+            SEQUENCE_OF_PLA = SEQUENCE_PULL,
+            SEQUENCE_OF_PLP = SEQUENCE_PULL,
+            SEQUENCE_OF_ROL = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_ROR = SEQUENCE_READ_MODIFY_WRITE,
+            SEQUENCE_OF_RTI = SEQUENCE_RTI,
+            SEQUENCE_OF_RTS = SEQUENCE_RTS,
+            SEQUENCE_OF_SBC = SEQUENCE_READ,
+            SEQUENCE_OF_SEC = SEQUENCE_READ,
+            SEQUENCE_OF_SED = SEQUENCE_READ,
+            SEQUENCE_OF_SEI = SEQUENCE_READ,
+            SEQUENCE_OF_STA = SEQUENCE_WRITE,
+            SEQUENCE_OF_STX = SEQUENCE_WRITE,
+            SEQUENCE_OF_STY = SEQUENCE_WRITE,
+            SEQUENCE_OF_TAX = SEQUENCE_READ,
+            SEQUENCE_OF_TAY = SEQUENCE_READ,
+            SEQUENCE_OF_TSX = SEQUENCE_READ,
+            SEQUENCE_OF_TXA = SEQUENCE_READ,
+            SEQUENCE_OF_TXS = SEQUENCE_READ,
+            SEQUENCE_OF_TYA = SEQUENCE_READ,
+        };
+
         typedef struct _Operation {
-            byte   code;
-            char   abbr[4];
             bool  (CPU::*inst)();
             bool  (CPU::*addr)();
+            byte   code;
+            char   abbr[4];
             byte   cycles;
+            byte   mode;            // addressing mode
+            byte   sequence;        // bus access sequence of the instruction
         } Operation;
 
-        Operation _operations[256];
-
-        void _initOperations();
+        /// Operations by op code. Built at compile time & shared by all instances.
+        static const Operation _operations[256];
     };
+
+
+    // inline implementations ------------------------------------------------------------------------------------------
+
+    inline byte CPU::_read(word address) {
+
+        // fast path: page is backed directly by a memory device. watched pages never are
+        byte *page = Bus::readPage(address >> 8);
+        if (page) {
+            return page[address & 0xFF];
+        }
+        return _readHooked(address);
+    }
+
+    inline void CPU::_write(word address, byte data) {
+        byte *page = Bus::writePage(address >> 8);
+        if (page) {
+            page[address & 0xFF] = data;
+            return;
+        }
+        _writeHooked(address, data);
+    }
+
+    inline byte CPU::_fetchOpCode() {
+        byte *page = Bus::readPage(_pc >> 8);
+        if (page) {
+            return page[_pc++ & 0xFF];
+        }
+        return _fetchOpCodeHooked();
+    }
+
+    inline void CPU::_traceOperand(byte data) {
+    #ifndef RT_6502_EMULATOR_NO_TRACE
+        _opOperand[_opOperandCount++ & 1] = data;
+    #else
+        (void)data;
+    #endif
+    }
+
+    inline bool CPU::_getStatusFlag(STATUS_FLAG bit) {
+        switch (bit) {
+        case STATUS_FLAG_ZERO:
+            return _zeroResult == 0x00;
+        case STATUS_FLAG_NEGATIVE:
+            return (_negativeResult & 0x80) > 0;
+        case STATUS_FLAG_CARRY:
+            return _carry > 0;
+        case STATUS_FLAG_OVERFLOW:
+            return (_overflow & 0x80) > 0;
+        default:
+            return (_status & bit) > 0 ? 1 : 0;
+        }
+    }
+
+    inline void CPU::_setStatusFlag(STATUS_FLAG bit, bool value) {
+        switch (bit) {
+        case STATUS_FLAG_ZERO:
+            _zeroResult     = value ? 0x00 : 0x01;
+            break;
+        case STATUS_FLAG_NEGATIVE:
+            _negativeResult = value ? 0x80 : 0x00;
+            break;
+        case STATUS_FLAG_CARRY:
+            _carry          = value ? 0x01 : 0x00;
+            break;
+        case STATUS_FLAG_OVERFLOW:
+            _overflow       = value ? 0x80 : 0x00;
+            break;
+        default:
+            if (value) {
+                _status |= bit;
+            }
+            else {
+                _status &= ~bit;
+            }
+            break;
+        }
+    }
+
+    inline void CPU::_setResultStatusFlags(byte data) {
+        _zeroResult     = data;
+        _negativeResult = data;
+    }
+
+    inline byte CPU::_packStatus() {
+        return (_status & ~(STATUS_FLAG_ZERO | STATUS_FLAG_NEGATIVE | STATUS_FLAG_CARRY | STATUS_FLAG_OVERFLOW)) |
+               (_zeroResult == 0x00 ? STATUS_FLAG_ZERO : 0x00) | (_negativeResult & STATUS_FLAG_NEGATIVE) |
+               (_carry & STATUS_FLAG_CARRY) | ((_overflow & 0x80) >> 1);
+    }
+
+    inline void CPU::_unpackStatus(byte status) {
+        _status         = status;
+        _zeroResult     = (status & STATUS_FLAG_ZERO) ? 0x00 : 0x01;
+        _negativeResult = status & STATUS_FLAG_NEGATIVE;
+        _carry          = status & STATUS_FLAG_CARRY;
+        _overflow       = (status & STATUS_FLAG_OVERFLOW) << 1;
+    }
+
+    inline bool CPU::_isInterruptRequested() {
+
+        // a single test in the common case of no interrupt
+        if (_interrupts == 0) {
+            return false;
+        }
+        return (_interrupts & INTERRUPT_NMI_LATCH) || (_status & STATUS_FLAG_DISABLE_INTERRUPTS) == 0;
+    }
+
+    inline void CPU::_dispatchEvents() {
+        if (_cycles >= _scheduler.nextEvent()) {
+            _scheduler.dispatch(_cycles);
+        }
+    }
+
+    inline uint64_t CPU::_cyclesToNextEvent() {
+        uint64_t next = _scheduler.nextEvent();
+        return next > _cycles ? next - _cycles : 0;
+    }
+
+    inline void CPU::_completeDecoded() {
+        _interrupts &= ~INTERRUPT_IRQ_PULSE;
+        _status     |= STATUS_FLAG_UNUSED;
+        _cycles     += _opCycles > 0 ? _opCycles : 1;
+        _opCycles    = 0;
+    }
+
+    inline bool CPU::_canRunTranslated() {
+    #ifndef RT_6502_EMULATOR_NO_TRACE
+        if (_traceRecorder || _profiler) {
+            return false;
+        }
+    #endif
+        return _opCycles == 0 && _cycleStep == 0 && _cycleAccurate == false && _isInterruptRequested() == false;
+    }
+
+
+    // template implementations ----------------------------------------------------------------------------------------
+
+    template <typename Predicate>
+    uint64_t CPU::runUntil(Predicate predicate, uint64_t maxCycles) {
+        uint64_t elapsed = 0;
+        _stopped         = false;
+        while (elapsed < maxCycles && !_halted && !_stopped && !predicate(*this)) {
+            _dispatchEvents();
+            elapsed += _runOperation();
+        }
+        _dispatchEvents();
+        return elapsed;
+    }
 }
 
 #endif // __RT_6502_EMULATOR_CPU_HPP__
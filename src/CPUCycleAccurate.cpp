@@ -0,0 +1,460 @@
+//
+//  CPUCycleAccurate.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include "CPU.hpp"
+
+namespace rt_6502_emulator {
+
+    /* The cycle accurate core performs one bus access per clock tick in the order the 6502 performs them, including
+     * the dummy reads & writes. The instructions themselves are shared with the instruction level core. They are
+     * called on the cycle the 6502 accesses the operand so that `_fetch` & `_store` hit the bus on that cycle.
+     *
+     * SEE: "6510 Instruction Timing" in http://www.atarihq.com/danb/files/64doc.txt
+     */
+
+    // dispatch --------------------------------------------------------------------------------------------------------
+
+    void CPU::_tickCycle() {
+
+        // start the next operation by fetching the op code or starting the interrupt request
+        if (_cycleStep == 0) {
+            _opTargetAcc = false;
+            _opLatched   = false;
+            _opAddress   = 0x0000;
+            _opPC        = _pc;
+        #ifndef RT_6502_EMULATOR_NO_TRACE
+            _opOperandCount = 0;
+        #endif
+
+            if (_isInterruptRequested()) {
+
+                // interrupt requests share the BRK sequence, with the op code fetch replaced by a dummy read
+                _opInterrupt = _acknowledgeInterrupt();
+                _opCode      = 0x00;
+                _read(_pc);
+            }
+            else {
+                _opInterrupt = INTERRUPT_TYPE_NONE;
+                _opCode      = _fetchOpCode();
+            }
+
+            // an IRQ pulse lasts until the next instruction boundary
+            _interrupts &= ~INTERRUPT_IRQ_PULSE;
+
+            // the halt instruction does not do anything beyond the op code fetch
+            const Operation &op = _operations[_opCode];
+            if (op.sequence == SEQUENCE_KIL) {
+                (this->*op.inst)();
+            #ifndef RT_6502_EMULATOR_NO_TRACE
+                if (_traceRecorder) {
+                    _trace(_opPC, _opInterrupt);
+                }
+                if (_profiler) {
+                    _profile(_opPC, _opInterrupt, 1);
+                }
+            #endif
+                return;
+            }
+
+            _cycleStep = 1;
+            return;
+        }
+
+        bool complete;
+        switch (_operations[_opCode].sequence) {
+        case SEQUENCE_BRANCH: complete = _cycleBranch();    break;
+        case SEQUENCE_JMP:    complete = _cycleJMP();       break;
+        case SEQUENCE_JSR:    complete = _cycleJSR();       break;
+        case SEQUENCE_RTS:    complete = _cycleRTS();       break;
+        case SEQUENCE_RTI:    complete = _cycleRTI();       break;
+        case SEQUENCE_BRK:    complete = _cycleInterrupt(); break;
+        case SEQUENCE_PUSH:   complete = _cyclePush();      break;
+        case SEQUENCE_PULL:   complete = _cyclePull();      break;
+        default:              complete = _cycleAddressing(); break;
+        }
+
+        if (complete) {
+
+            // ensure unused flag is always set in the status register
+            _setStatusFlag(STATUS_FLAG_UNUSED, true);
+
+        #ifndef RT_6502_EMULATOR_NO_TRACE
+            if (_traceRecorder) {
+                _trace(_opPC, _opInterrupt);
+            }
+            if (_profiler) {
+                _profile(_opPC, _opInterrupt, _cycleStep + 1);
+            }
+        #endif
+
+            _cycleStep = 0;
+            _opLatched = false;
+        }
+        else {
+            _cycleStep++;
+        }
+    }
+
+
+    // addressing modes ------------------------------------------------------------------------------------------------
+
+    bool CPU::_cycleAddressing() {
+        const Operation &op = _operations[_opCode];
+
+        switch (op.mode) {
+        case ADDRESSING_IMP:
+        case ADDRESSING_ACC:
+
+            // dummy read of the next byte
+            _read(_pc);
+            _opTargetAcc = op.mode == ADDRESSING_ACC;
+            (this->*op.inst)();
+            return true;
+
+        case ADDRESSING_IMM:
+
+            // the operand is latched as it is read, so NOPs read it too
+            _opAddress = _pc;
+            _opData    = _readNextByte();
+            _opLatched = true;
+            (this->*op.inst)();
+            return true;
+
+        case ADDRESSING_ZPG:
+            if (_cycleStep == 1) {
+                _opAddress = _readNextByte();
+                return false;
+            }
+            return _cycleAccess(_cycleStep - 1);
+
+        case ADDRESSING_ZPX:
+        case ADDRESSING_ZPY:
+            switch (_cycleStep) {
+            case 1:
+                _opBase    = _readNextByte();
+                return false;
+            case 2:
+
+                // dummy read from the base address while the index is added
+                _read(_opBase);
+                _opAddress = 0x00FF & (_opBase + (op.mode == ADDRESSING_ZPX ? _idx : _idy));
+                return false;
+            default:
+                return _cycleAccess(_cycleStep - 2);
+            }
+
+        case ADDRESSING_ABS:
+            switch (_cycleStep) {
+            case 1:
+                _opAddress = _readNextByte();
+                return false;
+            case 2:
+                _opAddress |= word(_readNextByte()) << 8;
+                return false;
+            default:
+                return _cycleAccess(_cycleStep - 2);
+            }
+
+        case ADDRESSING_ABX:
+        case ADDRESSING_ABY:
+            switch (_cycleStep) {
+            case 1:
+                _opBase    = _readNextByte();
+                return false;
+            case 2:
+                _opBase   |= word(_readNextByte()) << 8;
+                _opAddress = _opBase + (op.mode == ADDRESSING_ABX ? _idx : _idy);
+                return false;
+            default:
+                return _cycleAccess(_cycleStep - 3);
+            }
+
+        case ADDRESSING_IZX:
+            switch (_cycleStep) {
+            case 1:
+                _opBase    = _readNextByte();
+                return false;
+            case 2:
+
+                // dummy read from the pointer while the index is added
+                _read(_opBase);
+                _opBase    = 0x00FF & (_opBase + _idx);
+                return false;
+            case 3:
+                _opAddress = _read(_opBase);
+                return false;
+            case 4:
+                _opAddress |= word(_read(0x00FF & (_opBase + 1))) << 8;
+                return false;
+            default:
+                return _cycleAccess(_cycleStep - 4);
+            }
+
+        case ADDRESSING_IZY:
+            switch (_cycleStep) {
+            case 1:
+                _opBase    = _readNextByte();
+                return false;
+            case 2:
+                _opAddress = _read(_opBase);
+                return false;
+            case 3:
+                _opBase    = _opAddress | (word(_read(0x00FF & (_opBase + 1))) << 8);
+                _opAddress = _opBase + _idy;
+                return false;
+            default:
+                return _cycleAccess(_cycleStep - 4);
+            }
+
+        default:
+            return true;
+        }
+    }
+
+    bool CPU::_cycleAccess(byte step) {
+        const Operation &op = _operations[_opCode];
+
+        // indexed modes read from the address before the page (MSB) is fixed. if the page was not crossed, read
+        // instructions complete with this read. otherwise it is a dummy read & the access is repeated.
+        if (step == 0) {
+            word address = (_opBase & 0xFF00) | (_opAddress & 0x00FF);
+            if (op.sequence != SEQUENCE_READ || address != _opAddress) {
+                _read(address);
+                return false;
+            }
+        }
+
+        // reads & writes access the target address once. NOPs read it too, ignoring the value
+        if (op.sequence != SEQUENCE_READ_MODIFY_WRITE) {
+            if (op.inst == &CPU::_inst_NOP) {
+                _read(_opAddress);
+            }
+            (this->*op.inst)();
+            return true;
+        }
+
+        // read-modify-write instructions write back the unmodified value while modifying it
+        switch (step) {
+        case 1:
+            _opData    = _read(_opAddress);
+            return false;
+        case 2:
+            _write(_opAddress, _opData);
+            return false;
+        default:
+            _opLatched = true;
+            (this->*op.inst)();
+            return true;
+        }
+    }
+
+
+    // control flow ----------------------------------------------------------------------------------------------------
+
+    bool CPU::_cycleBranch() {
+        const Operation &op = _operations[_opCode];
+
+        switch (_cycleStep) {
+        case 1: {
+
+            // fetch the offset & test the branch condition. see `_addr_REL`
+            word rel   = _readNextByte();
+            if (rel & 0x80) {
+                rel |= 0xFF00;
+            }
+            _opBase    = _pc;
+            _opAddress = _pc + rel;
+
+            // the instruction moves the program counter if the branch is taken. the cycles it accounts for only
+            // apply to the instruction level core.
+            bool taken = (this->*op.inst)();
+            _opCycles  = 0;
+            return taken == false;
+        }
+        case 2:
+
+            // dummy read of the next op code while the offset is added to the LSB of the program counter
+            _read(_opBase);
+            return (_opBase & 0xFF00) == (_opAddress & 0xFF00);
+
+        default:
+
+            // dummy read from the address before the page is fixed
+            _read((_opBase & 0xFF00) | (_opAddress & 0x00FF));
+            return true;
+        }
+    }
+
+    bool CPU::_cycleJMP() {
+        const Operation &op = _operations[_opCode];
+
+        switch (_cycleStep) {
+        case 1:
+            _opBase    = _readNextByte();
+            return false;
+        case 2:
+            _opBase   |= word(_readNextByte()) << 8;
+            if (op.mode == ADDRESSING_ABS) {
+                _opAddress = _opBase;
+                (this->*op.inst)();
+                return true;
+            }
+            return false;
+        case 3:
+            _opData    = _read(_opBase);
+            return false;
+        default:
+
+            // HARDWARE BUG: the MSB is read from the same page. see `_addr_IND`
+            _opAddress = (word(_read((_opBase & 0xFF00) | ((_opBase + 1) & 0x00FF))) << 8) | _opData;
+            (this->*op.inst)();
+            return true;
+        }
+    }
+
+    bool CPU::_cycleJSR() {
+        switch (_cycleStep) {
+        case 1:
+            _opBase    = _readNextByte();
+            return false;
+        case 2:
+
+            // dummy read from the stack
+            _read(0x0100 | _stackP);
+            return false;
+        case 3:
+
+            // the program counter points to the MSB of the target address, which is the return address - 1
+            _pushByte(_pc >> 8);
+            return false;
+        case 4:
+            _pushByte(_pc & 0xFF);
+            return false;
+        default: {
+            byte msb   = _read(_pc);
+            _traceOperand(msb);
+            _pc        = _opBase | (word(msb) << 8);
+            return true;
+        }
+        }
+    }
+
+    bool CPU::_cycleRTS() {
+        switch (_cycleStep) {
+        case 1:
+            _read(_pc);
+            return false;
+        case 2:
+
+            // dummy read from the stack while the stack pointer is incremented
+            _read(0x0100 | _stackP);
+            return false;
+        case 3:
+            _opBase    = _popByte();
+            return false;
+        case 4:
+            _pc        = _opBase | (word(_popByte()) << 8);
+            return false;
+        default:
+
+            // dummy read while the program counter is incremented past the JSR
+            _read(_pc++);
+            return true;
+        }
+    }
+
+    bool CPU::_cycleRTI() {
+        switch (_cycleStep) {
+        case 1:
+            _read(_pc);
+            return false;
+        case 2:
+            _read(0x0100 | _stackP);
+            return false;
+        case 3:
+            _unpackStatus(_popByte() & ~STATUS_FLAG_BREAK);
+            return false;
+        case 4:
+            _opBase    = _popByte();
+            return false;
+        default:
+            _pc        = _opBase | (word(_popByte()) << 8);
+            return true;
+        }
+    }
+
+    bool CPU::_cycleInterrupt() {
+        switch (_cycleStep) {
+        case 1:
+
+            // BRK skips its padding byte, interrupt requests do not move the program counter
+            if (_opInterrupt == INTERRUPT_TYPE_NONE) {
+                _readNextByte();
+            }
+            else {
+                _read(_pc);
+            }
+            return false;
+        case 2:
+            _pushByte(_pc >> 8);
+            return false;
+        case 3:
+            _pushByte(_pc & 0xFF);
+            return false;
+        case 4:
+
+            // the BREAK status is only pushed by BRK
+            _pushByte(_opInterrupt == INTERRUPT_TYPE_NONE
+                ? _packStatus() | STATUS_FLAG_BREAK
+                : _packStatus() & ~STATUS_FLAG_BREAK);
+            return false;
+        case 5:
+            _opBase    = _opInterrupt == INTERRUPT_TYPE_NON_MASKABLE ? 0xFFFA : 0xFFFE;
+            _opData    = _read(_opBase);
+            _setStatusFlag(STATUS_FLAG_DISABLE_INTERRUPTS, true);
+            return false;
+        default:
+            _pc        = _opData | (word(_read(_opBase + 1)) << 8);
+            return true;
+        }
+    }
+
+
+    // stack -----------------------------------------------------------------------------------------------------------
+
+    bool CPU::_cyclePush() {
+        const Operation &op = _operations[_opCode];
+
+        switch (_cycleStep) {
+        case 1:
+            _read(_pc);
+            return false;
+        default:
+            (this->*op.inst)();
+            return true;
+        }
+    }
+
+    bool CPU::_cyclePull() {
+        const Operation &op = _operations[_opCode];
+
+        switch (_cycleStep) {
+        case 1:
+            _read(_pc);
+            return false;
+        case 2:
+
+            // dummy read from the stack while the stack pointer is incremented
+            _read(0x0100 | _stackP);
+            return false;
+        default:
+            (this->*op.inst)();
+            return true;
+        }
+    }
+}
@@ -9,7 +9,9 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include "Memory.hpp"
+#include "Snapshot.hpp"
 
 namespace rt_6502_emulator {
 
@@ -24,31 +26,48 @@ namespace rt_6502_emulator {
         _isWritable   = isWritable;
         _addressStart = addressStart;
         _addressEnd   = addressEnd;
-
-        // allocate memory
-        word size     = _addressEnd - _addressStart + 1;
-        _contents     = (byte *)malloc(size);
-        assert(_contents);
+        _firstPage    = addressStart >> 8;
+
+        // allocate zeroed pages
+        std::size_t count = (addressEnd >> 8) - _firstPage + 1;
+        for (std::size_t i = 0; i < count; i++) {
+            Page *page = new Page();
+            page->references.store(1, std::memory_order_relaxed);
+            memset(page->contents, 0, sizeof(page->contents));
+            _pages.push_back(page);
+        }
+        _shared.assign(count, false);
     }
 
-    Memory::Memory(const Memory &orig) {
+    Memory::Memory(const Memory &orig): Addressable() {
 
         // initialize
         _isWritable   = orig._isWritable;
         _addressStart = orig._addressStart;
         _addressEnd   = orig._addressEnd;
+        _firstPage    = orig._firstPage;
 
-        // allocate memory
-        word size     = _addressEnd - _addressStart + 1;
-        _contents     = (byte *)malloc(size);
-        assert(_contents);
-
-        // copy contents
-        memcpy(_contents, orig._contents, size);
+        // share the pages of the original
+        _pages        = orig._pages;
+        for (Page *page : _pages) {
+            page->references.fetch_add(1, std::memory_order_relaxed);
+        }
+        _shared.assign(_pages.size(), true);
+
+        // the original can no longer write its pages directly either
+        Memory &original = const_cast<Memory &>(orig);
+        for (std::size_t i = 0; i < _pages.size(); i++) {
+            if (original._shared[i] == false) {
+                original._shared[i] = true;
+                original._pageChanged(byte(_firstPage + i));
+            }
+        }
     }
 
     Memory::~Memory() {
-        free(_contents);
+        for (Page *page : _pages) {
+            _release(page);
+        }
     }
 
 
@@ -62,21 +81,32 @@ namespace rt_6502_emulator {
 
     // load ------------------------------------------------------------------------------------------------------------
 
-    bool Memory::load(byte *buffer, word address, word length) {
+    bool Memory::load(const byte *buffer, word address, word length) {
         assert(address >= _addressStart && address <= _addressEnd);
-        assert((__UINT32_TYPE__)address + (__UINT32_TYPE__)length <= (__UINT32_TYPE__)_addressEnd);
-        word offset = address - _addressStart;
-        memcpy(_contents + offset, buffer, length);
+        assert((__UINT32_TYPE__)address + (__UINT32_TYPE__)length <= (__UINT32_TYPE__)_addressEnd + 1);
+
+        _store(address, buffer, length);
         return true;
     }
 
+    void Memory::_store(word address, const byte *buffer, size_t length) {
+
+        // copy page by page, unsharing the pages written to
+        size_t end = size_t(address) + length;
+        for (size_t current = address; current < end; ) {
+            size_t size = std::min<size_t>(end - current, 0x0100 - (current & 0x00FF));
+            memcpy(_writablePage(word(current))->contents + (current & 0x00FF), buffer, size);
+            buffer  += size;
+            current += size;
+        }
+    }
+
 
     // read / write ----------------------------------------------------------------------------------------------------
 
     bool Memory::read(word address, byte &data) {
         if (address >= _addressStart && address <= _addressEnd) {
-            word offset = address - _addressStart;
-            data = _contents[offset];
+            data = _page(address)->contents[address & 0x00FF];
             return true;
         }
         return false;
@@ -84,10 +114,132 @@ namespace rt_6502_emulator {
 
     bool Memory::write(word address, byte data) {
         if (_isWritable && address >= _addressStart && address <= _addressEnd) {
-            word offset = address - _addressStart;
-            _contents[offset] = data;
+            _writablePage(address)->contents[address & 0x00FF] = data;
             return true;
         }
         return false;
     }
+
+
+    // block access ----------------------------------------------------------------------------------------------------
+
+    bool Memory::readBlock(word address, byte *buffer, size_t length) {
+        assert(size_t(address) + length <= 0x10000);
+
+        // clip the block to the memory address space
+        size_t end   = size_t(address) + length;
+        size_t first = std::max<size_t>(address, _addressStart);
+        size_t last  = std::min<size_t>(end, size_t(_addressEnd) + 1);
+        if (first >= last) {
+            memset(buffer, 0x00, length);
+            return length == 0;
+        }
+        memset(buffer, 0x00, first - address);
+        memset(buffer + (last - address), 0x00, end - last);
+
+        // copy page by page
+        for (size_t current = first; current < last; ) {
+            size_t size = std::min<size_t>(last - current, 0x0100 - (current & 0x00FF));
+            memcpy(buffer + (current - address), _page(word(current))->contents + (current & 0x00FF), size);
+            current += size;
+        }
+        return first == address && last == end;
+    }
+
+    bool Memory::writeBlock(word address, const byte *buffer, size_t length) {
+        assert(size_t(address) + length <= 0x10000);
+        if (_isWritable == false) {
+            return length == 0;
+        }
+
+        // clip the block to the memory address space
+        size_t end   = size_t(address) + length;
+        size_t first = std::max<size_t>(address, _addressStart);
+        size_t last  = std::min<size_t>(end, size_t(_addressEnd) + 1);
+        if (first >= last) {
+            return length == 0;
+        }
+        _store(word(first), buffer + (first - address), last - first);
+        return first == address && last == end;
+    }
+
+
+    // direct page access ----------------------------------------------------------------------------------------------
+
+    byte *Memory::readPage(byte page) {
+        word start = word(page) << 8;
+        word end   = start | 0x00FF;
+        if (start >= _addressStart && end <= _addressEnd) {
+            return _page(start)->contents;
+        }
+        return nullptr;
+    }
+
+    byte *Memory::writePage(byte page) {
+        return _isWritable && _shared[page - _firstPage] == false ? readPage(page) : nullptr;
+    }
+
+
+    // snapshot --------------------------------------------------------------------------------------------------------
+
+    void Memory::save(Snapshot &snapshot) {
+        uint32_t size = uint32_t(_addressEnd) - _addressStart + 1;
+        snapshot.appendUInt32(size);
+        for (uint32_t address = _addressStart; address <= _addressEnd; ) {
+            uint32_t length = std::min<uint32_t>(_addressEnd - address + 1, 0x0100 - (address & 0x00FF));
+            snapshot.appendBytes(_page(word(address))->contents + (address & 0x00FF), length);
+            address += length;
+        }
+    }
+
+    bool Memory::restore(const Snapshot &snapshot, size_t &offset) {
+        uint32_t size;
+        if (snapshot.readUInt32(offset, size) == false || size != uint32_t(_addressEnd) - _addressStart + 1) {
+            return false;
+        }
+        for (uint32_t address = _addressStart; address <= _addressEnd; ) {
+            uint32_t length = std::min<uint32_t>(_addressEnd - address + 1, 0x0100 - (address & 0x00FF));
+            if (snapshot.readBytes(offset, _writablePage(word(address))->contents + (address & 0x00FF),
+                                   length) == false) {
+                return false;
+            }
+            address += length;
+        }
+        return true;
+    }
+
+
+    // pages -----------------------------------------------------------------------------------------------------------
+
+    Memory::Page *Memory::_page(word address) {
+        return _pages[(address >> 8) - _firstPage];
+    }
+
+    Memory::Page *Memory::_writablePage(word address) {
+        std::size_t index = (address >> 8) - _firstPage;
+        if (_shared[index] == false) {
+            return _pages[index];
+        }
+
+        // copy the page unless the other memories sharing it have since let go of it
+        Page *page = _pages[index];
+        if (page->references.load(std::memory_order_acquire) > 1) {
+            Page *copy = new Page();
+            copy->references.store(1, std::memory_order_relaxed);
+            memcpy(copy->contents, page->contents, sizeof(copy->contents));
+            _pages[index] = copy;
+            _release(page);
+        }
+
+        // the page can now be written directly
+        _shared[index] = false;
+        _pageChanged(byte(address >> 8));
+        return _pages[index];
+    }
+
+    void Memory::_release(Page *page) {
+        if (page->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete page;
+        }
+    }
 }
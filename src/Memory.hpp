@@ -9,23 +9,32 @@
 #ifndef __RT_6502_EMULATOR_MEMORY_HPP__
 #define __RT_6502_EMULATOR_MEMORY_HPP__
 
+#include <atomic>
+#include <vector>
 #include "types.hpp"
 #include "Addressable.hpp"
 
 namespace rt_6502_emulator {
 
     // Memory peripheral that can be attached to the bus to be used either as RAM or ROM.
+    //
+    // The contents are stored in 256 byte pages aligned to the pages of the address space. Copies share their pages
+    // with the original until either of them writes to a page, at which point the writer gets its own copy of that
+    // page. This makes forking a machine cheap no matter how much memory it has.
     class Memory: public Addressable {
     public:
 
-        /// Constructs a RAM or ROM memory module with the given address range.
+        /// Constructs a RAM or ROM memory module with the given address range. The contents are zeroed.
         ///
         /// @param isWritable   initializes as a ROM module if `true` or as RAM otherwise
         /// @param addressStart start range of address at which to map the memory
         /// @param addressEnd   end range of address at which to map the memory
         Memory(bool isWritable, word addressStart, word addressEnd);
 
-        /// Copy constructor
+        /// Copy constructor. The copy shares the pages of the original until either of them writes to them.
+        ///
+        /// The original is marked as sharing its pages, so the copy must not be made while the original is in use
+        /// by another thread. Once made, the copy & the original can be used from different threads.
         Memory(const Memory &orig);
 
         /// Destructor
@@ -52,7 +61,7 @@ namespace rt_6502_emulator {
         /// @param length  number of bytes to copy
         ///
         /// @returns `true` if data copied successfully
-        bool load(byte *buffer, word address, word length);
+        bool load(const byte *buffer, word address, word length);
 
 
         /// Read a byte from the memory address space.
@@ -71,12 +80,59 @@ namespace rt_6502_emulator {
         /// @param data    the data byte to write
         virtual bool write(word address, byte data);
 
+
+        /// Returns a pointer to the given page if it lies entirely within the memory address space.
+        virtual byte *readPage(byte page);
+
+        /// Returns a pointer to the given page if it lies entirely within the memory address space, the memory is
+        /// configured as RAM & the page is not shared with a copy.
+        virtual byte *writePage(byte page);
+
+
+        /// Reads a block of bytes from the memory address space, copying page by page. Bytes outside the memory
+        /// address space are set to 0x00. See `Addressable::readBlock`.
+        virtual bool readBlock(word address, byte *buffer, size_t length);
+
+        /// Writes a block of bytes to the memory address space, copying page by page. Shared pages are copied first
+        /// as for `write`. If configured as a ROM, this function is a no-op. See `Addressable::writeBlock`.
+        virtual bool writeBlock(word address, const byte *buffer, size_t length);
+
+
+        /// Appends the size & contents of the memory to the given snapshot.
+        virtual void save(Snapshot &snapshot);
+
+        /// Restores the contents of the memory from the given snapshot. Fails if the snapshot was saved from a
+        /// memory of a different size. ROM contents are restored as well.
+        virtual bool restore(const Snapshot &snapshot, size_t &offset);
+
     private:
 
-        bool   _isWritable;
-        word   _addressStart;
-        word   _addressEnd;
-        byte  *_contents;
+        /// A reference counted page of the contents
+        typedef struct _Page {
+            std::atomic<uint32_t> references;
+            byte                  contents[256];
+        } Page;
+
+        bool                _isWritable;
+        word                _addressStart;
+        word                _addressEnd;
+        byte                _firstPage;     // page of the address space the first page of contents maps to
+        std::vector<Page *> _pages;         // pages of the contents, from `_firstPage` onwards
+        std::vector<bool>   _shared;        // set for pages that may be shared with a copy
+
+        /// Gets the page of the contents the given address maps to.
+        Page *_page(word address);
+
+        /// Gets the page of the contents the given address maps to for writing. If the page is shared, it is
+        /// replaced by a copy owned by this memory first.
+        Page *_writablePage(word address);
+
+        /// Copies the given data into the memory address space, which must hold the whole block, regardless of
+        /// whether configured as ROM.
+        void _store(word address, const byte *buffer, size_t length);
+
+        /// Releases a reference to the given page, deleting it if it was the last one.
+        static void _release(Page *page);
     };
 }
 
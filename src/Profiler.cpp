@@ -0,0 +1,211 @@
+//
+//  Profiler.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <string.h>
+#include <algorithm>
+#include "Profiler.hpp"
+
+namespace rt_6502_emulator {
+
+    /// Instruction names by op code
+    static const char *PROFILER_INSTRUCTIONS[256] = {
+        #define CPU_OP(code, inst, addr, cycles) #inst,
+        #include "CPUOperations.def"
+        #undef CPU_OP
+    };
+
+    /// Op codes that change the call stack
+    static const byte OP_BRK = 0x00;
+    static const byte OP_JSR = 0x20;
+    static const byte OP_RTI = 0x40;
+    static const byte OP_RTS = 0x60;
+
+    /// Deepest call stack tracked. Deeper calls are attributed to the deepest frame & only counted, so that their
+    /// returns do not leave it. This bounds the tree of call stacks for guest code that calls without returning.
+    static const std::size_t PROFILER_DEPTH_MAX = 256;
+
+
+    // constructors & destructor ---------------------------------------------------------------------------------------
+
+    Profiler::Profiler() {
+        clear();
+    }
+
+    Profiler::~Profiler() {}
+
+
+    // record ----------------------------------------------------------------------------------------------------------
+
+    void Profiler::record(word pc, word next, byte opCode, byte interruptType, byte cycles, bool pageCrossed) {
+        _frames[_frame].cycles += cycles;
+
+        // interrupts are not instructions, they only enter the handler
+        if (interruptType) {
+            _interrupts++;
+            _interruptCycles += cycles;
+            _call(next, true);
+            return;
+        }
+
+        _opCodeExecutions[opCode]++;
+        _opCodeCycles[opCode]        += cycles;
+        _opCodePageCrossings[opCode] += pageCrossed;
+        _addressExecutions[pc]++;
+        _addressCycles[pc]           += cycles;
+
+        switch (opCode) {
+        case OP_JSR: _call(next, false); break;
+        case OP_BRK: _call(next, true);  break;
+        case OP_RTS:
+        case OP_RTI: _return();          break;
+        }
+    }
+
+    void Profiler::clear() {
+        memset(_opCodeExecutions,    0, sizeof(_opCodeExecutions));
+        memset(_opCodeCycles,        0, sizeof(_opCodeCycles));
+        memset(_opCodePageCrossings, 0, sizeof(_opCodePageCrossings));
+        _interrupts      = 0;
+        _interruptCycles = 0;
+        _addressExecutions.assign(0x10000, 0);
+        _addressCycles.assign(0x10000, 0);
+
+        _frames.clear();
+        _frames.push_back(Frame());
+        _frames[0].parent    = 0;
+        _frames[0].address   = 0x0000;
+        _frames[0].interrupt = false;
+        _frames[0].cycles    = 0;
+        _frame   = 0;
+        _depth   = 0;
+        _dropped = 0;
+    }
+
+
+    // accessors -------------------------------------------------------------------------------------------------------
+
+    uint64_t Profiler::getOpCodeExecutions(byte opCode)    { return _opCodeExecutions[opCode]; }
+    uint64_t Profiler::getOpCodeCycles(byte opCode)        { return _opCodeCycles[opCode]; }
+    uint64_t Profiler::getOpCodePageCrossings(byte opCode) { return _opCodePageCrossings[opCode]; }
+    uint64_t Profiler::getAddressExecutions(word address)  { return _addressExecutions[address]; }
+    uint64_t Profiler::getAddressCycles(word address)      { return _addressCycles[address]; }
+    uint64_t Profiler::getInterrupts()                     { return _interrupts; }
+    uint64_t Profiler::getInterruptCycles()                { return _interruptCycles; }
+
+
+    // call stack ------------------------------------------------------------------------------------------------------
+
+    void Profiler::_call(word address, bool interrupt) {
+        if (_depth >= PROFILER_DEPTH_MAX) {
+            _dropped++;
+            return;
+        }
+
+        // reuse the frame if this call stack was seen before
+        uint32_t key = (uint32_t(interrupt) << 16) | address;
+        std::unordered_map<uint32_t, std::size_t>::iterator it = _frames[_frame].callees.find(key);
+        if (it != _frames[_frame].callees.end()) {
+            _frame = it->second;
+        }
+        else {
+            Frame frame;
+            frame.parent    = _frame;
+            frame.address   = address;
+            frame.interrupt = interrupt;
+            frame.cycles    = 0;
+            _frames.push_back(frame);
+            _frames[_frame].callees[key] = _frames.size() - 1;
+            _frame = _frames.size() - 1;
+        }
+        _depth++;
+    }
+
+    void Profiler::_return() {
+
+        // returns without a matching call (eg. from code running before profiling started) stay in the root
+        if (_dropped > 0) {
+            _dropped--;
+        }
+        else if (_depth > 0) {
+            _frame = _frames[_frame].parent;
+            _depth--;
+        }
+    }
+
+
+    // output ----------------------------------------------------------------------------------------------------------
+
+    void Profiler::writeFlat(FILE *stream, std::size_t addresses) {
+        uint64_t total = _interruptCycles;
+        for (std::size_t i = 0; i < 256; i++) {
+            total += _opCodeCycles[i];
+        }
+
+        // op codes by cycles
+        std::vector<std::size_t> opCodes;
+        for (std::size_t i = 0; i < 256; i++) {
+            if (_opCodeExecutions[i] > 0) {
+                opCodes.push_back(i);
+            }
+        }
+        std::stable_sort(opCodes.begin(), opCodes.end(), [this](std::size_t a, std::size_t b) {
+            return _opCodeCycles[a] > _opCodeCycles[b];
+        });
+
+        fprintf(stream, "%-10s %16s %16s %7s %16s\n", "op code", "executions", "cycles", "%", "page crossings");
+        for (std::size_t opCode : opCodes) {
+            fprintf(stream, "$%02zX %-6s %16llu %16llu %6.2f%% %16llu\n", opCode, PROFILER_INSTRUCTIONS[opCode],
+                    (unsigned long long)_opCodeExecutions[opCode], (unsigned long long)_opCodeCycles[opCode],
+                    total ? 100.0 * _opCodeCycles[opCode] / total : 0.0,
+                    (unsigned long long)_opCodePageCrossings[opCode]);
+        }
+        if (_interrupts > 0) {
+            fprintf(stream, "%-10s %16llu %16llu %6.2f%%\n", "interrupts", (unsigned long long)_interrupts,
+                    (unsigned long long)_interruptCycles, total ? 100.0 * _interruptCycles / total : 0.0);
+        }
+
+        // hottest addresses
+        std::vector<std::size_t> hottest;
+        for (std::size_t i = 0; i < 0x10000; i++) {
+            if (_addressExecutions[i] > 0) {
+                hottest.push_back(i);
+            }
+        }
+        std::size_t count = std::min(addresses, hottest.size());
+        std::partial_sort(hottest.begin(), hottest.begin() + count, hottest.end(), [this](std::size_t a, std::size_t b) {
+            return _addressCycles[a] > _addressCycles[b] || (_addressCycles[a] == _addressCycles[b] && a < b);
+        });
+
+        fprintf(stream, "\n%-10s %16s %16s %7s\n", "address", "executions", "cycles", "%");
+        for (std::size_t i = 0; i < count; i++) {
+            std::size_t address = hottest[i];
+            fprintf(stream, "$%04zX      %16llu %16llu %6.2f%%\n", address,
+                    (unsigned long long)_addressExecutions[address], (unsigned long long)_addressCycles[address],
+                    total ? 100.0 * _addressCycles[address] / total : 0.0);
+        }
+    }
+
+    void Profiler::writeFolded(FILE *stream) {
+        for (std::size_t i = 0; i < _frames.size(); i++) {
+            if (_frames[i].cycles > 0) {
+                _writeStack(stream, i);
+                fprintf(stream, " %llu\n", (unsigned long long)_frames[i].cycles);
+            }
+        }
+    }
+
+    void Profiler::_writeStack(FILE *stream, std::size_t frame) {
+        if (frame == 0) {
+            fprintf(stream, "root");
+            return;
+        }
+
+        _writeStack(stream, _frames[frame].parent);
+        fprintf(stream, _frames[frame].interrupt ? ";interrupt@$%04X" : ";$%04X", _frames[frame].address);
+    }
+}
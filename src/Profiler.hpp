@@ -0,0 +1,124 @@
+//
+//  Profiler.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_PROFILER_HPP__
+#define __RT_6502_EMULATOR_PROFILER_HPP__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <unordered_map>
+#include <vector>
+#include "types.hpp"
+
+namespace rt_6502_emulator {
+
+    /// Profiles the guest code run by the CPU. See `CPU::setProfiler`.
+    ///
+    /// Counts the executions & clock cycles of every op code & of every instruction address, along with the page
+    /// crossing penalties taken by each op code. Also tracks the guest call stack by following JSR / RTS & interrupts
+    /// / RTI, and attributes the cycles of every operation to the stack it ran in.
+    ///
+    /// The results can be written as a flat profile or in the folded stack format used by flame graph tools (eg.
+    /// `flamegraph.pl`), with one line per call stack: the subroutine addresses separated by `;` & the cycles.
+    ///
+    /// Guest code that returns with RTS to an address it pushed itself (eg. jump tables) is seen as a return, so
+    /// the call stacks of such code are approximate.
+    class Profiler {
+    public:
+
+        /// Constructs a profiler with all counts cleared.
+        Profiler();
+
+        /// Destructor
+        ~Profiler();
+
+
+        /// Records a completed operation.
+        ///
+        /// @param pc            address of the instruction, or of the next one for interrupts
+        /// @param next          program counter after the operation
+        /// @param opCode        op code of the instruction
+        /// @param interruptType `CPU::INTERRUPT_TYPE` of the interrupt serviced, 0 for instructions
+        /// @param cycles        clock cycles taken by the operation
+        /// @param pageCrossed   `true` if the operation took a page crossing penalty
+        void record(word pc, word next, byte opCode, byte interruptType, byte cycles, bool pageCrossed);
+
+        /// Clears all counts & the call stack.
+        void clear();
+
+
+        /// Number of times the given op code was executed.
+        uint64_t getOpCodeExecutions(byte opCode);
+
+        /// Clock cycles taken by the given op code, including penalties.
+        uint64_t getOpCodeCycles(byte opCode);
+
+        /// Number of times the given op code took a page crossing penalty.
+        uint64_t getOpCodePageCrossings(byte opCode);
+
+        /// Number of times the instruction at the given address was executed.
+        uint64_t getAddressExecutions(word address);
+
+        /// Clock cycles taken by the instructions at the given address.
+        uint64_t getAddressCycles(word address);
+
+        /// Number of interrupts serviced.
+        uint64_t getInterrupts();
+
+        /// Clock cycles taken to service interrupts, excluding the handlers.
+        uint64_t getInterruptCycles();
+
+
+        /// Writes the flat profile as text: the op codes by cycles, then the hottest instruction addresses.
+        ///
+        /// @param stream    the file to write to
+        /// @param addresses the maximum number of instruction addresses to list
+        void writeFlat(FILE *stream, std::size_t addresses = 32);
+
+        /// Writes the cycles per call stack in the folded stack format. Frames are named after the address of the
+        /// subroutine (`$0400`) or interrupt handler (`interrupt@$0400`). The outermost frame is `root`.
+        ///
+        /// @param stream the file to write to
+        void writeFolded(FILE *stream);
+
+    private:
+
+        /// A call stack, stored as a node in the tree of all call stacks seen.
+        typedef struct _Frame {
+            std::size_t                               parent;     // index of the calling frame
+            word                                      address;    // address of the subroutine or handler
+            bool                                      interrupt;  // `true` for interrupt handlers
+            uint64_t                                  cycles;     // cycles run in this frame, excluding callees
+            std::unordered_map<uint32_t, std::size_t> callees;    // frames called from this one, by address
+        } Frame;
+
+        uint64_t              _opCodeExecutions[256];
+        uint64_t              _opCodeCycles[256];
+        uint64_t              _opCodePageCrossings[256];
+        uint64_t              _interrupts;
+        uint64_t              _interruptCycles;
+        std::vector<uint64_t> _addressExecutions;   // by instruction address
+        std::vector<uint64_t> _addressCycles;       // by instruction address
+
+        std::vector<Frame>    _frames;              // tree of call stacks. the root is at index 0
+        std::size_t           _frame;               // current call stack
+        std::size_t           _depth;               // depth of the current call stack
+        std::size_t           _dropped;             // calls past the deepest call stack tracked, not yet returned
+
+        /// Enters the subroutine or handler at the given address.
+        void _call(word address, bool interrupt);
+
+        /// Returns from the current subroutine or handler.
+        void _return();
+
+        /// Writes the names of the frames from the root to the given frame.
+        void _writeStack(FILE *stream, std::size_t frame);
+    };
+}
+
+#endif // __RT_6502_EMULATOR_PROFILER_HPP__
@@ -0,0 +1,138 @@
+//
+//  ROM.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <assert.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <utility>
+#include "ROM.hpp"
+
+namespace rt_6502_emulator {
+
+    // mapped images ---------------------------------------------------------------------------------------------------
+
+    /// Images mapped so far, by device & inode so that every path to a file shares the mapping.
+    static std::mutex                                                          _imagesMutex;
+    static std::map<std::pair<dev_t, ino_t>, std::weak_ptr<MappedImage> >      _images;
+
+    std::shared_ptr<MappedImage> MappedImage::map(const std::string &path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            close(fd);
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(_imagesMutex);
+
+        // share an existing mapping of the file
+        std::pair<dev_t, ino_t>      key(info.st_dev, info.st_ino);
+        std::shared_ptr<MappedImage> image = _images[key].lock();
+        if (image) {
+            close(fd);
+            return image;
+        }
+
+        // the mapping stays valid once the file is closed
+        void *data = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            return nullptr;
+        }
+
+        // drop the entries of images unmapped since, so that only mapped images are kept track of
+        for (auto it = _images.begin(); it != _images.end();) {
+            it = it->second.expired() ? _images.erase(it) : std::next(it);
+        }
+
+        image = std::shared_ptr<MappedImage>(new MappedImage((byte *)data, size_t(info.st_size)));
+        _images[key] = image;
+        return image;
+    }
+
+    MappedImage::MappedImage(byte *data, size_t size) {
+        _data = data;
+        _size = size;
+    }
+
+    MappedImage::~MappedImage() {
+        munmap(_data, _size);
+    }
+
+    const byte *MappedImage::data() { return _data; }
+    size_t MappedImage::size()      { return _size; }
+
+
+    // constructors & destructor ---------------------------------------------------------------------------------------
+
+    ROM::ROM(std::shared_ptr<MappedImage> image, word addressStart, word addressEnd) {
+        assert(image && addressEnd >= addressStart);
+
+        _image        = image;
+        _addressStart = addressStart;
+        _addressEnd   = word(std::min<size_t>(addressEnd, addressStart + image->size() - 1));
+    }
+
+    ROM::~ROM() {}
+
+    std::shared_ptr<ROM> ROM::map(const std::string &path, word addressStart, word addressEnd) {
+        std::shared_ptr<MappedImage> image = MappedImage::map(path);
+        return image ? std::make_shared<ROM>(image, addressStart, addressEnd) : nullptr;
+    }
+
+
+    // accessors -------------------------------------------------------------------------------------------------------
+
+    bool ROM::isReadable()   { return true; }
+    bool ROM::isWritable()   { return false; }
+    word ROM::addressStart() { return _addressStart; }
+    word ROM::addressEnd()   { return _addressEnd; }
+
+    std::shared_ptr<MappedImage> ROM::getImage() {
+        return _image;
+    }
+
+
+    // read / write ----------------------------------------------------------------------------------------------------
+
+    bool ROM::read(word address, byte &data) {
+        if (address >= _addressStart && address <= _addressEnd) {
+            data = _image->data()[address - _addressStart];
+            return true;
+        }
+        return false;
+    }
+
+    bool ROM::write(word address, byte data) {
+        return false;
+    }
+
+
+    // direct page access ----------------------------------------------------------------------------------------------
+
+    byte *ROM::readPage(byte page) {
+        word start = word(page) << 8;
+        word end   = start | 0x00FF;
+        if (start >= _addressStart && end <= _addressEnd) {
+
+            // the bus only reads through the pointer, the mapping is read only
+            return const_cast<byte *>(_image->data()) + (start - _addressStart);
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,113 @@
+//
+//  ROM.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_ROM_HPP__
+#define __RT_6502_EMULATOR_ROM_HPP__
+
+#include <stddef.h>
+#include <memory>
+#include <string>
+#include "types.hpp"
+#include "Addressable.hpp"
+
+namespace rt_6502_emulator {
+
+    /// An image file mapped read only into memory.
+    ///
+    /// The file is mapped with `mmap` & never copied, so its pages are loaded on demand & shared with every other
+    /// mapping of the file, including those of other processes. Mapping a file that is already mapped returns the
+    /// existing mapping. The file is unmapped once the last reference to it is released.
+    class MappedImage {
+    public:
+
+        /// Maps the given image file. Thread safe.
+        ///
+        /// @param path path of the file to map
+        ///
+        /// @returns the mapping or `nullptr` if the file cannot be opened or mapped, or is empty
+        static std::shared_ptr<MappedImage> map(const std::string &path);
+
+        /// Destructor. Unmaps the file.
+        ~MappedImage();
+
+        /// Gets the contents of the file.
+        const byte *data();
+
+        /// Gets the size of the file in bytes.
+        size_t size();
+
+    private:
+
+        byte   *_data;
+        size_t  _size;
+
+        MappedImage(byte *data, size_t size);
+        MappedImage(const MappedImage &orig) = delete;
+        MappedImage &operator=(const MappedImage &orig) = delete;
+    };
+
+
+    /// ROM peripheral backed directly by a mapped image file.
+    ///
+    /// Unlike a `Memory` configured as ROM, the contents are neither allocated nor copied: the bus reads straight
+    /// from the mapped file. Any number of ROMs, in any number of machines, can share a single mapping.
+    class ROM: public Addressable {
+    public:
+
+        /// Constructs a ROM mapping the given image at the given address. The address range is clipped to the size
+        /// of the image.
+        ///
+        /// @param image        the image to map
+        /// @param addressStart start range of address at which to map the image
+        /// @param addressEnd   end range of address at which to map the image
+        ROM(std::shared_ptr<MappedImage> image, word addressStart, word addressEnd = 0xFFFF);
+
+        /// Destructor
+        ~ROM();
+
+        /// Convenience method to map the given image file & construct a ROM with it.
+        ///
+        /// @returns the ROM or `nullptr` if the file could not be mapped
+        static std::shared_ptr<ROM> map(const std::string &path, word addressStart, word addressEnd = 0xFFFF);
+
+
+        /// Returns `true` always.
+        virtual bool isReadable();
+
+        /// Returns `false` always.
+        virtual bool isWritable();
+
+        /// Start range of the ROM address space.
+        virtual word addressStart();
+
+        /// End range of the ROM address space.
+        virtual word addressEnd();
+
+        /// Read a byte from the ROM address space.
+        virtual bool read(word address, byte &data);
+
+        /// Writes are ignored.
+        ///
+        /// @returns `false` always
+        virtual bool write(word address, byte data);
+
+        /// Returns a pointer into the mapped image if the given page lies entirely within the ROM address space.
+        virtual byte *readPage(byte page);
+
+        /// Gets the mapped image.
+        std::shared_ptr<MappedImage> getImage();
+
+    private:
+
+        std::shared_ptr<MappedImage> _image;
+        word                         _addressStart;
+        word                         _addressEnd;
+    };
+}
+
+#endif // __RT_6502_EMULATOR_ROM_HPP__
@@ -0,0 +1,1161 @@
+//
+//  Recompiler.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+#include <initializer_list>
+#include "Recompiler.hpp"
+#include "CPU.hpp"
+
+#if defined(__x86_64__) && (defined(__unix__) || defined(__APPLE__))
+#define RT_6502_EMULATOR_RECOMPILER_HOST
+#include <sys/mman.h>
+#endif
+
+namespace rt_6502_emulator {
+
+    /// Size of the code cache. The cache is flushed once full.
+    static const size_t   CACHE_SIZE       = 4 * 1024 * 1024;
+
+    /// Space reserved in the code cache for a block, enough for `MAX_INSTRUCTIONS` of the largest instruction.
+    static const size_t   BLOCK_CAPACITY   = 32 * 1024;
+
+    /// Most instructions in a block.
+    static const size_t   MAX_INSTRUCTIONS = 64;
+
+    /// Number of times an address is reached before the block starting at it is translated.
+    static const byte     HOT              = 16;
+
+    /// Heat of an address the block of which cannot be translated.
+    static const byte     NOT_TRANSLATED   = 0xFF;
+
+
+    // kinds of instructions ---------------------------------------------------------------------------------------
+
+    /// How each op code is translated.
+    enum KIND {
+        KIND_INTERPRET,                 // run by the interpreter
+        KIND_INTERPRET_EXIT,            // run by the interpreter, then the block exits
+        KIND_LDA, KIND_LDX, KIND_LDY, KIND_STA, KIND_STX, KIND_STY,
+        KIND_AND, KIND_ORA, KIND_EOR, KIND_ADC, KIND_SBC, KIND_CMP, KIND_CPX, KIND_CPY, KIND_BIT,
+        KIND_ASL, KIND_LSR, KIND_ROL, KIND_ROR, KIND_INC, KIND_DEC,
+        KIND_INX, KIND_INY, KIND_DEX, KIND_DEY,
+        KIND_TAX, KIND_TAY, KIND_TXA, KIND_TYA, KIND_TSX, KIND_TXS,
+        KIND_CLC, KIND_SEC, KIND_CLD, KIND_SED, KIND_CLV, KIND_SEI, KIND_NOP,
+        KIND_PHA, KIND_PLA,
+        KIND_BRANCH, KIND_JMP,
+    };
+
+    /// Gets whether an instruction of the given kind ends its block.
+    static bool _isTerminator(byte kind) {
+        return kind == KIND_INTERPRET_EXIT || kind == KIND_BRANCH || kind == KIND_JMP;
+    }
+
+    /// Gets whether an instruction of the given kind takes the page crossing penalty of its addressing mode.
+    static bool _hasPenalty(byte kind) {
+        return kind == KIND_LDA || kind == KIND_LDX || kind == KIND_LDY || kind == KIND_AND || kind == KIND_ORA ||
+               kind == KIND_EOR || kind == KIND_ADC || kind == KIND_SBC || kind == KIND_CMP;
+    }
+
+
+#ifdef RT_6502_EMULATOR_RECOMPILER_HOST
+
+    // assembler -------------------------------------------------------------------------------------------------------
+
+    /// x86-64 registers, numbered as in the instruction encoding.
+    enum REGISTER { RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15 };
+
+    /// Condition codes of the conditional jumps & sets.
+    enum CONDITION { CONDITION_AE = 0x3, CONDITION_E = 0x4, CONDITION_NE = 0x5, CONDITION_BE = 0x6 };
+
+    /// Operations of the immediate arithmetic group, encoded in the ModRM byte.
+    enum GROUP { GROUP_ADD = 0, GROUP_OR = 1, GROUP_AND = 4, GROUP_SUB = 5, GROUP_XOR = 6, GROUP_CMP = 7 };
+
+    /// Operations of the shift group, encoded in the ModRM byte.
+    enum SHIFT { SHIFT_SHL = 4, SHIFT_SHR = 5 };
+
+    /// Op codes of the register to register / memory arithmetic, 32 bit unless noted.
+    enum ARITHMETIC {
+        ARITHMETIC_ADD  = 0x01, ARITHMETIC_OR   = 0x09, ARITHMETIC_AND  = 0x21, ARITHMETIC_SUB  = 0x29,
+        ARITHMETIC_XOR  = 0x31,
+        ARITHMETIC_OR8  = 0x0A, ARITHMETIC_AND8 = 0x22, ARITHMETIC_XOR8 = 0x32, ARITHMETIC_CMP8 = 0x3A,
+        ARITHMETIC_ORM  = 0x0B,     // or r32, r/m32
+        ARITHMETIC_CMPM = 0x3B,     // cmp r32, r/m32
+    };
+
+    /// A memory operand, `[base + index * scale + displacement]`.
+    typedef struct _Operand {
+        int     base;
+        int     index;                  // -1 for none
+        int     scale;
+        int32_t displacement;
+    } Operand;
+
+    static Operand _at(int base, int32_t displacement = 0) {
+        return (Operand){base, -1, 1, displacement};
+    }
+
+    static Operand _at(int base, int index, int scale) {
+        return (Operand){base, index, scale, 0};
+    }
+
+    /// Encodes the subset of x86-64 used by translated code into a buffer.
+    ///
+    /// Byte registers are only used for AL, CL, DL & BL, which encode the same with or without a REX prefix.
+    class Assembler {
+    public:
+
+        Assembler(byte *code, size_t capacity) {
+            _code     = code;
+            _size     = 0;
+            _capacity = capacity;
+        }
+
+        size_t size()     { return _size; }
+        size_t capacity() { return _capacity; }
+
+        void emit8(uint32_t value)  { _code[_size++] = byte(value); }
+        void emit16(uint32_t value) { emit8(value);  emit8(value >> 8); }
+        void emit32(uint32_t value) { emit16(value); emit16(value >> 16); }
+        void emit64(uint64_t value) { emit32(uint32_t(value)); emit32(uint32_t(value >> 32)); }
+
+        /// Emits an instruction with a register & a memory operand.
+        void op(std::initializer_list<byte> opcode, int reg, const Operand &rm, bool wide = false) {
+            _rex(wide, reg, rm.index >= 0 ? rm.index : 0, rm.base);
+            for (byte data : opcode) {
+                emit8(data);
+            }
+
+            // RBP & R13 cannot be a base without a displacement
+            int mod = 2;
+            if (rm.displacement == 0 && (rm.base & 7) != RBP) {
+                mod = 0;
+            } else if (rm.displacement >= -128 && rm.displacement < 128) {
+                mod = 1;
+            }
+
+            if (rm.index >= 0) {
+                int scale = rm.scale == 8 ? 3 : rm.scale == 4 ? 2 : rm.scale == 2 ? 1 : 0;
+                emit8((mod << 6) | ((reg & 7) << 3) | RSP);
+                emit8((scale << 6) | ((rm.index & 7) << 3) | (rm.base & 7));
+            } else {
+                emit8((mod << 6) | ((reg & 7) << 3) | (rm.base & 7));
+                if ((rm.base & 7) == RSP) {
+                    emit8(0x24);
+                }
+            }
+
+            if (mod == 1) {
+                emit8(uint32_t(rm.displacement));
+            } else if (mod == 2) {
+                emit32(uint32_t(rm.displacement));
+            }
+        }
+
+        /// Emits an instruction with two register operands.
+        void op(std::initializer_list<byte> opcode, int reg, int rm, bool wide = false) {
+            _rex(wide, reg, 0, rm);
+            for (byte data : opcode) {
+                emit8(data);
+            }
+            emit8(0xC0 | ((reg & 7) << 3) | (rm & 7));
+        }
+
+        void movzx8(int reg, const Operand &rm)         { op({0x0F, 0xB6}, reg, rm); }
+        void movzx8(int reg, int rm)                    { op({0x0F, 0xB6}, reg, rm); }
+        void movzx16(int reg, int rm)                   { op({0x0F, 0xB7}, reg, rm); }
+        void load64(int reg, const Operand &rm)         { op({0x8B}, reg, rm, true); }
+        void store8(const Operand &rm, int reg)         { op({0x88}, reg, rm); }
+        void store32(const Operand &rm, int reg)        { op({0x89}, reg, rm); }
+        void store8i(const Operand &rm, byte value)     { op({0xC6}, 0, rm); emit8(value); }
+        void store16i(const Operand &rm, word value)    { emit8(0x66); op({0xC7}, 0, rm); emit16(value); }
+        void mov(int reg, int rm)                       { op({0x89}, rm, reg); }
+        void mov64(int reg, int rm)                     { op({0x89}, rm, reg, true); }
+        void arithmetic(byte opcode, int reg, int rm)   { op({opcode}, rm, reg); }
+        void arithmetic(byte opcode, int reg, const Operand &rm) { op({opcode}, reg, rm); }
+        void or8(const Operand &rm, int reg)            { op({0x08}, reg, rm); }
+        void group8(int group, const Operand &rm, byte value) { op({0x80}, group, rm); emit8(value); }
+        void group8(int group, int reg, byte value)     { op({0x80}, group, reg); emit8(value); }
+        void shift(int shift, int reg, byte count)      { op({0xC1}, shift, reg); emit8(count); }
+        void invert(int reg)                            { op({0xF7}, 2, reg); }
+        void test8(const Operand &rm, byte value)       { op({0xF6}, 0, rm); emit8(value); }
+        void test8(int reg, int rm)                     { op({0x84}, rm, reg); }
+        void test64(int reg, int rm)                    { op({0x85}, rm, reg, true); }
+        void set(int condition, int reg)                { op({0x0F, byte(0x90 | condition)}, 0, reg); }
+        void call(int reg)                              { op({0xFF}, 2, reg); }
+        void ret()                                      { emit8(0xC3); }
+
+        void group(int group, int reg, uint32_t value) {
+            if (value < 0x80) {
+                op({0x83}, group, reg);
+                emit8(value);
+            } else {
+                op({0x81}, group, reg);
+                emit32(value);
+            }
+        }
+
+        void movi(int reg, uint32_t value) {
+            _rex(false, 0, 0, reg);
+            emit8(0xB8 | (reg & 7));
+            emit32(value);
+        }
+
+        void movi64(int reg, uint64_t value) {
+            _rex(true, 0, 0, reg);
+            emit8(0xB8 | (reg & 7));
+            emit64(value);
+        }
+
+        void push(int reg) {
+            _rex(false, 0, 0, reg);
+            emit8(0x50 | (reg & 7));
+        }
+
+        void pop(int reg) {
+            _rex(false, 0, 0, reg);
+            emit8(0x58 | (reg & 7));
+        }
+
+        /// Emits a forward jump to be bound later.
+        ///
+        /// @returns the site of the jump, for `bind`
+        size_t jump() {
+            emit8(0xE9);
+            emit32(0);
+            return _size;
+        }
+
+        /// Emits a forward conditional jump to be bound later.
+        size_t jump(int condition) {
+            emit8(0x0F);
+            emit8(0x80 | condition);
+            emit32(0);
+            return _size;
+        }
+
+        /// Binds a forward jump to the current position.
+        void bind(size_t site) {
+            uint32_t offset = uint32_t(_size - site);
+            memcpy(_code + site - 4, &offset, 4);
+        }
+
+        /// Emits a jump to the given position.
+        void jumpTo(size_t target) {
+            emit8(0xE9);
+            emit32(uint32_t(int64_t(target) - int64_t(_size + 4)));
+        }
+
+        void jumpTo(int condition, size_t target) {
+            emit8(0x0F);
+            emit8(0x80 | condition);
+            emit32(uint32_t(int64_t(target) - int64_t(_size + 4)));
+        }
+
+    private:
+
+        byte   *_code;
+        size_t  _size;
+        size_t  _capacity;
+
+        void _rex(bool wide, int reg, int index, int base) {
+            int rex = (wide ? 8 : 0) | ((reg >> 3) << 2) | ((index >> 3) << 1) | (base >> 3);
+            if (rex) {
+                emit8(0x40 | rex);
+            }
+        }
+    };
+
+#else
+
+    class Assembler {};
+
+#endif
+
+
+    // constructor & destructor ----------------------------------------------------------------------------------------
+
+    bool Recompiler::isSupported() {
+    #ifdef RT_6502_EMULATOR_RECOMPILER_HOST
+        return true;
+    #else
+        return false;
+    #endif
+    }
+
+    Recompiler::Recompiler(CPU *cpu) {
+        _cpu       = cpu;
+        _cache     = nullptr;
+        _cacheUsed = 0;
+        _nextEvent = 0;
+        _running   = false;
+        _entries.assign(0x10000, nullptr);
+        _heat.assign(0x10000, 0);
+        memset(_codeBytes, 0, sizeof(_codeBytes));
+        memset(_hooked, 0, sizeof(_hooked));
+
+        for (uint32_t data = 0; data < 256; data++) {
+            _context.flags[data] = (data == 0 ? CPU::STATUS_FLAG_ZERO : 0) | (data & CPU::STATUS_FLAG_NEGATIVE);
+        }
+        _context.exit = 0;
+
+        // instructions translated to native code. the rest are left to the interpreter
+        static const struct {
+            bool (CPU::*inst)();
+            byte kind;
+        } native[] = {
+            {&CPU::_inst_LDA, KIND_LDA}, {&CPU::_inst_LDX, KIND_LDX}, {&CPU::_inst_LDY, KIND_LDY},
+            {&CPU::_inst_STA, KIND_STA}, {&CPU::_inst_STX, KIND_STX}, {&CPU::_inst_STY, KIND_STY},
+            {&CPU::_inst_AND, KIND_AND}, {&CPU::_inst_ORA, KIND_ORA}, {&CPU::_inst_EOR, KIND_EOR},
+            {&CPU::_inst_ADC, KIND_ADC}, {&CPU::_inst_SBC, KIND_SBC}, {&CPU::_inst_CMP, KIND_CMP},
+            {&CPU::_inst_CPX, KIND_CPX}, {&CPU::_inst_CPY, KIND_CPY}, {&CPU::_inst_BIT, KIND_BIT},
+            {&CPU::_inst_ASL, KIND_ASL}, {&CPU::_inst_LSR, KIND_LSR}, {&CPU::_inst_ROL, KIND_ROL},
+            {&CPU::_inst_ROR, KIND_ROR}, {&CPU::_inst_INC, KIND_INC}, {&CPU::_inst_DEC, KIND_DEC},
+            {&CPU::_inst_INX, KIND_INX}, {&CPU::_inst_INY, KIND_INY}, {&CPU::_inst_DEX, KIND_DEX},
+            {&CPU::_inst_DEY, KIND_DEY}, {&CPU::_inst_TAX, KIND_TAX}, {&CPU::_inst_TAY, KIND_TAY},
+            {&CPU::_inst_TXA, KIND_TXA}, {&CPU::_inst_TYA, KIND_TYA}, {&CPU::_inst_TSX, KIND_TSX},
+            {&CPU::_inst_TXS, KIND_TXS}, {&CPU::_inst_CLC, KIND_CLC}, {&CPU::_inst_SEC, KIND_SEC},
+            {&CPU::_inst_CLD, KIND_CLD}, {&CPU::_inst_SED, KIND_SED}, {&CPU::_inst_CLV, KIND_CLV},
+            {&CPU::_inst_SEI, KIND_SEI}, {&CPU::_inst_NOP, KIND_NOP}, {&CPU::_inst_PHA, KIND_PHA},
+            {&CPU::_inst_PLA, KIND_PLA}, {&CPU::_inst_JMP, KIND_JMP},
+            {&CPU::_inst_BCC, KIND_BRANCH}, {&CPU::_inst_BCS, KIND_BRANCH}, {&CPU::_inst_BEQ, KIND_BRANCH},
+            {&CPU::_inst_BMI, KIND_BRANCH}, {&CPU::_inst_BNE, KIND_BRANCH}, {&CPU::_inst_BPL, KIND_BRANCH},
+            {&CPU::_inst_BVC, KIND_BRANCH}, {&CPU::_inst_BVS, KIND_BRANCH},
+        };
+        static const struct {
+            bool (CPU::*inst)();
+        } exits[] = {
+            {&CPU::_inst_JMP}, {&CPU::_inst_JSR}, {&CPU::_inst_RTS}, {&CPU::_inst_RTI}, {&CPU::_inst_BRK},
+            {&CPU::_inst_KIL}, {&CPU::_inst_CLI}, {&CPU::_inst_PLP},
+        };
+
+        for (uint32_t code = 0; code < 256; code++) {
+            const CPU::Operation &op = _cpu->_operations[code];
+
+            // only the plain addressing modes are translated: no indirect jump & no NOP reading memory
+            byte kind = KIND_INTERPRET;
+            for (const auto &entry : native) {
+                if (op.inst == entry.inst) {
+                    kind = entry.kind;
+                }
+            }
+            if ((kind == KIND_JMP && op.mode != CPU::ADDRESSING_ABS) ||
+                (kind == KIND_NOP && op.mode != CPU::ADDRESSING_IMP)) {
+                kind = KIND_INTERPRET;
+            }
+
+            // instructions changing the control flow or the interrupt disable flag end the block
+            for (const auto &entry : exits) {
+                if (kind == KIND_INTERPRET && op.inst == entry.inst) {
+                    kind = KIND_INTERPRET_EXIT;
+                }
+            }
+            _kinds[code] = kind;
+        }
+
+        // the registers are addressed relative to the CPU
+        byte *base    = reinterpret_cast<byte *>(_cpu);
+        _offsetAcc    = int32_t(reinterpret_cast<byte *>(&_cpu->_acc)    - base);
+        _offsetIdx    = int32_t(reinterpret_cast<byte *>(&_cpu->_idx)    - base);
+        _offsetIdy    = int32_t(reinterpret_cast<byte *>(&_cpu->_idy)    - base);
+        _offsetStackP = int32_t(reinterpret_cast<byte *>(&_cpu->_stackP) - base);
+        _offsetStatus = int32_t(reinterpret_cast<byte *>(&_cpu->_status) - base);
+        _offsetPC     = int32_t(reinterpret_cast<byte *>(&_cpu->_pc)     - base);
+
+    #ifdef RT_6502_EMULATOR_RECOMPILER_HOST
+        void *cache = mmap(nullptr, CACHE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        _cache      = cache == MAP_FAILED ? nullptr : static_cast<byte *>(cache);
+    #endif
+    }
+
+    Recompiler::~Recompiler() {
+        flush();
+
+    #ifdef RT_6502_EMULATOR_RECOMPILER_HOST
+        if (_cache) {
+            munmap(_cache, CACHE_SIZE);
+        }
+    #endif
+    }
+
+
+    // blocks ----------------------------------------------------------------------------------------------------------
+
+    uint32_t Recompiler::run(uint64_t cycles) {
+        word   pc    = _cpu->_pc;
+        Block *block = _entries[pc];
+        if (block == nullptr) {
+
+            // addresses the block of which cannot be translated are not tried again until their page changes
+            if (_heat[pc] == NOT_TRANSLATED || ++_heat[pc] < HOT) {
+                return 0;
+            }
+            block = _translate(pc);
+            if (block == nullptr) {
+                _heat[pc] = NOT_TRANSLATED;
+                return 0;
+            }
+        }
+        if (block->cycles > cycles) {
+            return 0;
+        }
+
+        // an IRQ pulse lasts until the boundary after the first instruction, where the interpreter would drop it
+        _cpu->_interrupts &= ~CPU::INTERRUPT_IRQ_PULSE;
+        _nextEvent         = _cpu->_scheduler.nextEvent();
+        _context.exit      = 0;
+        _running           = true;
+
+        // translated code keeps all the flags in the status register
+        _cpu->_status      = _cpu->_packStatus();
+        uint32_t count     = block->code(uint32_t(std::min<uint64_t>(cycles, UINT32_MAX)));
+        _cpu->_unpackStatus(_cpu->_status);
+        _running           = false;
+        return count;
+    }
+
+    void Recompiler::written(word address) {
+        byte page = address >> 8;
+        if (_codeBytes[page][(address & 0xFF) >> 5] & (uint32_t(1) << (address & 31))) {
+            invalidatePage(page);
+        }
+    }
+
+    void Recompiler::invalidatePage(byte page) {
+        for (Block *block : _pageBlocks[page]) {
+            if (_entries[block->pc] == block) {
+                _entries[block->pc] = nullptr;
+                _heat[block->pc]    = 0;
+            }
+        }
+        _pageBlocks[page].clear();
+        memset(_codeBytes[page], 0, sizeof(_codeBytes[page]));
+
+        // the page may be shown again with different contents, so its addresses are tried again
+        for (uint32_t address = uint32_t(page) << 8; address < (uint32_t(page) + 1) << 8; address++) {
+            if (_heat[address] == NOT_TRANSLATED) {
+                _heat[address] = 0;
+            }
+        }
+
+        if (_hooked[page]) {
+            _hooked[page] = false;
+            _cpu->unhookPage(page, false, true);
+        }
+
+        // the running block may have been discarded
+        if (_running) {
+            _context.exit = 1;
+        }
+    }
+
+    void Recompiler::flush() {
+        assert(_running == false);
+
+        for (uint32_t page = 0; page < 256; page++) {
+            invalidatePage(byte(page));
+        }
+        std::fill(_heat.begin(), _heat.end(), 0);
+        _blocks.clear();
+        _cacheUsed = 0;
+    }
+
+    std::size_t Recompiler::size() {
+        return _blocks.size();
+    }
+
+    void Recompiler::_checkExit() {
+
+        // an IRQ pulse raised during an instruction is dropped at its end, as `CPU::_dispatch` does
+        _cpu->_interrupts &= ~CPU::INTERRUPT_IRQ_PULSE;
+
+        if (_cpu->_isInterruptRequested() || _cpu->_stopped || _cpu->_halted ||
+            _cpu->_scheduler.nextEvent() != _nextEvent) {
+            _context.exit = 1;
+        }
+    }
+
+
+    // translation -----------------------------------------------------------------------------------------------------
+
+    bool Recompiler::_readCode(uint32_t address, byte &data) {
+        if (address > 0xFFFF) {
+            return false;
+        }
+
+        // code is only translated from memory, since reading I/O can have side effects
+        byte *page = _cpu->Bus::readPage(byte(address >> 8));
+        if (page == nullptr) {
+            return false;
+        }
+        data = page[address & 0xFF];
+        return true;
+    }
+
+    std::vector<Recompiler::Instruction> Recompiler::_decode(word pc) {
+        std::vector<Instruction> instructions;
+        uint32_t                 address = pc;
+        while (instructions.size() < MAX_INSTRUCTIONS) {
+            Instruction instruction;
+            if (_readCode(address, instruction.code) == false) {
+                break;
+            }
+
+            uint32_t length = 0;
+            switch (_cpu->_operations[instruction.code].mode) {
+            case CPU::ADDRESSING_IMP:
+            case CPU::ADDRESSING_ACC:
+                break;
+            case CPU::ADDRESSING_ABS:
+            case CPU::ADDRESSING_ABX:
+            case CPU::ADDRESSING_ABY:
+            case CPU::ADDRESSING_IND:
+                length = 2;
+                break;
+            default:
+                length = 1;
+                break;
+            }
+
+            byte operand[2] = {0x00, 0x00};
+            if ((length > 0 && _readCode(address + 1, operand[0]) == false) ||
+                (length > 1 && _readCode(address + 2, operand[1]) == false)) {
+                break;
+            }
+            instruction.pc      = word(address);
+            instruction.next    = word(address + 1 + length);
+            instruction.operand = word(operand[0]) | (word(operand[1]) << 8);
+            instructions.push_back(instruction);
+
+            address += 1 + length;
+            if (_isTerminator(_kinds[instruction.code])) {
+                break;
+            }
+        }
+        return instructions;
+    }
+
+    uint32_t Recompiler::_worstCycles(const Instruction &instruction) {
+        const CPU::Operation &op   = _cpu->_operations[instruction.code];
+        byte                  kind = _kinds[instruction.code];
+
+        // taken branches take a cycle & another one to cross a page. interpreted instructions may take the penalty
+        if (kind == KIND_BRANCH) {
+            return op.cycles + 2;
+        }
+        if (kind == KIND_INTERPRET) {
+            return op.cycles + 1;
+        }
+        bool indexed = op.mode == CPU::ADDRESSING_ABX || op.mode == CPU::ADDRESSING_ABY ||
+                       op.mode == CPU::ADDRESSING_IZY;
+        return op.cycles + (indexed && _hasPenalty(kind) ? 1 : 0);
+    }
+
+    void Recompiler::_addBlock(Block *block, const std::vector<Instruction> &instructions) {
+        for (const Instruction &instruction : instructions) {
+            uint32_t end = instruction.next > instruction.pc ? instruction.next : 0x10000;
+            for (uint32_t address = instruction.pc; address < end; address++) {
+                byte page = byte(address >> 8);
+                _codeBytes[page][(address & 0xFF) >> 5] |= uint32_t(1) << (address & 31);
+
+                if (_pageBlocks[page].empty() || _pageBlocks[page].back() != block) {
+                    _pageBlocks[page].push_back(block);
+                }
+
+                // writes to the page are checked for writes to the code
+                if (_hooked[page] == false) {
+                    _hooked[page] = true;
+                    _cpu->hookPage(page, false, true);
+                }
+            }
+        }
+        _entries[block->pc] = block;
+    }
+
+    Recompiler::Block *Recompiler::_translate(word pc) {
+    #ifndef RT_6502_EMULATOR_RECOMPILER_HOST
+        return nullptr;
+    #else
+        if (_cache == nullptr) {
+            return nullptr;
+        }
+
+        std::vector<Instruction> instructions = _decode(pc);
+        if (instructions.empty()) {
+            return nullptr;
+        }
+
+        // an instruction looping onto itself is left to the idle loop detection of `CPU::run`
+        const Instruction &first = instructions.front();
+        byte               kind  = _kinds[first.code];
+        if (instructions.size() == 1 &&
+            ((kind == KIND_JMP && first.operand == pc) ||
+             (kind == KIND_BRANCH && word(first.next + int8_t(first.operand)) == pc))) {
+            return nullptr;
+        }
+
+        if (CACHE_SIZE - _cacheUsed < BLOCK_CAPACITY) {
+            flush();
+        }
+
+        std::unique_ptr<Block> block(new Block());
+        block->pc     = pc;
+        block->cycles = 0;
+        for (const Instruction &instruction : instructions) {
+            block->cycles += _worstCycles(instruction);
+        }
+
+        // the cache is only writable while code is emitted
+        mprotect(_cache, CACHE_SIZE, PROT_READ | PROT_WRITE);
+        Assembler assembler(_cache + _cacheUsed, BLOCK_CAPACITY);
+
+        // exit. returns the clock cycles run
+        size_t exit = assembler.size();
+        assembler.mov(RAX, RBP);
+        assembler.op({0x83}, GROUP_ADD, RSP, true);
+        assembler.emit8(8);
+        for (int reg : {R15, R14, R13, R12, RBP, RBX}) {
+            assembler.pop(reg);
+        }
+        assembler.ret();
+
+        // entry. saves the callee saved registers, keeping the stack aligned for calls, & keeps the limit on the
+        // clock cycles at [rsp + 4]. [rsp] is scratch space
+        size_t start = assembler.size();
+        for (int reg : {RBX, RBP, R12, R13, R14, R15}) {
+            assembler.push(reg);
+        }
+        assembler.op({0x83}, GROUP_SUB, RSP, true);
+        assembler.emit8(8);
+        assembler.store32(_at(RSP, 4), RDI);
+        assembler.movi64(RBX, uint64_t(_cpu));
+        assembler.movi64(R12, uint64_t(_cpu->_readPages));
+        assembler.movi64(R14, uint64_t(_cpu->_writePages));
+        assembler.movi64(R15, uint64_t(&_context));
+        assembler.arithmetic(ARITHMETIC_XOR, RBP, RBP);
+
+        size_t entry = assembler.size();
+        for (const Instruction &instruction : instructions) {
+            _emitInstruction(assembler, instruction, *block, entry, exit);
+        }
+        if (_isTerminator(_kinds[instructions.back().code]) == false) {
+            _emitExit(assembler, instructions.back().next, exit);
+        }
+        assert(assembler.size() <= assembler.capacity());
+
+        mprotect(_cache, CACHE_SIZE, PROT_READ | PROT_EXEC);
+        block->code = reinterpret_cast<Code>(_cache + _cacheUsed + start);
+        _cacheUsed += (assembler.size() + 15) & ~size_t(15);
+
+        Block *result = block.get();
+        _blocks.push_back(std::move(block));
+        _addBlock(result, instructions);
+        return result;
+    #endif
+    }
+
+
+#ifdef RT_6502_EMULATOR_RECOMPILER_HOST
+
+    // code generation -------------------------------------------------------------------------------------------------
+
+    /* Translated code keeps the CPU in RBX, the direct read & write pointers in R12 & R14, the context in R15 & the
+     * clock cycles run so far in EBP. These are callee saved, so they survive calls out of the translated code. The
+     * target address of an instruction is computed in ECX & its operand in EAX.
+     */
+
+    void Recompiler::_emitInstruction(Assembler &assembler, const Instruction &instruction, const Block &block,
+                                      size_t entry, size_t exit) {
+        const CPU::Operation &op     = _cpu->_operations[instruction.code];
+        byte                  kind   = _kinds[instruction.code];
+        Operand               status = _at(RBX, _offsetStatus);
+
+        // control flow
+        switch (kind) {
+        case KIND_INTERPRET:
+            _emitInterpret(assembler, instruction);
+            _emitExitCheck(assembler, instruction, exit);
+            return;
+
+        case KIND_INTERPRET_EXIT:
+            _emitInterpret(assembler, instruction);
+            assembler.jumpTo(exit);
+            return;
+
+        case KIND_JMP:
+            assembler.group(GROUP_ADD, RBP, op.cycles);
+            _emitExit(assembler, instruction.operand, exit);
+            return;
+
+        case KIND_BRANCH: {
+
+            // the op code selects the flag tested & the value branched on
+            static const byte flags[4] = {
+                CPU::STATUS_FLAG_NEGATIVE, CPU::STATUS_FLAG_OVERFLOW, CPU::STATUS_FLAG_CARRY, CPU::STATUS_FLAG_ZERO
+            };
+            word   target = word(instruction.next + int8_t(instruction.operand));
+            bool   cross  = (target & 0xFF00) != (instruction.next & 0xFF00);
+            assembler.test8(status, flags[instruction.code >> 6]);
+            size_t taken  = assembler.jump(instruction.code & 0x20 ? CONDITION_NE : CONDITION_E);
+            assembler.group(GROUP_ADD, RBP, op.cycles);
+            _emitExit(assembler, instruction.next, exit);
+            assembler.bind(taken);
+            assembler.group(GROUP_ADD, RBP, op.cycles + 1 + cross);
+
+            // a loop back to the start of the block runs again if another pass fits in the limit
+            if (target == block.pc) {
+                assembler.movi(RAX, block.cycles);
+                assembler.arithmetic(ARITHMETIC_ADD, RAX, RBP);
+                assembler.arithmetic(ARITHMETIC_CMPM, RAX, _at(RSP, 4));
+                assembler.jumpTo(CONDITION_BE, entry);
+            }
+            _emitExit(assembler, target, exit);
+            return;
+        }
+        }
+
+        // decimal mode arithmetic is left to the interpreter
+        size_t decimal = 0;
+        if (kind == KIND_ADC || kind == KIND_SBC) {
+            assembler.test8(status, CPU::STATUS_FLAG_DECIMAL);
+            decimal = assembler.jump(CONDITION_NE);
+        }
+
+        // operand
+        bool    memory = false;
+        Operand index  = _at(RBX, op.mode == CPU::ADDRESSING_ABX ? _offsetIdx : _offsetIdy);
+        switch (op.sequence) {
+        case CPU::SEQUENCE_READ:
+        case CPU::SEQUENCE_READ_MODIFY_WRITE:
+            if (op.mode == CPU::ADDRESSING_IMM) {
+                assembler.movi(RAX, instruction.operand & 0xFF);
+            } else if (op.mode == CPU::ADDRESSING_ACC) {
+                assembler.movzx8(RAX, _at(RBX, _offsetAcc));
+            } else if (op.mode != CPU::ADDRESSING_IMP) {
+                memory = true;
+                _emitAddress(assembler, instruction);
+                _emitRead(assembler, instruction);
+
+                // the page is crossed when the LSB of the target address wraps around below the index
+                if (_hasPenalty(kind) && (op.mode == CPU::ADDRESSING_ABX || op.mode == CPU::ADDRESSING_ABY ||
+                                          op.mode == CPU::ADDRESSING_IZY)) {
+                    assembler.arithmetic(ARITHMETIC_CMP8, RCX, index);
+                    size_t same = assembler.jump(CONDITION_AE);
+                    assembler.group(GROUP_ADD, RBP, 1);
+                    assembler.bind(same);
+                }
+            }
+            break;
+
+        case CPU::SEQUENCE_WRITE:
+            memory = true;
+            _emitAddress(assembler, instruction);
+            break;
+        }
+
+        // instruction
+        Operand acc    = _at(RBX, _offsetAcc);
+        Operand idx    = _at(RBX, _offsetIdx);
+        Operand idy    = _at(RBX, _offsetIdy);
+        Operand stackP = _at(RBX, _offsetStackP);
+        switch (kind) {
+        case KIND_LDA:
+        case KIND_LDX:
+        case KIND_LDY:
+            assembler.store8(kind == KIND_LDA ? acc : kind == KIND_LDX ? idx : idy, RAX);
+            _emitResultFlags(assembler);
+            break;
+
+        case KIND_STA:
+        case KIND_STX:
+        case KIND_STY:
+            assembler.movzx8(RAX, kind == KIND_STA ? acc : kind == KIND_STX ? idx : idy);
+            _emitWrite(assembler, instruction);
+            break;
+
+        case KIND_AND:
+        case KIND_ORA:
+        case KIND_EOR:
+            assembler.arithmetic(kind == KIND_AND ? ARITHMETIC_AND8 : kind == KIND_ORA ? ARITHMETIC_OR8 :
+                                 ARITHMETIC_XOR8, RAX, acc);
+            assembler.movzx8(RAX, RAX);
+            assembler.store8(acc, RAX);
+            _emitResultFlags(assembler);
+            break;
+
+        case KIND_SBC:
+
+            // binary subtraction is addition of the inverted operand
+            assembler.group(GROUP_XOR, RAX, 0xFF);
+            // fall through
+        case KIND_ADC:
+            assembler.movzx8(RCX, acc);
+            assembler.movzx8(RDX, status);
+            assembler.group(GROUP_AND, RDX, CPU::STATUS_FLAG_CARRY);
+            assembler.arithmetic(ARITHMETIC_ADD, RDX, RAX);
+            assembler.arithmetic(ARITHMETIC_ADD, RDX, RCX);
+
+            // overflow when both operands are the same sign but the result is of a different sign
+            assembler.mov(RSI, RCX);
+            assembler.arithmetic(ARITHMETIC_XOR, RSI, RAX);
+            assembler.invert(RSI);
+            assembler.arithmetic(ARITHMETIC_XOR, RCX, RDX);
+            assembler.arithmetic(ARITHMETIC_AND, RCX, RSI);
+            assembler.group(GROUP_AND, RCX, 0x80);
+            assembler.shift(SHIFT_SHR, RCX, 1);
+
+            // carry out of the sum
+            assembler.mov(RSI, RDX);
+            assembler.shift(SHIFT_SHR, RSI, 8);
+            assembler.arithmetic(ARITHMETIC_OR, RCX, RSI);
+
+            assembler.movzx8(RAX, RDX);
+            assembler.store8(acc, RAX);
+            assembler.movzx8(RAX, _at(R15, RAX, 1));
+            assembler.arithmetic(ARITHMETIC_OR, RAX, RCX);
+            assembler.group8(GROUP_AND, status, byte(~(CPU::STATUS_FLAG_CARRY | CPU::STATUS_FLAG_ZERO |
+                                                      CPU::STATUS_FLAG_OVERFLOW | CPU::STATUS_FLAG_NEGATIVE)));
+            assembler.or8(status, RAX);
+            break;
+
+        case KIND_CMP:
+        case KIND_CPX:
+        case KIND_CPY:
+
+            // the carry is set if there is no borrow
+            assembler.movzx8(RCX, kind == KIND_CMP ? acc : kind == KIND_CPX ? idx : idy);
+            assembler.arithmetic(ARITHMETIC_SUB, RCX, RAX);
+            assembler.set(CONDITION_AE, RDX);
+            assembler.movzx8(RDX, RDX);
+            assembler.movzx8(RAX, RCX);
+            assembler.movzx8(RAX, _at(R15, RAX, 1));
+            assembler.arithmetic(ARITHMETIC_OR, RAX, RDX);
+            assembler.group8(GROUP_AND, status, byte(~(CPU::STATUS_FLAG_CARRY | CPU::STATUS_FLAG_ZERO |
+                                                      CPU::STATUS_FLAG_NEGATIVE)));
+            assembler.or8(status, RAX);
+            break;
+
+        case KIND_BIT:
+
+            // negative & overflow from bits 7 & 6 of the operand, zero from the AND with the accumulator
+            assembler.mov(RDX, RAX);
+            assembler.group(GROUP_AND, RDX, CPU::STATUS_FLAG_NEGATIVE | CPU::STATUS_FLAG_OVERFLOW);
+            assembler.arithmetic(ARITHMETIC_AND8, RAX, acc);
+            assembler.test8(RAX, RAX);
+            assembler.set(CONDITION_E, RCX);
+            assembler.movzx8(RCX, RCX);
+            assembler.shift(SHIFT_SHL, RCX, 1);
+            assembler.arithmetic(ARITHMETIC_OR, RDX, RCX);
+            assembler.group8(GROUP_AND, status, byte(~(CPU::STATUS_FLAG_ZERO | CPU::STATUS_FLAG_OVERFLOW |
+                                                      CPU::STATUS_FLAG_NEGATIVE)));
+            assembler.or8(status, RDX);
+            break;
+
+        case KIND_ASL:
+        case KIND_LSR:
+        case KIND_ROL:
+        case KIND_ROR:
+
+            // the carry shifted out goes to EDX
+            assembler.mov(RDX, RAX);
+            if (kind == KIND_ASL || kind == KIND_ROL) {
+                assembler.shift(SHIFT_SHR, RDX, 7);
+                assembler.shift(SHIFT_SHL, RAX, 1);
+            } else {
+                assembler.group(GROUP_AND, RDX, 1);
+                assembler.shift(SHIFT_SHR, RAX, 1);
+            }
+
+            // the carry shifted in
+            if (kind == KIND_ROL || kind == KIND_ROR) {
+                assembler.movzx8(RSI, status);
+                assembler.group(GROUP_AND, RSI, CPU::STATUS_FLAG_CARRY);
+                if (kind == KIND_ROR) {
+                    assembler.shift(SHIFT_SHL, RSI, 7);
+                }
+                assembler.arithmetic(ARITHMETIC_OR, RAX, RSI);
+            }
+            assembler.movzx8(RAX, RAX);
+
+            assembler.movzx8(RSI, _at(R15, RAX, 1));
+            assembler.arithmetic(ARITHMETIC_OR, RDX, RSI);
+            assembler.group8(GROUP_AND, status, byte(~(CPU::STATUS_FLAG_CARRY | CPU::STATUS_FLAG_ZERO |
+                                                      CPU::STATUS_FLAG_NEGATIVE)));
+            assembler.or8(status, RDX);
+            if (op.mode == CPU::ADDRESSING_ACC) {
+                assembler.store8(acc, RAX);
+            } else {
+                _emitWrite(assembler, instruction);
+            }
+            break;
+
+        case KIND_INC:
+        case KIND_DEC:
+            assembler.group(kind == KIND_INC ? GROUP_ADD : GROUP_SUB, RAX, 1);
+            assembler.movzx8(RAX, RAX);
+            _emitResultFlags(assembler);
+            _emitWrite(assembler, instruction);
+            break;
+
+        case KIND_INX:
+        case KIND_INY:
+        case KIND_DEX:
+        case KIND_DEY: {
+            Operand reg = kind == KIND_INX || kind == KIND_DEX ? idx : idy;
+            assembler.movzx8(RAX, reg);
+            assembler.group(kind == KIND_INX || kind == KIND_INY ? GROUP_ADD : GROUP_SUB, RAX, 1);
+            assembler.movzx8(RAX, RAX);
+            assembler.store8(reg, RAX);
+            _emitResultFlags(assembler);
+            break;
+        }
+
+        case KIND_TAX:
+        case KIND_TAY:
+        case KIND_TXA:
+        case KIND_TYA:
+        case KIND_TSX:
+        case KIND_TXS: {
+            Operand source      = kind == KIND_TAX || kind == KIND_TAY ? acc : kind == KIND_TXA || kind == KIND_TXS ?
+                                  idx : kind == KIND_TYA ? idy : stackP;
+            Operand destination = kind == KIND_TAX || kind == KIND_TSX ? idx : kind == KIND_TAY ? idy :
+                                  kind == KIND_TXS ? stackP : acc;
+            assembler.movzx8(RAX, source);
+            assembler.store8(destination, RAX);
+            if (kind != KIND_TXS) {
+                _emitResultFlags(assembler);
+            }
+            break;
+        }
+
+        case KIND_CLC: assembler.group8(GROUP_AND, status, byte(~CPU::STATUS_FLAG_CARRY));              break;
+        case KIND_SEC: assembler.group8(GROUP_OR,  status, CPU::STATUS_FLAG_CARRY);                     break;
+        case KIND_CLD: assembler.group8(GROUP_AND, status, byte(~CPU::STATUS_FLAG_DECIMAL));            break;
+        case KIND_SED: assembler.group8(GROUP_OR,  status, CPU::STATUS_FLAG_DECIMAL);                   break;
+        case KIND_CLV: assembler.group8(GROUP_AND, status, byte(~CPU::STATUS_FLAG_OVERFLOW));           break;
+        case KIND_SEI: assembler.group8(GROUP_OR,  status, CPU::STATUS_FLAG_DISABLE_INTERRUPTS);        break;
+        case KIND_NOP:                                                                                   break;
+
+        case KIND_PHA:
+            memory = true;
+            assembler.movzx8(RCX, stackP);
+            assembler.group(GROUP_OR, RCX, 0x0100);
+            assembler.movzx8(RAX, acc);
+            _emitWrite(assembler, instruction);
+            assembler.group8(GROUP_SUB, stackP, 1);
+            break;
+
+        case KIND_PLA:
+            memory = true;
+            assembler.group8(GROUP_ADD, stackP, 1);
+            assembler.movzx8(RCX, stackP);
+            assembler.group(GROUP_OR, RCX, 0x0100);
+            _emitRead(assembler, instruction);
+            assembler.store8(acc, RAX);
+            _emitResultFlags(assembler);
+            break;
+        }
+        assembler.group(GROUP_ADD, RBP, op.cycles);
+
+        if (decimal) {
+            size_t done = assembler.jump();
+            assembler.bind(decimal);
+            _emitInterpret(assembler, instruction);
+            assembler.bind(done);
+            memory = true;
+        }
+        if (memory) {
+            _emitExitCheck(assembler, instruction, exit);
+        }
+    }
+
+    void Recompiler::_emitAddress(Assembler &assembler, const Instruction &instruction) {
+        const CPU::Operation &op = _cpu->_operations[instruction.code];
+        switch (op.mode) {
+        case CPU::ADDRESSING_ZPG:
+            assembler.movi(RCX, instruction.operand & 0xFF);
+            break;
+
+        case CPU::ADDRESSING_ZPX:
+        case CPU::ADDRESSING_ZPY:
+
+            // adding to CL wraps around in the zero page
+            assembler.movzx8(RCX, _at(RBX, op.mode == CPU::ADDRESSING_ZPX ? _offsetIdx : _offsetIdy));
+            assembler.group8(GROUP_ADD, RCX, byte(instruction.operand));
+            break;
+
+        case CPU::ADDRESSING_ABS:
+            assembler.movi(RCX, instruction.operand);
+            break;
+
+        case CPU::ADDRESSING_ABX:
+        case CPU::ADDRESSING_ABY:
+            assembler.movzx8(RCX, _at(RBX, op.mode == CPU::ADDRESSING_ABX ? _offsetIdx : _offsetIdy));
+            assembler.group(GROUP_ADD, RCX, instruction.operand);
+            assembler.movzx16(RCX, RCX);
+            break;
+
+        case CPU::ADDRESSING_IZX:
+        case CPU::ADDRESSING_IZY:
+
+            // the pointer wraps around in the zero page. its LSB is kept at [rsp] while the MSB is read
+            if (op.mode == CPU::ADDRESSING_IZX) {
+                assembler.movzx8(RCX, _at(RBX, _offsetIdx));
+                assembler.group8(GROUP_ADD, RCX, byte(instruction.operand));
+            } else {
+                assembler.movi(RCX, instruction.operand & 0xFF);
+            }
+            _emitRead(assembler, instruction);
+            assembler.store32(_at(RSP), RAX);
+            assembler.group8(GROUP_ADD, RCX, 1);
+            _emitRead(assembler, instruction);
+            assembler.shift(SHIFT_SHL, RAX, 8);
+            assembler.arithmetic(ARITHMETIC_ORM, RAX, _at(RSP));
+            if (op.mode == CPU::ADDRESSING_IZY) {
+                assembler.movzx8(RCX, _at(RBX, _offsetIdy));
+                assembler.arithmetic(ARITHMETIC_ADD, RCX, RAX);
+                assembler.movzx16(RCX, RCX);
+            } else {
+                assembler.mov(RCX, RAX);
+            }
+            break;
+        }
+    }
+
+    void Recompiler::_emitRead(Assembler &assembler, const Instruction &instruction) {
+
+        // direct read through the page pointer
+        assembler.mov(RAX, RCX);
+        assembler.shift(SHIFT_SHR, RAX, 8);
+        assembler.load64(RDX, _at(R12, RAX, 8));
+        assembler.test64(RDX, RDX);
+        size_t slow = assembler.jump(CONDITION_E);
+        assembler.movzx8(RAX, RCX);
+        assembler.movzx8(RAX, _at(RDX, RAX, 1));
+        size_t done = assembler.jump();
+
+        // read through the bus. the address is kept in R13 across the call
+        assembler.bind(slow);
+        assembler.mov(R13, RCX);
+        assembler.mov64(RDI, RBX);
+        assembler.mov(RSI, RCX);
+        assembler.mov(RDX, RBP);
+        assembler.movi(RCX, instruction.next);
+        assembler.movi64(RAX, uint64_t(&Recompiler::_read));
+        assembler.call(RAX);
+        assembler.mov(RCX, R13);
+        assembler.bind(done);
+    }
+
+    void Recompiler::_emitWrite(Assembler &assembler, const Instruction &instruction) {
+
+        // direct write through the page pointer
+        assembler.mov(RDX, RCX);
+        assembler.shift(SHIFT_SHR, RDX, 8);
+        assembler.load64(RDX, _at(R14, RDX, 8));
+        assembler.test64(RDX, RDX);
+        size_t slow = assembler.jump(CONDITION_E);
+        assembler.movzx8(RSI, RCX);
+        assembler.store8(_at(RDX, RSI, 1), RAX);
+        size_t done = assembler.jump();
+
+        // write through the bus
+        assembler.bind(slow);
+        assembler.mov64(RDI, RBX);
+        assembler.mov(RSI, RCX);
+        assembler.movzx8(RDX, RAX);
+        assembler.mov(RCX, RBP);
+        assembler.movi(R8, instruction.next);
+        assembler.movi64(RAX, uint64_t(&Recompiler::_write));
+        assembler.call(RAX);
+        assembler.bind(done);
+    }
+
+    void Recompiler::_emitInterpret(Assembler &assembler, const Instruction &instruction) {
+        assembler.mov64(RDI, RBX);
+        assembler.movi(RSI, instruction.pc);
+        assembler.mov(RDX, RBP);
+        assembler.movi64(RAX, uint64_t(&Recompiler::_interpret));
+        assembler.call(RAX);
+        assembler.arithmetic(ARITHMETIC_ADD, RBP, RAX);
+    }
+
+    void Recompiler::_emitExit(Assembler &assembler, word pc, size_t exit) {
+        assembler.store16i(_at(RBX, _offsetPC), pc);
+        assembler.jumpTo(exit);
+    }
+
+    void Recompiler::_emitExitCheck(Assembler &assembler, const Instruction &instruction, size_t exit) {
+        assembler.group8(GROUP_CMP, _at(R15, offsetof(Context, exit)), 0);
+        size_t stay = assembler.jump(CONDITION_E);
+        _emitExit(assembler, instruction.next, exit);
+        assembler.bind(stay);
+    }
+
+    void Recompiler::_emitResultFlags(Assembler &assembler) {
+        Operand status = _at(RBX, _offsetStatus);
+        assembler.movzx8(RDX, _at(R15, RAX, 1));
+        assembler.group8(GROUP_AND, status, byte(~(CPU::STATUS_FLAG_ZERO | CPU::STATUS_FLAG_NEGATIVE)));
+        assembler.or8(status, RDX);
+    }
+
+#else
+
+    void Recompiler::_emitInstruction(Assembler &assembler, const Instruction &instruction, const Block &block,
+                                      size_t entry, size_t exit) {}
+    void Recompiler::_emitAddress(Assembler &assembler, const Instruction &instruction) {}
+    void Recompiler::_emitRead(Assembler &assembler, const Instruction &instruction) {}
+    void Recompiler::_emitWrite(Assembler &assembler, const Instruction &instruction) {}
+    void Recompiler::_emitInterpret(Assembler &assembler, const Instruction &instruction) {}
+    void Recompiler::_emitExit(Assembler &assembler, word pc, size_t exit) {}
+    void Recompiler::_emitExitCheck(Assembler &assembler, const Instruction &instruction, size_t exit) {}
+    void Recompiler::_emitResultFlags(Assembler &assembler) {}
+
+#endif
+
+
+    // called by translated code ---------------------------------------------------------------------------------------
+
+    /* The clock & program counter are brought up to date for the devices & watchpoints while they are called. */
+
+    uint32_t Recompiler::_read(CPU *cpu, uint32_t address, uint32_t cycles, uint32_t pc) {
+        cpu->_cycles += cycles;
+        cpu->_pc      = word(pc);
+        cpu->_unpackStatus(cpu->_status);
+        byte data     = cpu->_read(word(address));
+        cpu->_cycles -= cycles;
+        cpu->_recompiler->_checkExit();
+        return data;
+    }
+
+    void Recompiler::_write(CPU *cpu, uint32_t address, uint32_t data, uint32_t cycles, uint32_t pc) {
+        cpu->_cycles += cycles;
+        cpu->_pc      = word(pc);
+        cpu->_unpackStatus(cpu->_status);
+        cpu->_write(word(address), byte(data));
+        cpu->_cycles -= cycles;
+        cpu->_recompiler->_checkExit();
+    }
+
+    uint32_t Recompiler::_interpret(CPU *cpu, uint32_t pc, uint32_t cycles) {
+        cpu->_cycles += cycles;
+        cpu->_pc      = word(pc);
+        cpu->_unpackStatus(cpu->_status);
+        cpu->_execute();
+        cpu->_status  = cpu->_packStatus() | CPU::STATUS_FLAG_UNUSED;
+
+        // like `tick`, an operation takes at least one clock cycle
+        uint32_t count  = cpu->_opCycles > 0 ? cpu->_opCycles : 1;
+        cpu->_opCycles  = 0;
+        cpu->_cycles   -= cycles;
+        cpu->_recompiler->_checkExit();
+        return count;
+    }
+}
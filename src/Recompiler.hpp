@@ -0,0 +1,191 @@
+//
+//  Recompiler.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_RECOMPILER_HPP__
+#define __RT_6502_EMULATOR_RECOMPILER_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "types.hpp"
+
+namespace rt_6502_emulator {
+
+    class CPU;
+    class Assembler;
+
+    /// Dynamic recompiler translating hot basic blocks of 6502 code into native x86-64 code. See
+    /// `CPU::setRecompiling`.
+    ///
+    /// Blocks are discovered from the program counter at the instruction boundaries of `CPU::run`: a block is
+    /// translated once its start address has been reached a number of times. A block runs up to the first branch,
+    /// jump, return or interrupt related instruction, or up to a page that cannot be read directly. Translated
+    /// code keeps the 6502 registers in the CPU, reads & writes memory through the direct page pointers of the bus &
+    /// adds up the clock cycles of each instruction, including the page crossing penalties. A branch back to the
+    /// start of its own block loops within the native code.
+    ///
+    /// Cycle accounting matches the interpreter exactly. A block is only entered if its worst case cycle count fits
+    /// in the time left before the next scheduled event & the end of the budget, so events & interrupt requests are
+    /// still dispatched at the instruction boundaries they would be at otherwise. Accesses to pages that cannot be
+    /// accessed directly (I/O, watched pages) go through the bus as the interpreter's do. If such an access raises
+    /// an interrupt, stops the CPU or schedules an event, the block exits after the instruction.
+    ///
+    /// Decimal mode arithmetic & the instructions that are rare or change the control flow in complex ways (JSR,
+    /// RTS, RTI, BRK, PHP, PLP, CLI, illegal op codes etc) are run by the interpreter from within the block.
+    ///
+    /// Pages holding translated code have their writes hooked. A write by the CPU or through the bus to a byte of
+    /// translated code discards the blocks of its page, as does switching the bank shown in the page. Memory changed
+    /// by other means needs `CPU::flushTranslations`.
+    ///
+    /// Only x86-64 hosts with the System V calling convention (Linux, the BSDs & macOS) are supported.
+    class Recompiler {
+    public:
+
+        /// Gets whether the host is supported.
+        static bool isSupported();
+
+        /// Constructs a recompiler for the given CPU with an empty code cache.
+        Recompiler(CPU *cpu);
+
+        /// Destructor. Releases the code cache & the pages hooked on the CPU's bus.
+        ~Recompiler();
+
+
+        /// Runs the block starting at the program counter, if it is hot & fits in the given number of clock cycles.
+        /// Called by `CPU::run` at instruction boundaries where no interrupt is requested.
+        ///
+        /// @param cycles the most clock cycles the block may run for
+        ///
+        /// @returns the number of clock cycles run. 0 if no block was run
+        uint32_t run(uint64_t cycles);
+
+        /// Notes a write to the given address. Discards the blocks of the page if the address holds translated code.
+        void written(word address);
+
+        /// Discards the blocks translated from the given page.
+        void invalidatePage(byte page);
+
+        /// Discards all blocks & empties the code cache.
+        void flush();
+
+        /// Gets the number of blocks translated since the last flush, including discarded ones.
+        std::size_t size();
+
+    private:
+
+        /// Native code of a block. Takes the most clock cycles it may run for & returns the clock cycles run.
+        typedef uint32_t (*Code)(uint32_t cycles);
+
+        /// A translated block.
+        typedef struct _Block {
+            word     pc;                // address of the first instruction
+            uint32_t cycles;            // worst case clock cycles of a pass through the block
+            Code     code;
+        } Block;
+
+        /// A decoded instruction.
+        typedef struct _Instruction {
+            word     pc;                // address of the op code
+            word     next;              // address of the next instruction
+            byte     code;              // op code
+            word     operand;           // operand bytes, little endian
+        } Instruction;
+
+        /// Data used by translated code, addressed through a register.
+        typedef struct _Context {
+            byte     flags[256];        // zero & negative flags of each result
+            byte     exit;              // set when the block has to exit after the current instruction
+        } Context;
+
+        CPU                                 *_cpu;
+        Context                              _context;
+        byte                                *_cache;            // executable code cache
+        size_t                               _cacheUsed;
+        std::vector<std::unique_ptr<Block> > _blocks;           // blocks translated since the last flush
+        std::vector<Block *>                 _entries;          // block starting at each address, if any
+        std::vector<byte>                    _heat;             // times each address was reached without a block
+        std::vector<Block *>                 _pageBlocks[256];  // blocks with code in each page
+        uint32_t                             _codeBytes[256][8];// bytes of each page holding translated code
+        bool                                 _hooked[256];      // pages with their writes hooked
+        uint64_t                             _nextEvent;        // next event due when the running block was entered
+        bool                                 _running;          // set while a block runs
+        byte                                 _kinds[256];       // how each op code is translated. see `KIND`
+
+        /// Offsets of the registers in the CPU.
+        int32_t _offsetAcc, _offsetIdx, _offsetIdy, _offsetStackP, _offsetStatus, _offsetPC;
+
+        /// Translates the block starting at the given address.
+        ///
+        /// @returns the block or `nullptr` if nothing could be translated
+        Block *_translate(word pc);
+
+        /// Decodes the block starting at the given address, up to its last instruction.
+        std::vector<Instruction> _decode(word pc);
+
+        /// Reads a byte of code. Fails if the page cannot be read directly.
+        bool _readCode(uint32_t address, byte &data);
+
+        /// Gets the worst case clock cycles of an instruction.
+        uint32_t _worstCycles(const Instruction &instruction);
+
+        /// Hooks the writes of the pages holding the given block & marks its bytes as translated code.
+        void _addBlock(Block *block, const std::vector<Instruction> &instructions);
+
+        /// Sets the exit flag of the running block if the CPU has to return to the run loop, ie. if an interrupt is
+        /// requested, the CPU stopped or halted, or an event was scheduled.
+        void _checkExit();
+
+
+        /* Code generation */
+
+        /// Emits an instruction.
+        ///
+        /// @param entry offset of the loop entry of the block, for branches back to its start
+        /// @param exit  offset of the exit of the block
+        void _emitInstruction(Assembler &assembler, const Instruction &instruction, const Block &block,
+                              size_t entry, size_t exit);
+
+        /// Emits the computation of the target address of an instruction into ECX.
+        void _emitAddress(Assembler &assembler, const Instruction &instruction);
+
+        /// Emits a read of the byte at the address in ECX into EAX. ECX is preserved.
+        void _emitRead(Assembler &assembler, const Instruction &instruction);
+
+        /// Emits a write of AL to the address in ECX.
+        void _emitWrite(Assembler &assembler, const Instruction &instruction);
+
+        /// Emits a call to the interpreter to run an instruction, adding its clock cycles.
+        void _emitInterpret(Assembler &assembler, const Instruction &instruction);
+
+        /// Emits an exit of the block, continuing at the given address.
+        void _emitExit(Assembler &assembler, word pc, size_t exit);
+
+        /// Emits an exit of the block after the given instruction if the exit flag is set.
+        void _emitExitCheck(Assembler &assembler, const Instruction &instruction, size_t exit);
+
+        /// Emits the update of the zero & negative flags from the result in EAX.
+        void _emitResultFlags(Assembler &assembler);
+
+
+        /* Called by translated code */
+
+        /// Reads a byte through the bus.
+        static uint32_t _read(CPU *cpu, uint32_t address, uint32_t cycles, uint32_t pc);
+
+        /// Writes a byte through the bus.
+        static void _write(CPU *cpu, uint32_t address, uint32_t data, uint32_t cycles, uint32_t pc);
+
+        /// Runs the instruction at the given address with the interpreter.
+        ///
+        /// @returns the clock cycles the instruction took
+        static uint32_t _interpret(CPU *cpu, uint32_t pc, uint32_t cycles);
+    };
+}
+
+#endif // __RT_6502_EMULATOR_RECOMPILER_HPP__
@@ -0,0 +1,72 @@
+//
+//  Scheduler.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <algorithm>
+#include "Scheduler.hpp"
+
+namespace rt_6502_emulator {
+
+    // constructor & destructor ----------------------------------------------------------------------------------------
+
+    Scheduler::Scheduler() {
+        _nextId    = 1;
+        _nextEvent = UINT64_MAX;
+    }
+
+    Scheduler::~Scheduler() {}
+
+
+    // events ----------------------------------------------------------------------------------------------------------
+
+    Scheduler::EventId Scheduler::schedule(uint64_t cycle, Callback callback) {
+        EventId id = _nextId++;
+        _events.push_back((Event){cycle, id, std::move(callback)});
+        std::push_heap(_events.begin(), _events.end(), _later);
+        _nextEvent = _events.front().cycle;
+        return id;
+    }
+
+    bool Scheduler::cancel(EventId id) {
+        for (std::size_t i = 0; i < _events.size(); i++) {
+            if (_events[i].id == id) {
+                _events[i] = std::move(_events.back());
+                _events.pop_back();
+                std::make_heap(_events.begin(), _events.end(), _later);
+                _nextEvent = _events.empty() ? UINT64_MAX : _events.front().cycle;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Scheduler::clear() {
+        _events.clear();
+        _nextEvent = UINT64_MAX;
+    }
+
+    std::size_t Scheduler::size() {
+        return _events.size();
+    }
+
+    void Scheduler::dispatch(uint64_t cycle) {
+        while (_events.empty() == false && _events.front().cycle <= cycle) {
+
+            // remove the event before calling back, since the callback may schedule or cancel events
+            std::pop_heap(_events.begin(), _events.end(), _later);
+            Event event = std::move(_events.back());
+            _events.pop_back();
+            _nextEvent  = _events.empty() ? UINT64_MAX : _events.front().cycle;
+
+            event.callback(event.cycle);
+        }
+    }
+
+    bool Scheduler::_later(const Event &a, const Event &b) {
+        return a.cycle != b.cycle ? a.cycle > b.cycle : a.id > b.id;
+    }
+}
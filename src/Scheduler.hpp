@@ -0,0 +1,92 @@
+//
+//  Scheduler.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_SCHEDULER_HPP__
+#define __RT_6502_EMULATOR_SCHEDULER_HPP__
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include "types.hpp"
+
+namespace rt_6502_emulator {
+
+    /// Schedules events at clock cycle deadlines. See `CPU::getScheduler`.
+    ///
+    /// Devices register a callback for the clock cycle they need to act on (eg. a timer expiring) instead of being
+    /// polled every cycle. The CPU runs instructions back to back until the earliest deadline & then dispatches the
+    /// events that are due. Events are kept in a binary min-heap ordered by deadline, with events due on the same
+    /// cycle dispatched in the order they were scheduled.
+    ///
+    /// Events are dispatched at instruction boundaries, so they run late by up to the length of an instruction. The
+    /// deadline is passed to the callback, so that periodic events can be rescheduled without drifting.
+    class Scheduler {
+    public:
+
+        /// Callback of an event. Called with the clock cycle the event was scheduled for.
+        typedef std::function<void (uint64_t cycle)> Callback;
+
+        /// Identifies a scheduled event. Never 0.
+        typedef uint64_t EventId;
+
+
+        /// Constructs a scheduler with no events.
+        Scheduler();
+
+        /// Destructor
+        ~Scheduler();
+
+
+        /// Schedules an event. Events can be scheduled from callbacks, including the callback being dispatched.
+        ///
+        /// @param cycle    the clock cycle the event is due on. see `CPU::getCycles`
+        /// @param callback the callback to call
+        ///
+        /// @returns the id of the event, to cancel it with
+        EventId schedule(uint64_t cycle, Callback callback);
+
+        /// Cancels a scheduled event. This is linear in the number of scheduled events.
+        ///
+        /// @param id the id returned by `schedule`
+        ///
+        /// @returns `false` if the event was already dispatched or cancelled
+        bool cancel(EventId id);
+
+        /// Cancels all scheduled events.
+        void clear();
+
+        /// Gets the number of scheduled events.
+        std::size_t size();
+
+        /// Gets the clock cycle the earliest event is due on, or `UINT64_MAX` if no event is scheduled.
+        uint64_t nextEvent() { return _nextEvent; }
+
+        /// Dispatches all events due on or before the given clock cycle, in order of their deadlines. Events
+        /// scheduled by the callbacks are dispatched as well if they are due.
+        ///
+        /// @param cycle the current clock cycle
+        void dispatch(uint64_t cycle);
+
+    private:
+
+        typedef struct _Event {
+            uint64_t cycle;
+            EventId  id;
+            Callback callback;
+        } Event;
+
+        std::vector<Event> _events;         // min-heap on (cycle, id)
+        EventId            _nextId;
+        uint64_t           _nextEvent;      // deadline of the root of the heap, cached for the CPU's run loop
+
+        /// Orders the heap so that the earliest event is at the root.
+        static bool _later(const Event &a, const Event &b);
+    };
+}
+
+#endif // __RT_6502_EMULATOR_SCHEDULER_HPP__
@@ -0,0 +1,103 @@
+//
+//  Snapshot.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <string.h>
+#include "Snapshot.hpp"
+
+namespace rt_6502_emulator {
+
+    // constructors ----------------------------------------------------------------------------------------------------
+
+    Snapshot::Snapshot() {}
+
+    Snapshot::Snapshot(const byte *data, std::size_t size): _data(data, data + size) {}
+
+
+    // accessors -------------------------------------------------------------------------------------------------------
+
+    const std::vector<byte> &Snapshot::data() const {
+        return _data;
+    }
+
+    void Snapshot::clear() {
+        _data.clear();
+    }
+
+
+    // append ----------------------------------------------------------------------------------------------------------
+
+    void Snapshot::appendByte(byte value) {
+        _data.push_back(value);
+    }
+
+    void Snapshot::appendWord(word value) {
+        appendByte(byte(value));
+        appendByte(byte(value >> 8));
+    }
+
+    void Snapshot::appendUInt32(uint32_t value) {
+        appendWord(word(value));
+        appendWord(word(value >> 16));
+    }
+
+    void Snapshot::appendUInt64(uint64_t value) {
+        appendUInt32(uint32_t(value));
+        appendUInt32(uint32_t(value >> 32));
+    }
+
+    void Snapshot::appendBytes(const byte *data, std::size_t size) {
+        _data.insert(_data.end(), data, data + size);
+    }
+
+
+    // read ------------------------------------------------------------------------------------------------------------
+
+    bool Snapshot::readByte(std::size_t &offset, byte &value) const {
+        if (offset >= _data.size()) {
+            return false;
+        }
+        value = _data[offset++];
+        return true;
+    }
+
+    bool Snapshot::readWord(std::size_t &offset, word &value) const {
+        byte lsb, msb;
+        if (readByte(offset, lsb) == false || readByte(offset, msb) == false) {
+            return false;
+        }
+        value = word(lsb) | (word(msb) << 8);
+        return true;
+    }
+
+    bool Snapshot::readUInt32(std::size_t &offset, uint32_t &value) const {
+        word lsw, msw;
+        if (readWord(offset, lsw) == false || readWord(offset, msw) == false) {
+            return false;
+        }
+        value = uint32_t(lsw) | (uint32_t(msw) << 16);
+        return true;
+    }
+
+    bool Snapshot::readUInt64(std::size_t &offset, uint64_t &value) const {
+        uint32_t lsw, msw;
+        if (readUInt32(offset, lsw) == false || readUInt32(offset, msw) == false) {
+            return false;
+        }
+        value = uint64_t(lsw) | (uint64_t(msw) << 32);
+        return true;
+    }
+
+    bool Snapshot::readBytes(std::size_t &offset, byte *data, std::size_t size) const {
+        if (offset > _data.size() || size > _data.size() - offset) {
+            return false;
+        }
+        memcpy(data, _data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+}
@@ -0,0 +1,88 @@
+//
+//  Snapshot.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_SNAPSHOT_HPP__
+#define __RT_6502_EMULATOR_SNAPSHOT_HPP__
+
+#include <stdint.h>
+#include <vector>
+#include "types.hpp"
+
+namespace rt_6502_emulator {
+
+    /// A binary snapshot of the state of the CPU & its attached devices.
+    ///
+    /// The snapshot is a flat byte buffer. Components append their state with the `append` methods on save, and read
+    /// it back in the same order with the `read` methods on restore. Values are stored little endian so that
+    /// snapshots can be written to disk & shared between machines.
+    ///
+    /// Reading does not modify the snapshot. The read position is passed in by the caller, so the same snapshot can
+    /// be restored any number of times, including from multiple threads.
+    class Snapshot {
+    public:
+
+        /// Constructs an empty snapshot.
+        Snapshot();
+
+        /// Constructs a snapshot from a buffer previously obtained with `data`.
+        ///
+        /// @param data the snapshot contents
+        /// @param size number of bytes in `data`
+        Snapshot(const byte *data, std::size_t size);
+
+
+        /// The contents of the snapshot.
+        const std::vector<byte> &data() const;
+
+        /// Discards the contents of the snapshot.
+        void clear();
+
+
+        /// Appends a byte.
+        void appendByte(byte value);
+
+        /// Appends a word.
+        void appendWord(word value);
+
+        /// Appends a 32 bit value.
+        void appendUInt32(uint32_t value);
+
+        /// Appends a 64 bit value.
+        void appendUInt64(uint64_t value);
+
+        /// Appends a block of bytes.
+        void appendBytes(const byte *data, std::size_t size);
+
+
+        /// Reads a byte.
+        ///
+        /// @param offset read position. advanced past the value on success
+        /// @param value  reference to the variable to read into
+        ///
+        /// @returns `false` if the snapshot ends before the value
+        bool readByte(std::size_t &offset, byte &value) const;
+
+        /// Reads a word. See `readByte`.
+        bool readWord(std::size_t &offset, word &value) const;
+
+        /// Reads a 32 bit value. See `readByte`.
+        bool readUInt32(std::size_t &offset, uint32_t &value) const;
+
+        /// Reads a 64 bit value. See `readByte`.
+        bool readUInt64(std::size_t &offset, uint64_t &value) const;
+
+        /// Reads a block of bytes. See `readByte`.
+        bool readBytes(std::size_t &offset, byte *data, std::size_t size) const;
+
+    private:
+
+        std::vector<byte> _data;
+    };
+}
+
+#endif // __RT_6502_EMULATOR_SNAPSHOT_HPP__
@@ -0,0 +1,270 @@
+//
+//  TraceRecorder.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <string.h>
+#include <algorithm>
+#include "TraceRecorder.hpp"
+
+namespace rt_6502_emulator {
+
+    /* Each record starts with a header byte that describes what follows it:
+     *
+     *   bits 0-1  number of operand bytes, or RECORD_INTERRUPT for an interrupt
+     *   bits 2-7  RECORD_* flags for the fields present
+     *
+     * followed by the fields present, in order: interrupt type, program counter, op code & operand bytes, effective
+     * address, accumulator, x, y, stack pointer & status. Words are little endian.
+     */
+
+    /// Signature & version at the start of trace files.
+    static const char TRACE_SIGNATURE[7] = { '6', '5', '0', '2', 'T', 'R', 'C' };
+    static const byte TRACE_VERSION      = 1;
+
+    /// Record header fields
+    enum RECORD {
+        RECORD_LENGTH    = 0x03,            // mask of the number of operand bytes
+        RECORD_INTERRUPT = 0x03,            // number of operand bytes for interrupt records
+        RECORD_PC        = (1 << 2),        // program counter does not follow on from the previous instruction
+        RECORD_ADDRESS   = (1 << 3),        // effective address present
+        RECORD_ACC       = (1 << 4),        // accumulator changed
+        RECORD_IDX       = (1 << 5),        // x index register changed
+        RECORD_IDY       = (1 << 6),        // y index register changed
+        RECORD_STACK     = (1 << 7),        // stack pointer or status changed. both are stored
+    };
+
+    /// Largest size of a record in bytes
+    static const std::size_t RECORD_SIZE_MAX = 14;
+
+    /// Largest size of a block in bytes. blocks are prefixed with their length as a word
+    static const std::size_t BLOCK_SIZE_MAX = 0xFFFF;
+
+
+    // constructors & destructor ---------------------------------------------------------------------------------------
+
+    TraceRecorder::TraceRecorder(std::size_t capacity, std::size_t blockSize) {
+        _stream    = nullptr;
+        _failed    = false;
+        _blockSize = std::min(std::max(blockSize, RECORD_SIZE_MAX), BLOCK_SIZE_MAX);
+        _blocks.resize(std::max<std::size_t>(capacity / _blockSize, 2));
+        clear();
+    }
+
+    TraceRecorder::TraceRecorder(FILE *stream, std::size_t blockSize) {
+        _stream    = stream;
+        _blockSize = std::min(std::max(blockSize, RECORD_SIZE_MAX), BLOCK_SIZE_MAX);
+        _blocks.resize(1);
+        clear();
+        _failed    = _writeHeader(_stream) == false;
+    }
+
+    TraceRecorder::~TraceRecorder() {
+        if (_stream) {
+            flush();
+        }
+    }
+
+
+    // record ----------------------------------------------------------------------------------------------------------
+
+    void TraceRecorder::record(const Entry &entry) {
+        if (_blocks[_head].size() + RECORD_SIZE_MAX > _blockSize) {
+            _nextBlock();
+        }
+
+        // the first record of a block is stored in full
+        std::vector<byte> &block = _blocks[_head];
+        bool full   = block.empty();
+        byte header = entry.interruptType ? byte(RECORD_INTERRUPT) : entry.length;
+        if (full || entry.pc != _nextPC)                                         header |= RECORD_PC;
+        if (entry.hasAddress)                                                    header |= RECORD_ADDRESS;
+        if (full || entry.acc != _previous.acc)                                  header |= RECORD_ACC;
+        if (full || entry.idx != _previous.idx)                                  header |= RECORD_IDX;
+        if (full || entry.idy != _previous.idy)                                  header |= RECORD_IDY;
+        if (full || entry.stackP != _previous.stackP || entry.status != _previous.status) header |= RECORD_STACK;
+
+        byte        buffer[RECORD_SIZE_MAX];
+        std::size_t size = 0;
+        buffer[size++] = header;
+        if (entry.interruptType) {
+            buffer[size++] = entry.interruptType;
+        }
+        if (header & RECORD_PC) {
+            buffer[size++] = byte(entry.pc);
+            buffer[size++] = byte(entry.pc >> 8);
+        }
+        if (entry.interruptType == 0) {
+            buffer[size++] = entry.opCode;
+            for (byte i = 0; i < entry.length; i++) {
+                buffer[size++] = entry.operand[i];
+            }
+        }
+        if (header & RECORD_ADDRESS) {
+            buffer[size++] = byte(entry.address);
+            buffer[size++] = byte(entry.address >> 8);
+        }
+        if (header & RECORD_ACC) buffer[size++] = entry.acc;
+        if (header & RECORD_IDX) buffer[size++] = entry.idx;
+        if (header & RECORD_IDY) buffer[size++] = entry.idy;
+        if (header & RECORD_STACK) {
+            buffer[size++] = entry.stackP;
+            buffer[size++] = entry.status;
+        }
+        block.insert(block.end(), buffer, buffer + size);
+
+        // interrupts do not move the program counter past an instruction
+        _previous = entry;
+        _nextPC   = entry.interruptType ? 0x10000 : uint32_t(word(entry.pc + 1 + entry.length));
+    }
+
+    void TraceRecorder::clear() {
+        for (std::vector<byte> &block : _blocks) {
+            block.clear();
+            block.reserve(_blockSize);
+        }
+        _head   = 0;
+        _count  = 1;
+        _nextPC = 0x10000;
+    }
+
+    bool TraceRecorder::flush() {
+        if (_stream && _blocks[_head].empty() == false) {
+            _nextBlock();
+            if (fflush(_stream) != 0) {
+                _failed = true;
+            }
+        }
+        return _failed == false;
+    }
+
+    bool TraceRecorder::write(FILE *stream) {
+        if (_writeHeader(stream) == false) {
+            return false;
+        }
+
+        // oldest block first
+        for (std::size_t i = 0; i < _count; i++) {
+            const std::vector<byte> &block = _blocks[(_head + _blocks.size() - _count + 1 + i) % _blocks.size()];
+            if (block.empty() == false && _writeBlock(stream, block) == false) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TraceRecorder::_nextBlock() {
+        if (_stream) {
+            if (_writeBlock(_stream, _blocks[_head]) == false) {
+                _failed = true;
+            }
+        }
+        else {
+            _head  = (_head + 1) % _blocks.size();
+            _count = std::min(_count + 1, _blocks.size());
+        }
+        _blocks[_head].clear();
+    }
+
+
+    // file format -----------------------------------------------------------------------------------------------------
+
+    bool TraceRecorder::_writeHeader(FILE *stream) {
+        return fwrite(TRACE_SIGNATURE, sizeof(TRACE_SIGNATURE), 1, stream) == 1 &&
+               fwrite(&TRACE_VERSION, 1, 1, stream) == 1;
+    }
+
+    bool TraceRecorder::_writeBlock(FILE *stream, const std::vector<byte> &block) {
+        byte length[2] = { byte(block.size()), byte(block.size() >> 8) };
+        return fwrite(length, 2, 1, stream) == 1 && fwrite(block.data(), block.size(), 1, stream) == 1;
+    }
+
+    bool TraceRecorder::decode(const byte *data, std::size_t size, std::vector<Entry> &entries) {
+        if (size < sizeof(TRACE_SIGNATURE) + 1 || memcmp(data, TRACE_SIGNATURE, sizeof(TRACE_SIGNATURE)) != 0 ||
+            data[sizeof(TRACE_SIGNATURE)] != TRACE_VERSION) {
+            return false;
+        }
+
+        std::size_t offset   = sizeof(TRACE_SIGNATURE) + 1;
+        Entry       previous = {};
+        uint32_t    nextPC   = 0x10000;
+        while (offset < size) {
+            if (size - offset < 2) {
+                return false;
+            }
+            std::size_t end = offset + 2 + (data[offset] | (std::size_t(data[offset + 1]) << 8));
+            if (end > size) {
+                return false;
+            }
+
+            // each block starts with a full record, so no state carries over
+            offset += 2;
+            nextPC  = 0x10000;
+            while (offset < end) {
+                Entry entry  = previous;
+                byte  header = data[offset++];
+
+                // fields present in the record, except for the operand bytes
+                std::size_t length = (header & RECORD_LENGTH) == RECORD_INTERRUPT ? 1 : 1 + (header & RECORD_LENGTH);
+                if (header & RECORD_PC)      length += 2;
+                if (header & RECORD_ADDRESS) length += 2;
+                if (header & RECORD_ACC)     length += 1;
+                if (header & RECORD_IDX)     length += 1;
+                if (header & RECORD_IDY)     length += 1;
+                if (header & RECORD_STACK)   length += 2;
+                if (end - offset < length) {
+                    return false;
+                }
+
+                if ((header & RECORD_LENGTH) == RECORD_INTERRUPT) {
+                    entry.interruptType = data[offset++];
+                    entry.length        = 0;
+                }
+                else {
+                    entry.interruptType = 0;
+                    entry.length        = header & RECORD_LENGTH;
+                }
+
+                if (header & RECORD_PC) {
+                    entry.pc = data[offset] | (word(data[offset + 1]) << 8);
+                    offset  += 2;
+                }
+                else if (nextPC <= 0xFFFF) {
+                    entry.pc = word(nextPC);
+                }
+                else {
+                    return false;
+                }
+
+                if (entry.interruptType == 0) {
+                    entry.opCode = data[offset++];
+                    for (byte i = 0; i < entry.length; i++) {
+                        entry.operand[i] = data[offset++];
+                    }
+                }
+
+                entry.hasAddress = header & RECORD_ADDRESS;
+                entry.address    = 0x0000;
+                if (entry.hasAddress) {
+                    entry.address = data[offset] | (word(data[offset + 1]) << 8);
+                    offset       += 2;
+                }
+                if (header & RECORD_ACC) entry.acc = data[offset++];
+                if (header & RECORD_IDX) entry.idx = data[offset++];
+                if (header & RECORD_IDY) entry.idy = data[offset++];
+                if (header & RECORD_STACK) {
+                    entry.stackP = data[offset++];
+                    entry.status = data[offset++];
+                }
+
+                entries.push_back(entry);
+                previous = entry;
+                nextPC   = entry.interruptType ? 0x10000 : uint32_t(word(entry.pc + 1 + entry.length));
+            }
+        }
+        return true;
+    }
+}
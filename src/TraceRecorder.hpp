@@ -0,0 +1,119 @@
+//
+//  TraceRecorder.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_TRACE_RECORDER_HPP__
+#define __RT_6502_EMULATOR_TRACE_RECORDER_HPP__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "types.hpp"
+
+namespace rt_6502_emulator {
+
+    /// Records a trace of the operations executed by the CPU. See `CPU::setTraceRecorder`.
+    ///
+    /// Each operation is recorded as the address & bytes of the instruction (or the interrupt serviced), the
+    /// effective address & the registers after it completed. Records are delta encoded against the previous one, so
+    /// a typical instruction takes 3 to 6 bytes: the program counter is omitted if it follows on from the previous
+    /// instruction & only the registers that changed are stored.
+    ///
+    /// Records are grouped into fixed size blocks. The first record of each block is stored in full, so that each
+    /// block can be decoded on its own. The recorder either keeps the most recent blocks in a ring buffer, dropping
+    /// the oldest, or streams each block to a file as it fills up.
+    ///
+    /// Trace files start with the 7 byte signature "6502TRC" & a format version byte, followed by the blocks, each
+    /// prefixed with its length as a little endian word. Use `decode` or the `tracedump` tool to read them.
+    class TraceRecorder {
+    public:
+
+        /// A recorded operation.
+        typedef struct _Entry {
+            word pc;                            // address of the instruction, or of the next one for interrupts
+            byte interruptType;                 // `CPU::INTERRUPT_TYPE` of the interrupt serviced, 0 for instructions
+            byte opCode;                        // op code of the instruction
+            byte operand[2];                    // operand bytes following the op code
+            byte length;                        // number of operand bytes
+            bool hasAddress;                    // `true` if the addressing mode resolves an effective address
+            word address;                       // effective address
+            byte acc;                           // accumulator after the operation
+            byte idx;                           // x index register after the operation
+            byte idy;                           // y index register after the operation
+            byte stackP;                        // stack pointer after the operation
+            byte status;                        // status register after the operation
+        } Entry;
+
+
+        /// Constructs a recorder that keeps the most recent records in memory.
+        ///
+        /// @param capacity  size of the ring buffer in bytes
+        /// @param blockSize size of a block in bytes, at most 0xFFFF. the oldest block is dropped when the buffer is
+        ///                  full
+        TraceRecorder(std::size_t capacity = 1 << 20, std::size_t blockSize = 4096);
+
+        /// Constructs a recorder that streams the records to the given file. The file header is written right away.
+        ///
+        /// @param stream    the file to write to. must remain open until the recorder is destroyed
+        /// @param blockSize size of a block in bytes, at most 0xFFFF. each block is written once it fills up
+        TraceRecorder(FILE *stream, std::size_t blockSize = 4096);
+
+        /// Destructor. Writes out the last block when streaming.
+        ~TraceRecorder();
+
+
+        /// Appends a record of the given operation.
+        void record(const Entry &entry);
+
+        /// Discards all records kept in memory.
+        void clear();
+
+        /// Writes out the partially filled block when streaming. Recording continues in a new block.
+        ///
+        /// @returns `false` if writing the header or any block to the stream failed
+        bool flush();
+
+        /// Writes the records kept in memory as a trace file, oldest first.
+        ///
+        /// @param stream the file to write to
+        ///
+        /// @returns `false` if writing failed
+        bool write(FILE *stream);
+
+
+        /// Decodes the contents of a trace file.
+        ///
+        /// @param data    contents of the trace file
+        /// @param size    number of bytes in `data`
+        /// @param entries decoded records are appended to this
+        ///
+        /// @returns `false` if the data is not a valid trace
+        static bool decode(const byte *data, std::size_t size, std::vector<Entry> &entries);
+
+    private:
+
+        FILE                           *_stream;        // file to stream blocks to, `nullptr` for the ring buffer
+        std::size_t                     _blockSize;
+        std::vector<std::vector<byte> > _blocks;        // ring buffer of blocks, a single block when streaming
+        std::size_t                     _head;          // block being recorded into
+        std::size_t                     _count;         // number of blocks in use
+        Entry                           _previous;      // last record, to delta encode against
+        uint32_t                        _nextPC;        // address the next instruction follows on from, or 0x10000
+        bool                            _failed;        // set to true once writing to the stream failed
+
+        /// Starts recording into a new block, writing out or dropping the current one.
+        void _nextBlock();
+
+        /// Writes the file header to the given stream.
+        static bool _writeHeader(FILE *stream);
+
+        /// Writes a block to the given stream.
+        static bool _writeBlock(FILE *stream, const std::vector<byte> &block);
+    };
+}
+
+#endif // __RT_6502_EMULATOR_TRACE_RECORDER_HPP__
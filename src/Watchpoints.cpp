@@ -0,0 +1,95 @@
+//
+//  Watchpoints.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <assert.h>
+#include <string.h>
+#include "Watchpoints.hpp"
+#include "Bus.hpp"
+
+namespace rt_6502_emulator {
+
+    // constructor & destructor ----------------------------------------------------------------------------------------
+
+    Watchpoints::Watchpoints(Bus *bus) {
+        _nextId = 1;
+        _bus    = bus;
+        memset(_pages, 0, sizeof(_pages));
+    }
+
+    Watchpoints::~Watchpoints() {}
+
+
+    // watchpoints -----------------------------------------------------------------------------------------------------
+
+    Watchpoints::WatchpointId Watchpoints::add(word addressStart, word addressEnd, byte types, Callback callback) {
+        assert(addressEnd >= addressStart);
+
+        WatchpointId id = _nextId++;
+        _watchpoints.push_back((Watchpoint){id, addressStart, addressEnd, types, std::move(callback)});
+        _buildPages();
+        return id;
+    }
+
+    bool Watchpoints::remove(WatchpointId id) {
+        for (std::size_t i = 0; i < _watchpoints.size(); i++) {
+            if (_watchpoints[i].id == id) {
+                _watchpoints.erase(_watchpoints.begin() + i);
+                _buildPages();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Watchpoints::clear() {
+        _watchpoints.clear();
+        _buildPages();
+    }
+
+    std::size_t Watchpoints::size() {
+        return _watchpoints.size();
+    }
+
+    void Watchpoints::hit(word address, byte type) {
+
+        // collect the callbacks first, since they may add or remove watchpoints
+        std::vector<Callback> callbacks;
+        for (const Watchpoint &watchpoint : _watchpoints) {
+            if ((watchpoint.types & type) && address >= watchpoint.addressStart && address <= watchpoint.addressEnd) {
+                callbacks.push_back(watchpoint.callback);
+            }
+        }
+        for (const Callback &callback : callbacks) {
+            callback(address, type);
+        }
+    }
+
+    void Watchpoints::_buildPages() {
+        byte pages[256];
+        memset(pages, 0, sizeof(pages));
+        for (const Watchpoint &watchpoint : _watchpoints) {
+            for (uint32_t page = watchpoint.addressStart >> 8; page <= uint32_t(watchpoint.addressEnd >> 8); page++) {
+                pages[page] |= watchpoint.types;
+            }
+        }
+
+        // op code fetches are reads, so pages watched for them have their reads hooked. the bus counts hooks, so
+        // only the changes are passed on
+        for (std::size_t page = 0; page < 256; page++) {
+            bool wasRead  = (_pages[page] & (WATCH_READ | WATCH_EXECUTE)) != 0;
+            bool wasWrite = (_pages[page] & WATCH_WRITE) != 0;
+            bool read     = (pages[page]  & (WATCH_READ | WATCH_EXECUTE)) != 0;
+            bool write    = (pages[page]  & WATCH_WRITE) != 0;
+            _pages[page]  = pages[page];
+            if (_bus && (read != wasRead || write != wasWrite)) {
+                _bus->unhookPage(byte(page), wasRead && !read, wasWrite && !write);
+                _bus->hookPage(byte(page), read && !wasRead, write && !wasWrite);
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+//
+//  Watchpoints.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __RT_6502_EMULATOR_WATCHPOINTS_HPP__
+#define __RT_6502_EMULATOR_WATCHPOINTS_HPP__
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include "types.hpp"
+
+namespace rt_6502_emulator {
+
+    class Bus;
+
+    /// Watches address ranges for reads, writes & op code fetches by the CPU. See `CPU::getWatchpoints`.
+    ///
+    /// Each page of the address space has a bit per access type set if any watchpoint covers part of the page.
+    /// Watched pages are hooked on the CPU's bus, so that accesses to them miss the direct page pointers & take the
+    /// slow path, where they are matched against the watchpoints. Accesses to unwatched pages cost nothing more than
+    /// the direct pointer test they already make. Watchpoints are best kept few & narrow. Accesses made by the host
+    /// through the bus are not watched.
+    class Watchpoints {
+    public:
+
+        /// Access types. Combine to watch for more than one.
+        enum WATCH_TYPE {
+            WATCH_READ    = (1 << 0),   // reads, including op code & operand fetches
+            WATCH_WRITE   = (1 << 1),   // writes, including the dummy writes of read-modify-write instructions
+            WATCH_EXECUTE = (1 << 2),   // op code fetches
+        };
+
+        /// Callback of a watchpoint. Called after the access with the address & type of the access.
+        typedef std::function<void (word address, byte type)> Callback;
+
+        /// Identifies a watchpoint. Never 0.
+        typedef uint64_t WatchpointId;
+
+
+        /// Constructs an instance with no watchpoints.
+        ///
+        /// @param bus the bus to hook the watched pages on. see `Bus::hookPage`
+        Watchpoints(Bus *bus = nullptr);
+
+        /// Destructor
+        ~Watchpoints();
+
+
+        /// Adds a watchpoint. Watchpoints can be added & removed from callbacks.
+        ///
+        /// @param addressStart start of the address range to watch
+        /// @param addressEnd   end of the address range to watch
+        /// @param types        the access types to watch for. see `WATCH_TYPE`
+        /// @param callback     the callback to call on an access
+        ///
+        /// @returns the id of the watchpoint, to remove it with
+        WatchpointId add(word addressStart, word addressEnd, byte types, Callback callback);
+
+        /// Removes a watchpoint.
+        ///
+        /// @param id the id returned by `add`
+        ///
+        /// @returns `false` if the watchpoint was already removed
+        bool remove(WatchpointId id);
+
+        /// Removes all watchpoints.
+        void clear();
+
+        /// Gets the number of watchpoints.
+        std::size_t size();
+
+        /// Gets whether any watchpoint watches part of the given page for the given access type.
+        bool isWatched(byte page, byte type) { return _pages[page] & type; }
+
+        /// Calls back the watchpoints watching the given address for the given access type.
+        ///
+        /// @param address the address accessed
+        /// @param type    the access type
+        void hit(word address, byte type);
+
+    private:
+
+        typedef struct _Watchpoint {
+            WatchpointId id;
+            word         addressStart;
+            word         addressEnd;
+            byte         types;
+            Callback     callback;
+        } Watchpoint;
+
+        std::vector<Watchpoint> _watchpoints;
+        WatchpointId            _nextId;
+        byte                    _pages[256];    // access types watched on each page
+        Bus                    *_bus;
+
+        /// Rebuilds the access types watched on each page & hooks the pages that changed.
+        void _buildPages();
+    };
+}
+
+#endif // __RT_6502_EMULATOR_WATCHPOINTS_HPP__
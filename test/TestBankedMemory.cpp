@@ -0,0 +1,142 @@
+//
+//  TestBankedMemory.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include "TestMacros.hpp"
+#include "../src/BankedMemory.hpp"
+#include "../src/Bus.hpp"
+#include "../src/ROM.hpp"
+#include "../src/Snapshot.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static std::string _path;
+
+// 32K image of 4 banks of 8K, each byte holding the number of its bank
+static void _writeImage() {
+    char path[] = "/tmp/6502-emulator-banked-XXXXXX";
+    int  fd     = mkstemp(path);
+    _path       = path;
+
+    FILE *file = fdopen(fd, "wb");
+    for (int i = 0; i < 0x8000; i++) {
+        fputc(i / 0x2000, file);
+    }
+    fclose(file);
+}
+
+TestSetUp({
+    _writeImage();
+})
+
+TestTearDown({
+    unlink(_path.c_str());
+})
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(select, "Select", {
+
+    // 64K of RAM in 8 banks of 8K, shown in 2 slots at 0x8000 - 0xBFFF
+    std::shared_ptr<BankedMemory> memory = std::make_shared<BankedMemory>(0x10000, 0x8000, 0xBFFF, 0x2000);
+    TestAssert(memory->getBanks() == 8, "Expected 8 banks, got %u", memory->getBanks());
+    TestAssert(memory->getSlots() == 2, "Expected 2 slots, got %u", memory->getSlots());
+
+    Bus bus;
+    bus.attach(memory);
+    byte data = 0x00;
+    TestAssert(bus.write(0xA010, 0x11), "Write to bank 1 should succeed");
+    TestAssert(memory->data()[0x2010] == 0x11, "Expected write to bank 1, got 0x%02X", memory->data()[0x2010]);
+
+    // selecting a bank updates the direct page pointers
+    memory->select(1, 5);
+    TestAssert(memory->getBank(1) == 5, "Expected bank 5 in slot 1, got %u", memory->getBank(1));
+    TestAssert(bus.readPage(0xA0) == memory->data() + 0xA000, "Page should be read from bank 5");
+    TestAssert(bus.writePage(0xA0) == memory->data() + 0xA000, "Page should be written to bank 5");
+    TestAssert(bus.read(0xA010, data) && data == 0x00, "Expected 0x00 from bank 5, got 0x%02X", data);
+
+    // the same bank can be shown in both slots
+    memory->select(0, 1);
+    TestAssert(bus.read(0x8010, data) && data == 0x11, "Expected 0x11 from bank 1, got 0x%02X", data);
+    memory->select(1, 9);
+    TestAssert(memory->getBank(1) == 1, "Expected bank 9 to wrap to 1, got %u", memory->getBank(1));
+})
+
+TestCase(registers, "Registers", {
+    std::shared_ptr<BankedMemory> memory = std::make_shared<BankedMemory>(0x10000, 0x8000, 0xBFFF, 0x2000);
+    memory->addRegister(0xBFFF, 1);
+
+    Bus bus;
+    bus.attach(memory);
+    TestAssert(bus.writePage(0xBF) == nullptr, "Page of the register should be written through the device");
+    TestAssert(bus.writePage(0xBE) != nullptr, "Other pages should be written directly");
+
+    // writing to the register selects the bank
+    byte data = 0x00;
+    memory->data()[0x6000] = 0x66;
+    TestAssert(bus.write(0xBFFF, 3), "Write to the register should succeed");
+    TestAssert(memory->getBank(1) == 3, "Expected bank 3 in slot 1, got %u", memory->getBank(1));
+    TestAssert(bus.read(0xA000, data) && data == 0x66, "Expected 0x66 from bank 3, got 0x%02X", data);
+    TestAssert(memory->data()[0x7FFF] == 0x00, "Register should not be written to the memory");
+})
+
+TestCase(rom, "ROM", {
+    std::shared_ptr<MappedImage>  image  = MappedImage::map(_path);
+    std::shared_ptr<BankedMemory> memory = std::make_shared<BankedMemory>(image, 0xC000, 0xDFFF, 0x2000);
+    memory->addRegister(0xC000, 0);
+    TestAssert(memory->getBanks() == 4, "Expected 4 banks, got %u", memory->getBanks());
+
+    // banks are read straight from the mapping & only the register is written to
+    Bus bus;
+    bus.attach(memory);
+    byte data = 0xFF;
+    TestAssert(bus.read(0xC100, data) && data == 0x00, "Expected 0x00 from bank 0, got 0x%02X", data);
+    TestAssert(bus.write(0xC000, 2), "Write to the register should succeed");
+    TestAssert(bus.readPage(0xC1) == image->data() + 0x4100, "Page should be read from bank 2");
+    TestAssert(bus.read(0xC100, data) && data == 0x02, "Expected 0x02 from bank 2, got 0x%02X", data);
+    TestAssert(bus.write(0xC100, 0x00) == false, "Write to ROM should fail");
+})
+
+TestCase(snapshot, "Snapshot", {
+    std::shared_ptr<BankedMemory> memory = std::make_shared<BankedMemory>(0x8000, 0x8000, 0xBFFF, 0x2000);
+    memory->select(0, 2);
+    memory->data()[0x4000] = 0x42;
+
+    Snapshot snapshot;
+    memory->save(snapshot);
+
+    // a copy of the same configuration is restored to the same banks & contents
+    BankedMemory copy(0x8000, 0x8000, 0xBFFF, 0x2000);
+    size_t       offset = 0;
+    byte         data   = 0x00;
+    TestAssert(copy.restore(snapshot, offset), "Snapshot should be restored");
+    TestAssert(copy.getBank(0) == 2, "Expected bank 2 in slot 0, got %u", copy.getBank(0));
+    TestAssert(copy.read(0x8000, data) && data == 0x42, "Expected 0x42 from bank 2, got 0x%02X", data);
+
+    // a memory of a different configuration is not
+    BankedMemory other(0x10000, 0x8000, 0xBFFF, 0x2000);
+    offset = 0;
+    TestAssert(other.restore(snapshot, offset) == false, "Snapshot should not be restored");
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestBankedMemory, {
+    test_select();
+    test_registers();
+    test_rom();
+    test_snapshot();
+});
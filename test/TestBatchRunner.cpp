@@ -0,0 +1,137 @@
+//
+//  TestBatchRunner.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "TestMacros.hpp"
+#include "../src/BatchRunner.hpp"
+#include "../src/Watchpoints.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static std::shared_ptr<std::vector<byte> > _rom;
+
+// sums the numbers 1 to n, with n at $10 & stores the result at $12
+static const byte _program[] = {
+    0xA6, 0x10,                         // LDX $10
+    0xA9, 0x00,                         // LDA #$00
+    0xE0, 0x00,                         // CPX #$00
+    0xF0, 0x08,                         // BEQ $F010
+    0x86, 0x11,                         // STX $11
+    0x18,                               // CLC
+    0x65, 0x11,                         // ADC $11
+    0xCA,                               // DEX
+    0xD0, 0xF8,                         // BNE $F008
+    0x85, 0x12,                         // STA $12
+    0x4C, 0x12, 0xF0,                   // JMP $F012
+};
+
+TestSetUp({
+    _rom = std::make_shared<std::vector<byte> >(0x1000, 0xEA);
+    std::copy(_program, _program + sizeof(_program), _rom->begin());
+    (*_rom)[0x0FFC] = 0x00;
+    (*_rom)[0x0FFD] = 0xF0;
+})
+
+TestTearDown({
+    _rom.reset();
+})
+
+static BatchRunner::Job _job(byte n, uint64_t cycleBudget) {
+    std::shared_ptr<std::vector<byte> > ram = std::make_shared<std::vector<byte> >(0x11, 0x00);
+    (*ram)[0x10] = n;
+
+    BatchRunner::Job job;
+    job.memoryMap.push_back((BatchRunner::Region){0x0000, 0x07FF, true,  ram,  ""});
+    job.memoryMap.push_back((BatchRunner::Region){0xF000, 0xFFFF, false, _rom, ""});
+    job.cycleBudget = cycleBudget;
+    return job;
+}
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(run_job, "Run Job", {
+    BatchRunner::Result result = BatchRunner::runJob(_job(10, 100000));
+    TestAssert(result.completed, "Program should complete");
+    TestAssert(result.acc == 55, "Expected sum of 55, got %d", result.acc);
+    TestAssert(result.pc == 0xF012, "Expected trap at 0xF012, got 0x%04X", result.pc);
+})
+
+TestCase(halt, "Halt", {
+
+    // KIL in place of the first instruction
+    BatchRunner::Job job = _job(10, 100000);
+    std::shared_ptr<std::vector<byte> > rom = std::make_shared<std::vector<byte> >(*_rom);
+    (*rom)[0x0000] = 0x02;
+    job.memoryMap[1].image = rom;
+
+    BatchRunner::Result result = BatchRunner::runJob(job);
+    TestAssert(result.halted, "Program should halt");
+    TestAssert(result.completed == false, "Program should not complete");
+    TestAssert(result.cycles < 100, "Expected to stop when halted, ran %llu cycles", (unsigned long long)result.cycles);
+})
+
+TestCase(watch, "Watch", {
+
+    // stops after the first STX $11
+    BatchRunner::Job job = _job(10, 100000);
+    job.watches.push_back((BatchRunner::Watch){0x0011, 0x0011, Watchpoints::WATCH_WRITE});
+
+    BatchRunner::Result result = BatchRunner::runJob(job);
+    TestAssert(result.watched, "Program should stop on the watched write");
+    TestAssert(result.completed == false, "Program should not complete");
+    TestAssert(result.watchAddress == 0x0011, "Expected watched write to 0x0011, got 0x%04X", result.watchAddress);
+    TestAssert(result.pc == 0xF00A, "Expected to stop at 0xF00A, got 0x%04X", result.pc);
+})
+
+TestCase(cycle_budget, "Cycle Budget", {
+    BatchRunner::Result result = BatchRunner::runJob(_job(200, 100));
+    TestAssert(result.completed == false, "Program should not complete");
+    TestAssert(result.cycles >= 100 + 8, "Expected budget to be spent, ran %llu cycles",
+        (unsigned long long)result.cycles);
+    TestAssert(result.cycles < 100 + 8 + 8, "Expected to stop at the budget, ran %llu cycles",
+        (unsigned long long)result.cycles);
+})
+
+TestCase(parallel, "Parallel", {
+
+    // more jobs than threads, with varying run times
+    std::vector<BatchRunner::Job> jobs;
+    for (int i = 0; i < 500; i++) {
+        jobs.push_back(_job(byte(i), 100000));
+    }
+
+    BatchRunner runner(4);
+    std::vector<BatchRunner::Result> results = runner.run(jobs);
+    TestAssert(results.size() == jobs.size(), "Expected a result per job");
+
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+        BatchRunner::Result expected = BatchRunner::runJob(jobs[i]);
+        byte n = byte(i);
+        TestAssert(results[i].completed, "Job %zu should complete", i);
+        TestAssert(results[i].acc == byte(n * (n + 1) / 2), "Incorrect result for job %zu", i);
+        TestAssert(results[i].cycles == expected.cycles, "Cycle mismatch for job %zu", i);
+        TestAssert(results[i].memoryDigest == expected.memoryDigest, "Memory digest mismatch for job %zu", i);
+    }
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestBatchRunner, {
+    test_run_job();
+    test_halt();
+    test_watch();
+    test_cycle_budget();
+    test_parallel();
+});
@@ -0,0 +1,193 @@
+//
+//  TestBlockCache.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include "TestMacros.hpp"
+#include "TestReference.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+#include "../src/Watchpoints.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+// LDX #$00; loop: TXA; STA loop+5; LDA #$00; STA $0300,X; INX; BNE loop; KIL
+static const byte _selfModifying[] = { 0xA2, 0x00, 0x8A, 0x8D, 0x07, 0x04, 0xA9, 0x00, 0x9D, 0x00, 0x03,
+                                       0xE8, 0xD0, 0xF4, 0x02 };
+
+// CLI; loop: INX; INY; INC $10; STA $20; SED; ADC #$19; CLD; SBC #$07; STA $0280,X; PHA; PLA; JMP loop
+static const byte _straightLine[] = { 0x58, 0xE8, 0xC8, 0xE6, 0x10, 0x85, 0x20, 0xF8, 0x69, 0x19, 0xD8, 0xE9,
+                                      0x07, 0x9D, 0x80, 0x02, 0x48, 0x68, 0x4C, 0x01, 0x04 };
+
+// CLI; start: LDA #$00; STA $10; LDA #$03; STA $11; LDA #$00; STA $12; LDA #$06; STA $13; LDY #$00;
+// copy: LDA ($10),Y; STA ($12),Y; INY; CPY #$40; BNE copy; LDX #$10; add: CLC; ADC #$03; STA $20; DEX; BNE add;
+// INC $21; JMP start
+static const byte _idioms[] = { 0x58, 0xA9, 0x00, 0x85, 0x10, 0xA9, 0x03, 0x85, 0x11, 0xA9, 0x00, 0x85, 0x12,
+                                0xA9, 0x06, 0x85, 0x13, 0xA0, 0x00, 0xB1, 0x10, 0x91, 0x12, 0xC8, 0xC0, 0x40,
+                                0xD0, 0xF7, 0xA2, 0x10, 0x18, 0x69, 0x03, 0x85, 0x20, 0xCA, 0xD0, 0xF8, 0xE6,
+                                0x21, 0x4C, 0x01, 0x04 };
+
+// the interrupt handler counts the interrupts: INC $30; RTI
+static const byte _handler[] = { 0xE6, 0x30, 0x40 };
+
+TestSetUp({
+    _createCPUs();
+    _cpu->setPredecoding(true);
+})
+
+TestTearDown({
+    _destroyCPUs();
+})
+
+
+// helpers -------------------------------------------------------------------------------------------------------------
+
+/// Attaches 64K of RAM to both CPUs, after any device already attached, loads the given program at 0x0400 & resets
+/// them.
+static void _load(const byte *program, size_t length) {
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+        cpu->writeBlock(0x0400, program, length);
+        cpu->writeBlock(0x0500, _handler, sizeof(_handler));
+        cpu->write(0xFFFC, 0x00);
+        cpu->write(0xFFFD, 0x04);
+        cpu->write(0xFFFE, 0x00);
+        cpu->write(0xFFFF, 0x05);
+        cpu->reset();
+    }
+}
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(self_modifying_code, "Self-Modifying Code", {
+    TestAssert(_cpu->isPredecoding(), "Block cache should be on");
+    _load(_selfModifying, sizeof(_selfModifying));
+
+    // the store rewrites the operand of the next instruction of its own block
+    TestAssert(_compare(20000, 20000), "Expected the same results as the interpreter");
+    TestAssert(_cpu->isHalted(), "Program should run to the end");
+    for (int i = 0; i < 256; i++) {
+        byte data = 0;
+        _cpu->read(word(0x0300 + i), data);
+        TestAssert(data == i, "Expected 0x%02X at 0x%04X, got 0x%02X", i, 0x0300 + i, data);
+    }
+
+    // code changed by the host is decoded again
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->write(0x0402, 0xE8);
+        cpu->reset();
+    }
+    TestAssert(_compare(20000, 20000), "Expected the same results as the interpreter after the change");
+})
+
+TestCase(events_interrupts, "Events & Interrupts", {
+    _load(_straightLine, sizeof(_straightLine));
+
+    // events land between the instructions of a block. they raise interrupts, stop the run & write to the code
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->getScheduler().schedule(101, [cpu](uint64_t cycle) {
+            cpu->irq();
+            cpu->getScheduler().schedule(cycle + 97, [cpu](uint64_t cycle) { cpu->assertIRQ(0); });
+            cpu->getScheduler().schedule(cycle + 131, [cpu](uint64_t cycle) { cpu->releaseIRQ(0); });
+            cpu->getScheduler().schedule(cycle + 203, [cpu](uint64_t cycle) { cpu->stop(); });
+            cpu->getScheduler().schedule(cycle + 307, [cpu](uint64_t cycle) { cpu->write(0x0409, 0x01); });
+        });
+    }
+    TestAssert(_compare(2000, 113), "Expected the same results as the interpreter");
+
+    byte count = 0;
+    _cpu->read(0x0030, count);
+    TestAssert(count >= 2, "Expected the interrupts to be serviced, got %u", count);
+})
+
+TestCase(fused_idioms, "Fused Idioms", {
+    _load(_idioms, sizeof(_idioms));
+    for (CPU *cpu : { _reference, _cpu }) {
+        for (int i = 0; i < 0x40; i++) {
+            cpu->write(word(0x0300 + i), byte(i * 3 + 1));
+        }
+        cpu->write(0xFFFA, 0x00);
+        cpu->write(0xFFFB, 0x05);
+
+        // events land within the idioms & the slices end within them
+        cpu->getScheduler().schedule(53, [cpu](uint64_t cycle) {
+            cpu->irq();
+            cpu->getScheduler().schedule(cycle + 89, [cpu](uint64_t cycle) { cpu->assertIRQ(0); });
+            cpu->getScheduler().schedule(cycle + 90, [cpu](uint64_t cycle) { cpu->releaseIRQ(0); });
+            cpu->getScheduler().schedule(cycle + 211, [cpu](uint64_t cycle) { cpu->nmi(); });
+        });
+    }
+    TestAssert(_compare(3000, 7), "Expected the same results as the interpreter");
+    TestAssert(_compare(6000, 1000), "Expected the same results as the interpreter in longer slices");
+
+    for (int i = 0; i < 0x40; i++) {
+        byte data = 0;
+        _cpu->read(word(0x0600 + i), data);
+        TestAssert(data == byte(i * 3 + 1), "Expected 0x%02X at 0x%04X, got 0x%02X", i * 3 + 1, 0x0600 + i, data);
+    }
+    byte count = 0;
+    _cpu->read(0x0030, count);
+    TestAssert(count >= 2, "Expected the interrupts to be serviced, got %u", count);
+})
+
+TestCase(watchpoints, "Watchpoints", {
+    _load(_straightLine, sizeof(_straightLine));
+    TestAssert(_compare(1000, 1000), "Expected the same results as the interpreter");
+
+    // watching the code page changes how it is read
+    uint32_t hitsExpected = 0;
+    uint32_t hitsActual   = 0;
+    Watchpoints::WatchpointId reference = _reference->getWatchpoints().add(0x0400, 0x04FF,
+        Watchpoints::WATCH_EXECUTE, [&hitsExpected](word address, byte type) { hitsExpected++; });
+    Watchpoints::WatchpointId id = _cpu->getWatchpoints().add(0x0400, 0x04FF, Watchpoints::WATCH_EXECUTE,
+        [&hitsActual](word address, byte type) { hitsActual++; });
+    TestAssert(_compare(1000, 1000), "Expected the same results as the interpreter while watched");
+    TestAssert(hitsActual == hitsExpected && hitsActual > 0, "Expected %u hits, got %u", hitsExpected, hitsActual);
+
+    _reference->getWatchpoints().remove(reference);
+    _cpu->getWatchpoints().remove(id);
+    TestAssert(_compare(1000, 1000), "Expected the same results as the interpreter once unwatched");
+})
+
+TestCase(bank_switching, "Bank Switching", {
+
+    // two banks at 0x8000, selected by writing to 0x8FFF, with a routine at the same address in each
+    _attachBanks();
+    _load(_bankSwitching, sizeof(_bankSwitching));
+
+    TestAssert(_compare(20000, 20000), "Expected the same results as the interpreter");
+    TestAssert(_expectBankRoutines(), "Expected the routine of each bank to run");
+})
+
+TestCase(aliased_bank, "Aliased Bank", {
+
+    // the routine shown at 0x9000 is rewritten through 0x8000
+    _attachAliasedBank();
+    _load(_aliasedBank, sizeof(_aliasedBank));
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->write(0x0010, 0x11);
+        cpu->write(0x0020, 0x22);
+    }
+
+    TestAssert(_compare(20000, 20000), "Expected the same results as the interpreter");
+    TestAssert(_expectAliasedBank(), "Expected the rewritten routine to run");
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestBlockCache, {
+    test_self_modifying_code();
+    test_events_interrupts();
+    test_fused_idioms();
+    test_watchpoints();
+    test_bank_switching();
+    test_aliased_bank();
+})
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include "TestMacros.hpp"
+#include "../src/BankedMemory.hpp"
 #include "../src/Bus.hpp"
 #include "../src/Memory.hpp"
 
@@ -66,9 +67,123 @@ TestCase(address_range, "Address Range", {
     TestAssert(_bus->read (0xFFFF, data) == false, "Read outside range should return `false`");
 })
 
+TestCase(overlapping_devices, "Overlapping Devices", {
+
+    // ROM over the upper half of the RAM page range & a partial page device
+    _bus->attach(std::make_shared<Memory>(true, 0x0900, 0x0980));
+    std::shared_ptr<Memory> rom = std::make_shared<Memory>(false, 0x0400, 0x07FF);
+    _bus->attach(rom);
+
+    byte buffer[0x0100];
+    for (word i = 0x0000; i < 0x0100; i++) {
+        buffer[i] = 0xFF - i;
+    }
+    rom->load(buffer, 0x0400, 0x0100);
+
+    // RAM attached first takes priority for reads
+    byte data;
+    TestAssert(_bus->write(0x0400, 0x12) == true, "Write to RAM should return `true`");
+    TestAssert(_bus->read (0x0400, data) == true && data == 0x12, "Read should be served by RAM");
+
+    // partially covered page
+    TestAssert(_bus->write(0x0980, 0x34) == true,  "Write within partial page should return `true`");
+    TestAssert(_bus->read (0x0980, data) == true && data == 0x34, "Incorrect data read from partial page");
+    TestAssert(_bus->write(0x0981, 0x00) == false, "Write outside partial page should return `false`");
+    TestAssert(_bus->read (0x08FF, data) == false, "Read outside partial page should return `false`");
+})
+
+TestCase(rom_fallthrough, "ROM Fallthrough", {
+
+    // writes to a ROM attached first fall through to the RAM beneath it
+    Bus bus;
+    std::shared_ptr<Memory> rom = std::make_shared<Memory>(false, 0x0000, 0x00FF);
+    std::shared_ptr<Memory> ram = std::make_shared<Memory>(true,  0x0000, 0x00FF);
+    bus.attach(rom);
+    bus.attach(ram);
+
+    byte buffer[] = { 0xAB };
+    rom->load(buffer, 0x0010, 1);
+
+    byte data;
+    TestAssert(bus.write(0x0010, 0xCD) == true, "Write should fall through to RAM");
+    TestAssert(bus.read (0x0010, data) == true && data == 0xAB, "Read should be served by ROM");
+    TestAssert(ram->read(0x0010, data) == true && data == 0xCD, "Write should be stored in RAM");
+})
+
+TestCase(copy_on_write, "Copy On Write", {
+
+    // writing through the bus after the memory was copied must not write to the shared page directly
+    std::shared_ptr<Memory> ram = std::make_shared<Memory>(true, 0x0000, 0x0FFF);
+    Bus bus;
+    bus.attach(ram);
+    bus.write(0x0200, 0x11);
+    TestAssert(bus.writePage(0x02) != nullptr, "Page should be written directly before copying");
+
+    std::shared_ptr<Memory> copy = std::make_shared<Memory>(*ram);
+    TestAssert(bus.writePage(0x02) == nullptr, "Copying should stop direct writes to the shared pages");
+
+    byte data;
+    bus.write(0x0200, 0x22);
+    TestAssert(copy->read(0x0200, data) && data == 0x11, "Write through the bus should not affect the copy");
+    TestAssert(bus.read(0x0200, data) && data == 0x22, "Write through the bus failed");
+    TestAssert(bus.writePage(0x02) != nullptr, "Page should be written directly once unshared");
+})
+
+TestCase(block_access, "Block Access", {
+
+    // a block across RAM, a partial page device, a gap & a ROM attached before the RAM beneath it
+    std::shared_ptr<Memory> rom = std::make_shared<Memory>(false, 0x0A00, 0x0AFF);
+    _bus->attach(std::make_shared<Memory>(true, 0x0900, 0x0980));
+    _bus->attach(rom);
+    _bus->attach(std::make_shared<Memory>(true, 0x0A00, 0x0BFF));
+
+    byte buffer[0x0400];
+    for (word i = 0x0000; i < 0x0400; i++) {
+        buffer[i] = byte(0xFF - i);
+    }
+    TestAssert(_bus->writeBlock(0x0800, buffer, 0x0400) == false, "Write across the gap should return `false`");
+
+    // writes to the ROM fall through to the RAM beneath it, reads are served by the ROM
+    byte data;
+    TestAssert(_bus->read(0x0980, data) && data == buffer[0x0180], "Incorrect data written to partial page");
+    TestAssert(_bus->read(0x0B10, data) && data == buffer[0x0310], "Incorrect data written to RAM");
+    TestAssert(_bus->read(0x0A10, data) && data == 0x00, "ROM should not be written to");
+
+    byte block[0x0400];
+    TestAssert(_bus->readBlock(0x0800, block, 0x0400) == false, "Read across the gap should return `false`");
+    TestAssert(block[0x0180] == buffer[0x0180] && block[0x0181] == 0x00, "Gap should read 0x00");
+    TestAssert(block[0x0310] == buffer[0x0310], "Incorrect data read from RAM");
+
+    TestAssert(_bus->writeBlock(0x0400, buffer, 0x0400), "Write block to RAM failed");
+    TestAssert(_bus->readBlock(0x0400, block, 0x0400), "Read block from RAM failed");
+    TestAssert(block[0x0123] == buffer[0x0123], "Incorrect data read from 0x0523");
+})
+
+TestCase(span, "Span", {
+
+    // memory pages are not contiguous, banked memory is
+    std::shared_ptr<BankedMemory> banked = std::make_shared<BankedMemory>(0x4000, 0x8000, 0x9FFF, 0x2000);
+    _bus->attach(banked);
+    banked->data()[0x0123] = 0x42;
+
+    TestAssert(_bus->span(0x0010, 0x0010) == _bus->readPage(0x00) + 0x10, "Span within a page should be direct");
+    TestAssert(_bus->span(0x0800, 0x0001) == nullptr, "Unmapped span should return `nullptr`");
+
+    const byte *span = _bus->span(0x8000, 0x2000);
+    TestAssert(span == banked->data(), "Span should view the bank directly");
+    TestAssert(span[0x0123] == 0x42, "Incorrect data in span");
+    TestAssert(_bus->span(0x9F00, 0x0200) == nullptr, "Span past the end should return `nullptr`");
+})
+
 
 // test suite ----------------------------------------------------------------------------------------------------------
 
 TestSuite(TestBus, {
     test_read_write();
+    test_address_range();
+    test_overlapping_devices();
+    test_rom_fallthrough();
+    test_copy_on_write();
+    test_block_access();
+    test_span();
 });
@@ -0,0 +1,330 @@
+//
+//  TestCycleAccurate.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include "TestMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// recording memory ----------------------------------------------------------------------------------------------------
+
+/// 64K of RAM that records every bus access.
+class RecordingMemory: public Addressable {
+public:
+
+    typedef struct _Access {
+        word address;
+        byte data;
+        bool write;
+    } Access;
+
+    byte                contents[0x10000];
+    std::vector<Access> accesses;
+
+    virtual bool isReadable()   { return true; }
+    virtual bool isWritable()   { return true; }
+    virtual word addressStart() { return 0x0000; }
+    virtual word addressEnd()   { return 0xFFFF; }
+
+    virtual bool read(word address, byte &data) {
+        data = contents[address];
+        accesses.push_back((Access){address, data, false});
+        return true;
+    }
+
+    virtual bool write(word address, byte data) {
+        contents[address] = data;
+        accesses.push_back((Access){address, data, true});
+        return true;
+    }
+};
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static CPU                             *_cpu;
+static std::shared_ptr<RecordingMemory> _ram;
+
+TestSetUp({
+    _ram = std::make_shared<RecordingMemory>();
+    for (std::size_t addr = 0x0000; addr <= 0xFFFF; addr++) {
+        _ram->contents[addr] = 0xEA;
+    }
+
+    // reset to 0x0400
+    _ram->contents[0xFFFC] = 0x00;
+    _ram->contents[0xFFFD] = 0x04;
+
+    _cpu = new CPU();
+    _cpu->attach(_ram);
+    _cpu->setCycleAccurate(true);
+})
+
+TestTearDown({
+    delete _cpu;
+    _ram.reset();
+})
+
+static void _load(word address, std::initializer_list<byte> program) {
+    for (byte data : program) {
+        _ram->contents[address++] = data;
+    }
+
+    // complete the reset
+    _cpu->reset();
+    _cpu->step();
+    _ram->accesses.clear();
+}
+
+static bool _expectAccesses(std::initializer_list<RecordingMemory::Access> expected) {
+    if (_ram->accesses.size() != expected.size()) {
+        printf("        Expected %zu bus accesses, got %zu\n", expected.size(), _ram->accesses.size());
+        return false;
+    }
+
+    std::size_t i = 0;
+    for (const RecordingMemory::Access &access : expected) {
+        const RecordingMemory::Access &actual = _ram->accesses[i++];
+        if (actual.address != access.address || actual.write != access.write) {
+            printf("        Bus access %zu expected %s 0x%04X, got %s 0x%04X\n", i,
+                access.write ? "write" : "read", access.address, actual.write ? "write" : "read", actual.address);
+            return false;
+        }
+    }
+    _ram->accesses.clear();
+    return true;
+}
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(read_sequence, "Read Sequence", {
+
+    // LDY #$00; LDA $0210,Y
+    _load(0x0400, { 0xA0, 0x00, 0xB9, 0x10, 0x02 });
+    _cpu->step();
+    _ram->accesses.clear();
+
+    // one bus access per tick, no page crossing
+    for (int i = 0; i < 4; i++) {
+        _cpu->tick();
+        TestAssert(_ram->accesses.size() == std::size_t(i + 1), "Expected one bus access on tick %d", i);
+    }
+    TestAssert(_cpu->isOperationComplete(), "LDA absolute,Y should take 4 cycles");
+    TestAssert(_expectAccesses({
+        {0x0402, 0, false}, {0x0403, 0, false}, {0x0404, 0, false}, {0x0210, 0, false},
+    }), "Incorrect bus accesses for LDA absolute,Y");
+})
+
+TestCase(read_modify_write_sequence, "Read Modify Write Sequence", {
+
+    // LDX #$20; INC $02F0,X
+    _load(0x0400, { 0xA2, 0x20, 0xFE, 0xF0, 0x02 });
+    _ram->contents[0x0310] = 0x41;
+    _cpu->step();
+    _ram->accesses.clear();
+
+    // dummy read before the page is fixed & dummy write of the unmodified value
+    byte cycles = _cpu->step();
+    TestAssert(cycles == 7, "INC absolute,X should take 7 cycles, took %d", cycles);
+    TestAssert(_ram->accesses[5].data == 0x41, "Expected the unmodified value to be written back");
+    TestAssert(_expectAccesses({
+        {0x0402, 0, false}, {0x0403, 0, false}, {0x0404, 0, false}, {0x0210, 0, false},
+        {0x0310, 0, false}, {0x0310, 0, true }, {0x0310, 0, true },
+    }), "Incorrect bus accesses for INC absolute,X");
+    TestAssert(_ram->contents[0x0310] == 0x42, "Expected 0x42 at 0x0310, got 0x%02X", _ram->contents[0x0310]);
+})
+
+TestCase(illegal_sequence, "Illegal Op Code Sequence", {
+
+    // LDY #$20; DCP $02F0,Y; SHX $02F0,Y
+    _load(0x0400, { 0xA0, 0x20, 0xDB, 0xF0, 0x02, 0x9E, 0xF0, 0x02 });
+    _ram->contents[0x0310] = 0x21;
+    _cpu->step();
+    _ram->accesses.clear();
+
+    // illegal read-modify-write instructions follow the same sequence as the legal ones
+    byte cycles = _cpu->step();
+    TestAssert(cycles == 7, "DCP absolute,Y should take 7 cycles, took %d", cycles);
+    TestAssert(_expectAccesses({
+        {0x0402, 0, false}, {0x0403, 0, false}, {0x0404, 0, false}, {0x0210, 0, false},
+        {0x0310, 0, false}, {0x0310, 0, true }, {0x0310, 0, true },
+    }), "Incorrect bus accesses for DCP absolute,Y");
+    TestAssert(_ram->contents[0x0310] == 0x20, "Expected 0x20 at 0x0310, got 0x%02X", _ram->contents[0x0310]);
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_NEGATIVE, "Negative flag should be set by DCP");
+
+    // crossing a page replaces the MSB of the target address with the stored value
+    cycles = _cpu->step();
+    TestAssert(cycles == 5, "SHX absolute,Y should take 5 cycles, took %d", cycles);
+    TestAssert(_expectAccesses({
+        {0x0405, 0, false}, {0x0406, 0, false}, {0x0407, 0, false}, {0x0210, 0, false},
+        {0x0010, 0, true },
+    }), "Incorrect bus accesses for SHX absolute,Y");
+})
+
+TestCase(nop_sequence, "NOP Sequence", {
+
+    // LDX #$20; NOP $0230; NOP $02F0,X; NOP #$12
+    _load(0x0400, { 0xA2, 0x20, 0x0C, 0x30, 0x02, 0x1C, 0xF0, 0x02, 0x80, 0x12 });
+    _cpu->step();
+    _ram->accesses.clear();
+
+    // NOPs with an operand read it like LDA does & ignore the value
+    byte cycles = _cpu->step();
+    TestAssert(cycles == 4, "NOP absolute should take 4 cycles, took %d", cycles);
+    TestAssert(_expectAccesses({
+        {0x0402, 0, false}, {0x0403, 0, false}, {0x0404, 0, false}, {0x0230, 0, false},
+    }), "Incorrect bus accesses for NOP absolute");
+
+    cycles = _cpu->step();
+    TestAssert(cycles == 5, "NOP absolute,X should take 5 cycles, took %d", cycles);
+    TestAssert(_expectAccesses({
+        {0x0405, 0, false}, {0x0406, 0, false}, {0x0407, 0, false}, {0x0210, 0, false},
+        {0x0310, 0, false},
+    }), "Incorrect bus accesses for NOP absolute,X");
+
+    cycles = _cpu->step();
+    TestAssert(cycles == 2, "NOP immediate should take 2 cycles, took %d", cycles);
+    TestAssert(_expectAccesses({
+        {0x0408, 0, false}, {0x0409, 0, false},
+    }), "Incorrect bus accesses for NOP immediate");
+})
+
+TestCase(subroutine_sequence, "Subroutine Sequence", {
+
+    // JSR $0500; ... RTS
+    _load(0x0400, { 0x20, 0x00, 0x05 });
+    _ram->contents[0x0500] = 0x60;
+
+    byte cycles = _cpu->step();
+    TestAssert(cycles == 6, "JSR should take 6 cycles, took %d", cycles);
+    TestAssert(_expectAccesses({
+        {0x0400, 0, false}, {0x0401, 0, false}, {0x01FD, 0, false}, {0x01FD, 0, true },
+        {0x01FC, 0, true }, {0x0402, 0, false},
+    }), "Incorrect bus accesses for JSR");
+
+    cycles = _cpu->step();
+    TestAssert(cycles == 6, "RTS should take 6 cycles, took %d", cycles);
+    TestAssert(_expectAccesses({
+        {0x0500, 0, false}, {0x0501, 0, false}, {0x01FB, 0, false}, {0x01FC, 0, false},
+        {0x01FD, 0, false}, {0x0402, 0, false},
+    }), "Incorrect bus accesses for RTS");
+    TestAssert(_cpu->getProgramCounter() == 0x0403, "Expected return to 0x0403, got 0x%04X",
+        _cpu->getProgramCounter());
+})
+
+TestCase(equivalence, "Equivalence With Instruction Level", {
+
+    // same program on both cores
+    std::shared_ptr<Memory> memories[2];
+    CPU cpus[2];
+    for (int i = 0; i < 2; i++) {
+        memories[i] = std::make_shared<Memory>(true, 0x0000, 0xFFFF);
+        cpus[i].attach(memories[i]);
+        for (std::size_t addr = 0x0000; addr <= 0xFFFF; addr++) {
+            cpus[i].write(addr, byte(addr * 7));
+        }
+
+        word address = 0x0400;
+        for (byte data : {
+            0xA2, 0x08,                 // LDX #$08
+            0xA0, 0x00,                 // LDY #$00
+            0xB9, 0xF8, 0x04,           // LDA $04F8,Y
+            0x99, 0x00, 0x06,           // STA $0600,Y
+            0x48,                       // PHA
+            0x20, 0x30, 0x04,           // JSR $0430
+            0x68,                       // PLA
+            0xC8,                       // INY
+            0xCA,                       // DEX
+            0xD0, 0xF1,                 // BNE $0404
+            0x6C, 0x50, 0x04,           // JMP ($0450)
+        }) {
+            cpus[i].write(address++, data);
+        }
+
+        address = 0x0430;
+        for (byte data : {
+            0x1E, 0xFC, 0x05,           // ASL $05FC,X
+            0x7E, 0xFC, 0x05,           // ROR $05FC,X
+            0xE6, 0x10,                 // INC $10
+            0xB1, 0x20,                 // LDA ($20),Y
+            0x91, 0x22,                 // STA ($22),Y
+            0x60,                       // RTS
+        }) {
+            cpus[i].write(address++, data);
+        }
+
+        for (byte data : { 0x58, 0xEA, 0xEA, 0xEA }) {  // CLI; NOP; NOP; NOP
+            cpus[i].write(address++, data);
+        }
+
+        cpus[i].write(0x0450, 0x3D);    // JMP vector -> 0x043D
+        cpus[i].write(0x0451, 0x04);
+        cpus[i].write(0x0020, 0xFC);    // ($20) -> 0x04FC
+        cpus[i].write(0x0021, 0x04);
+        cpus[i].write(0x0022, 0x00);    // ($22) -> 0x0700
+        cpus[i].write(0x0023, 0x07);
+        cpus[i].write(0x0480, 0xE8);    // IRQ: INX; RTI
+        cpus[i].write(0x0481, 0x40);
+        cpus[i].write(0xFFFC, 0x00);
+        cpus[i].write(0xFFFD, 0x04);
+        cpus[i].write(0xFFFE, 0x80);
+        cpus[i].write(0xFFFF, 0x04);
+        cpus[i].reset();
+    }
+    cpus[1].setCycleAccurate(true);
+
+    bool interrupted = false;
+    for (int step = 0; step < 1000 && cpus[0].getProgramCounter() != 0x0441; step++) {
+
+        // raise an interrupt once interrupts are enabled
+        if (cpus[0].getProgramCounter() == 0x043F && interrupted == false) {
+            cpus[0].irq();
+            cpus[1].irq();
+            interrupted = true;
+        }
+
+        word pc     = cpus[0].getProgramCounter();
+        byte cycles = cpus[0].step();
+        TestAssert(cpus[1].step() == cycles, "Cycle count mismatch at 0x%04X", pc);
+        TestAssert(cpus[1].getProgramCounter() == cpus[0].getProgramCounter(), "PC mismatch at 0x%04X", pc);
+        TestAssert(cpus[1].getAccumulator()    == cpus[0].getAccumulator(),    "A mismatch at 0x%04X", pc);
+        TestAssert(cpus[1].getIndexX()         == cpus[0].getIndexX(),         "X mismatch at 0x%04X", pc);
+        TestAssert(cpus[1].getIndexY()         == cpus[0].getIndexY(),         "Y mismatch at 0x%04X", pc);
+        TestAssert(cpus[1].getStackPointer()   == cpus[0].getStackPointer(),   "SP mismatch at 0x%04X", pc);
+        TestAssert(cpus[1].getStatus()         == cpus[0].getStatus(),         "Status mismatch at 0x%04X", pc);
+    }
+    TestAssert(interrupted, "Program did not reach CLI");
+    TestAssert(cpus[0].getProgramCounter() == 0x0441, "Program did not complete");
+    TestAssert(cpus[0].getIndexX() == 0x01, "Interrupt handler did not run");
+    TestAssert(cpus[0].getCycles() == cpus[1].getCycles(), "Total cycle count mismatch");
+
+    for (std::size_t addr = 0x0000; addr <= 0xFFFF; addr++) {
+        byte data[2];
+        cpus[0].read(addr, data[0]);
+        cpus[1].read(addr, data[1]);
+        TestAssert(data[0] == data[1], "Memory mismatch at 0x%04zX", addr);
+    }
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestCycleAccurate, {
+    test_read_sequence();
+    test_read_modify_write_sequence();
+    test_illegal_sequence();
+    test_nop_sequence();
+    test_subroutine_sequence();
+    test_equivalence();
+});
@@ -0,0 +1,217 @@
+//
+//  TestExecution.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include "TestMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Bus.hpp"
+#include "../src/Memory.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static CPU *_cpu;
+
+TestSetUp({
+    _cpu = new CPU();
+    _cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+
+    // fill memory with NOPs
+    for (word addr = 0x0200; addr < 0xFFF0; addr++) {
+        _cpu->write(addr, 0xEA);
+    }
+
+    // reset to 0x0200, interrupts to 0x0300
+    _cpu->write(0xFFFA, 0x00);
+    _cpu->write(0xFFFB, 0x03);
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x02);
+    _cpu->write(0xFFFE, 0x00);
+    _cpu->write(0xFFFF, 0x03);
+    _cpu->reset();
+})
+
+TestTearDown({
+    delete _cpu;
+})
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(run_overshoot, "Run Overshoot", {
+
+    // reset takes 8 cycles
+    uint64_t overshoot = _cpu->run(7);
+    TestAssert(overshoot == 1, "Expected overshoot of 1 cycle, got %llu", (unsigned long long)overshoot);
+    TestAssert(_cpu->getProgramCounter() == 0x0200, "Program counter should be at reset vector");
+
+    // NOPs take 2 cycles each
+    overshoot = _cpu->run(5);
+    TestAssert(overshoot == 1, "Expected overshoot of 1 cycle, got %llu", (unsigned long long)overshoot);
+    TestAssert(_cpu->getProgramCounter() == 0x0203, "Expected 3 NOPs to execute");
+    TestAssert(_cpu->getCycles() == 14, "Expected 14 cycles elapsed, got %llu", (unsigned long long)_cpu->getCycles());
+})
+
+TestCase(run_after_tick, "Run After Tick", {
+
+    // start an operation with tick & complete it with run
+    _cpu->run(8);
+    _cpu->tick();
+    TestAssert(_cpu->isOperationComplete() == false, "NOP should still be in progress");
+
+    uint64_t overshoot = _cpu->run(1);
+    TestAssert(overshoot == 0, "Expected no overshoot, got %llu", (unsigned long long)overshoot);
+    TestAssert(_cpu->isOperationComplete(), "NOP should be complete");
+    TestAssert(_cpu->getProgramCounter() == 0x0201, "Expected 1 NOP to execute");
+})
+
+TestCase(run_until, "Run Until", {
+
+    // LDX #$05; loop: DEX; BNE loop
+    _cpu->write(0x0200, 0xA2);
+    _cpu->write(0x0201, 0x05);
+    _cpu->write(0x0202, 0xCA);
+    _cpu->write(0x0203, 0xD0);
+    _cpu->write(0x0204, 0xFD);
+
+    uint64_t elapsed = _cpu->runUntil([](CPU &cpu) { return cpu.getProgramCounter() == 0x0205; });
+
+    // 8 (reset) + 2 (LDX) + 5 * 2 (DEX) + 4 * 3 (BNE taken) + 2 (BNE not taken)
+    TestAssert(elapsed == 34, "Expected 34 cycles elapsed, got %llu", (unsigned long long)elapsed);
+    TestAssert(_cpu->getIndexX() == 0x00, "X register should be 0");
+
+    // limited by max cycles
+    elapsed = _cpu->runUntil([](CPU &cpu) { return false; }, 10);
+    TestAssert(elapsed == 10, "Expected 10 cycles elapsed, got %llu", (unsigned long long)elapsed);
+})
+
+TestCase(run_interrupts, "Run Interrupts", {
+    _cpu->run(8);
+
+    // maskable interrupts are disabled after reset
+    _cpu->irq();
+    _cpu->run(1);
+    TestAssert(_cpu->getProgramCounter() == 0x0201, "Masked interrupt should be ignored");
+
+    // non-maskable interrupt is serviced at the next instruction boundary
+    _cpu->nmi();
+    uint64_t overshoot = _cpu->run(1);
+    TestAssert(_cpu->getProgramCounter() == 0x0300, "Expected jump to NMI handler");
+    TestAssert(overshoot == 6, "Expected NMI to take 7 cycles, overshoot %llu", (unsigned long long)overshoot);
+})
+
+TestCase(interrupt_lines, "Interrupt Lines", {
+
+    // CLI; NOP...; handler: RTI
+    _cpu->write(0x0200, 0x58);
+    _cpu->write(0x0300, 0x40);
+    _cpu->run(8);
+
+    // the IRQ line stays asserted while any source asserts it
+    _cpu->assertIRQ(0);
+    _cpu->assertIRQ(1);
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getProgramCounter() == 0x0300, "Expected jump to IRQ handler, got 0x%04X",
+        _cpu->getProgramCounter());
+
+    _cpu->releaseIRQ(0);
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getProgramCounter() == 0x0300, "Expected IRQ while the line is asserted, got 0x%04X",
+        _cpu->getProgramCounter());
+
+    _cpu->releaseIRQ(1);
+    TestAssert(_cpu->isIRQAsserted() == false, "IRQ line should be released");
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getProgramCounter() == 0x0202, "Expected no IRQ once released, got 0x%04X",
+        _cpu->getProgramCounter());
+
+    // the NMI line only triggers on the edge
+    _cpu->assertNMI(0);
+    _cpu->step();
+    TestAssert(_cpu->getProgramCounter() == 0x0300, "Expected jump to NMI handler, got 0x%04X",
+        _cpu->getProgramCounter());
+    _cpu->step();
+
+    _cpu->assertNMI(1);
+    _cpu->step();
+    TestAssert(_cpu->getProgramCounter() == 0x0203, "Expected no NMI without an edge, got 0x%04X",
+        _cpu->getProgramCounter());
+
+    _cpu->releaseNMI(0);
+    _cpu->releaseNMI(1);
+    _cpu->assertNMI(0);
+    _cpu->step();
+    TestAssert(_cpu->getProgramCounter() == 0x0300, "Expected NMI on a new edge, got 0x%04X",
+        _cpu->getProgramCounter());
+})
+
+TestCase(halt, "Halt", {
+
+    // NOP; KIL
+    _cpu->write(0x0201, 0x02);
+    _cpu->run(8);
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->isHalted(), "CPU should be halted");
+    TestAssert(_cpu->getProgramCounter() == 0x0201, "Expected PC at the KIL, got 0x%04X", _cpu->getProgramCounter());
+
+    // interrupts are ignored & the budget elapses at once
+    _cpu->nmi();
+    uint64_t cycles = _cpu->getCycles();
+    TestAssert(_cpu->step() == 0, "Step should not execute anything");
+    TestAssert(_cpu->run(1000000) == 0, "Run should not overshoot");
+    TestAssert(_cpu->getCycles() == cycles + 1000000, "Expected the budget to elapse");
+    TestAssert(_cpu->runUntil([](CPU &cpu) { return false; }) == 0, "Run until should return at once");
+    TestAssert(_cpu->getProgramCounter() == 0x0201, "PC should not move, got 0x%04X", _cpu->getProgramCounter());
+
+    // reset recovers
+    _cpu->reset();
+    TestAssert(_cpu->isHalted() == false, "CPU should not be halted after reset");
+})
+
+TestCase(idle_loop, "Idle Loop", {
+
+    // CLI; loop: JMP loop
+    _cpu->write(0x0200, 0x58);
+    _cpu->write(0x0201, 0x4C);
+    _cpu->write(0x0202, 0x01);
+    _cpu->write(0x0203, 0x02);
+    _cpu->run(8 + 2);
+
+    // skipped in whole iterations of 3 cycles
+    uint64_t cycles    = _cpu->getCycles();
+    uint64_t overshoot = _cpu->run(1000000);
+    TestAssert(_cpu->getProgramCounter() == 0x0201, "Expected PC in the loop, got 0x%04X", _cpu->getProgramCounter());
+    TestAssert((1000000 + overshoot) % 3 == 0, "Expected whole iterations, overshoot %llu",
+        (unsigned long long)overshoot);
+    TestAssert(overshoot < 3, "Expected overshoot under an iteration, got %llu", (unsigned long long)overshoot);
+    TestAssert(_cpu->getCycles() == cycles + 1000000 + overshoot, "Cycle count should include the skipped cycles");
+
+    // an interrupt leaves the loop
+    _cpu->irq();
+    _cpu->run(1);
+    TestAssert(_cpu->getProgramCounter() == 0x0300, "Expected jump to IRQ handler, got 0x%04X",
+        _cpu->getProgramCounter());
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestExecution, {
+    test_run_overshoot();
+    test_run_after_tick();
+    test_run_until();
+    test_run_interrupts();
+    test_interrupt_lines();
+    test_halt();
+    test_idle_loop();
+});
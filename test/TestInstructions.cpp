@@ -6,6 +6,7 @@
 //  Copyright (c) 2020 Raptor Soft. All rights reserved.
 //
 
+#include <initializer_list>
 #include "TestMacros.hpp"
 #include "../src/CPU.hpp"
 #include "../src/Bus.hpp"
@@ -29,16 +30,274 @@ TestTearDown({
     delete _cpu;
 })
 
+static void _load(word address, std::initializer_list<byte> program) {
+    for (byte data : program) {
+        _cpu->write(address++, data);
+    }
+
+    // complete the reset
+    _cpu->reset();
+    _cpu->step();
+}
+
 
 // test cases ----------------------------------------------------------------------------------------------------------
 
 TestCase(LDA, "LDA", {
 
-    // LDA #$20
-    _cpu->write(0x0000, 0xA9);
-    _cpu->write(0x0001, 0x20);
+    // LDA #$20; LDA $10; LDX #$01; LDA $02FF,X
+    _cpu->write(0x0010, 0x80);
+    _cpu->write(0x0300, 0x00);
+    _load(0x0000, { 0xA9, 0x20, 0xA5, 0x10, 0xA2, 0x01, 0xBD, 0xFF, 0x02 });
+
+    byte cycles = _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x20, "Accumulator should be 0x20, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(cycles == 2, "LDA immediate should take 2 cycles, took %d", cycles);
+
+    cycles = _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x80, "Accumulator should be 0x80, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_NEGATIVE, "Negative flag should be set");
+    TestAssert(cycles == 3, "LDA zero page should take 3 cycles, took %d", cycles);
+
+    _cpu->step();
+    cycles = _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x00, "Accumulator should be 0x00, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_ZERO, "Zero flag should be set");
+    TestAssert(cycles == 5, "LDA absolute,X crossing a page should take 5 cycles, took %d", cycles);
+})
+
+TestCase(STA, "STA", {
+
+    // LDA #$42; LDY #$10; STA $0200,Y
+    _load(0x0000, { 0xA9, 0x42, 0xA0, 0x10, 0x99, 0x00, 0x02 });
+
+    _cpu->step();
+    _cpu->step();
+    byte cycles = _cpu->step();
+
+    byte data;
+    _cpu->read(0x0210, data);
+    TestAssert(data == 0x42, "Expected 0x42 at 0x0210, got 0x%02X", data);
+    TestAssert(cycles == 5, "STA absolute,Y should take 5 cycles, took %d", cycles);
+})
+
+TestCase(ADC, "ADC", {
+
+    // CLC; LDA #$7F; ADC #$01; ADC #$80
+    _load(0x0000, { 0x18, 0xA9, 0x7F, 0x69, 0x01, 0x69, 0x80 });
+
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x80, "Accumulator should be 0x80, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_OVERFLOW, "Overflow flag should be set");
+    TestAssert((_cpu->getStatus() & CPU::STATUS_FLAG_CARRY) == 0, "Carry flag should be clear");
+
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x00, "Accumulator should be 0x00, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set");
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_ZERO, "Zero flag should be set");
+})
+
+TestCase(decimal, "Decimal Mode", {
+
+    // SED; CLC; LDA #$58; ADC #$46; ADC #$01; LDA #$99; CLC; ADC #$01; SEC; LDA #$21; SBC #$34
+    _load(0x0000, { 0xF8, 0x18, 0xA9, 0x58, 0x69, 0x46, 0x69, 0x01, 0xA9, 0x99, 0x18, 0x69, 0x01,
+                    0x38, 0xA9, 0x21, 0xE9, 0x34 });
+
+    for (int i = 0; i < 4; i++) {
+        _cpu->step();
+    }
+    TestAssert(_cpu->getAccumulator() == 0x04, "Accumulator should be 0x04, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set");
+
+    byte cycles = _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x06, "Accumulator should be 0x06, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(cycles == 2, "Decimal ADC immediate should take 2 cycles, took %d", cycles);
+
+    // NMOS quirk: zero is set from the binary sum & negative before the high nibble is adjusted
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x00, "Accumulator should be 0x00, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set");
+    TestAssert((_cpu->getStatus() & CPU::STATUS_FLAG_ZERO) == 0, "Zero flag should be clear");
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_NEGATIVE, "Negative flag should be set");
+
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x87, "Accumulator should be 0x87, got 0x%02X", _cpu->getAccumulator());
+    TestAssert((_cpu->getStatus() & CPU::STATUS_FLAG_CARRY) == 0, "Carry flag should be clear");
+})
+
+TestCase(BNE, "BNE", {
+
+    // LDX #$01; BNE +$7F (taken across a page); ... DEX; BNE (not taken)
+    _load(0x00F0, { 0xA2, 0x01, 0xD0, 0x7F });
+    _cpu->write(0x0173, 0xCA);
+    _cpu->write(0x0174, 0xD0);
+    _cpu->write(0x0175, 0x00);
+    _cpu->write(0xFFFC, 0xF0);
+    _cpu->reset();
+    _cpu->step();
+
+    _cpu->step();
+    byte cycles = _cpu->step();
+    TestAssert(_cpu->getProgramCounter() == 0x0173, "Expected branch to 0x0173, got 0x%04X", _cpu->getProgramCounter());
+    TestAssert(cycles == 4, "Branch taken across a page should take 4 cycles, took %d", cycles);
+
+    _cpu->step();
+    cycles = _cpu->step();
+    TestAssert(_cpu->getProgramCounter() == 0x0176, "Expected no branch, got 0x%04X", _cpu->getProgramCounter());
+    TestAssert(cycles == 2, "Branch not taken should take 2 cycles, took %d", cycles);
+})
+
+TestCase(SBC, "SBC & CMP", {
+
+    // SEC; LDA #$50; SBC #$10; CMP #$40; LDA #$81; ASL A
+    _load(0x0000, { 0x38, 0xA9, 0x50, 0xE9, 0x10, 0xC9, 0x40, 0xA9, 0x81, 0x0A });
+
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x40, "Accumulator should be 0x40, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set");
+    TestAssert((_cpu->getStatus() & CPU::STATUS_FLAG_OVERFLOW) == 0, "Overflow flag should be clear");
+
+    _cpu->step();
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_ZERO, "Zero flag should be set");
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set on equal");
+
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x02, "Accumulator should be 0x02, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set by ASL");
+})
+
+TestCase(status_flags, "Status Flags", {
+
+    // LDA #$7F; ADC #$01; LDA #$00; PHP; CMP #$00; ROL A; PHP; LDA #$FF; PHA; PLP; LSR A
+    _load(0x0000, { 0xA9, 0x7F, 0x69, 0x01, 0xA9, 0x00, 0x08, 0xC9, 0x00, 0x2A, 0x08, 0xA9, 0xFF, 0x48, 0x28,
+                    0x4A });
+
+    // the carry & overflow of the addition outlive the load, which only sets zero & negative
+    byte data;
+    for (int i = 0; i < 4; i++) {
+        _cpu->step();
+    }
+    _cpu->read(0x0100 | byte(_cpu->getStackPointer() + 1), data);
+    TestAssert(data == 0x76, "PHP should push 0x76, pushed 0x%02X", data);
+
+    // the carry of the comparison is rotated in & replaced by the bit rotated out
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    _cpu->read(0x0100 | byte(_cpu->getStackPointer() + 1), data);
+    TestAssert(_cpu->getAccumulator() == 0x01, "Accumulator should be 0x01, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(data == 0x74, "PHP should push 0x74, pushed 0x%02X", data);
+
+    // PLP replaces all the flags, LSR then sets carry from the bit shifted out
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getStatus() == 0xEF, "Status should be 0xEF after PLP, got 0x%02X", _cpu->getStatus());
+    _cpu->step();
+    TestAssert(_cpu->getStatus() == 0x6D, "Status should be 0x6D after LSR, got 0x%02X", _cpu->getStatus());
+})
+
+TestCase(illegal_read_modify_write, "Illegal Read Modify Write", {
+
+    // LDA #$01; SLO $0200; LDY #$01; DCP $0200,Y; SEC; ISC $0202
+    _cpu->write(0x0200, 0x81);
+    _cpu->write(0x0201, 0x43);
+    _cpu->write(0x0202, 0x7F);
+    _load(0x0000, { 0xA9, 0x01, 0x0F, 0x00, 0x02, 0xA0, 0x01, 0xDB, 0x00, 0x02, 0x38, 0xEF, 0x02, 0x02 });
+
+    byte data;
+    _cpu->step();
+    byte cycles = _cpu->step();
+    _cpu->read(0x0200, data);
+    TestAssert(data == 0x02, "Expected 0x02 at 0x0200, got 0x%02X", data);
+    TestAssert(_cpu->getAccumulator() == 0x03, "Accumulator should be 0x03, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set by SLO");
+    TestAssert(cycles == 6, "SLO absolute should take 6 cycles, took %d", cycles);
+
+    _cpu->step();
+    cycles = _cpu->step();
+    _cpu->read(0x0201, data);
+    TestAssert(data == 0x42, "Expected 0x42 at 0x0201, got 0x%02X", data);
+    TestAssert((_cpu->getStatus() & CPU::STATUS_FLAG_CARRY) == 0, "Carry flag should be clear after DCP");
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_NEGATIVE, "Negative flag should be set after DCP");
+    TestAssert(cycles == 7, "DCP absolute,Y should take 7 cycles, took %d", cycles);
+
+    _cpu->step();
+    _cpu->step();
+    _cpu->read(0x0202, data);
+    TestAssert(data == 0x80, "Expected 0x80 at 0x0202, got 0x%02X", data);
+    TestAssert(_cpu->getAccumulator() == 0x83, "Accumulator should be 0x83, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_OVERFLOW, "Overflow flag should be set after ISC");
+    TestAssert((_cpu->getStatus() & CPU::STATUS_FLAG_CARRY) == 0, "Carry flag should be clear after ISC");
+})
+
+TestCase(illegal_immediate, "Illegal Immediate", {
+
+    // LDA #$F0; ANC #$8F; ALR #$03; LDA #$FF; SEC; ARR #$C0; LDX #$0F; LDA #$FF; AXS #$05
+    _load(0x0000, { 0xA9, 0xF0, 0x0B, 0x8F, 0x4B, 0x03, 0xA9, 0xFF, 0x38, 0x6B, 0xC0,
+                    0xA2, 0x0F, 0xA9, 0xFF, 0xCB, 0x05 });
+
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x80, "Accumulator should be 0x80, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set by ANC");
+
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x00, "Accumulator should be 0x00, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_ZERO, "Zero flag should be set by ALR");
+    TestAssert((_cpu->getStatus() & CPU::STATUS_FLAG_CARRY) == 0, "Carry flag should be clear after ALR");
+
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0xE0, "Accumulator should be 0xE0, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set from bit 6 by ARR");
+    TestAssert((_cpu->getStatus() & CPU::STATUS_FLAG_OVERFLOW) == 0, "Overflow flag should be clear after ARR");
+
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_cpu->getIndexX() == 0x0A, "Index X should be 0x0A, got 0x%02X", _cpu->getIndexX());
+    TestAssert(_cpu->getStatus() & CPU::STATUS_FLAG_CARRY, "Carry flag should be set by AXS");
+})
+
+TestCase(illegal_load_store, "Illegal Load & Store", {
+
+    // LDY #$01; LAX $01FF,Y; LDA #$0F; SAX $10; LAS $0200,Y; SHY $0210,X
+    _cpu->write(0x0200, 0x99);
+    _cpu->write(0x0201, 0x3C);
+    _load(0x0000, { 0xA0, 0x01, 0xBF, 0xFF, 0x01, 0xA9, 0x0F, 0x87, 0x10, 0xBB, 0x00, 0x02, 0x9C, 0x10, 0x02 });
+
+    byte data;
+    _cpu->step();
+    byte cycles = _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x99, "Accumulator should be 0x99, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getIndexX() == 0x99, "Index X should be 0x99, got 0x%02X", _cpu->getIndexX());
+    TestAssert(cycles == 5, "LAX absolute,Y crossing a page should take 5 cycles, took %d", cycles);
+
+    _cpu->step();
+    _cpu->step();
+    _cpu->read(0x0010, data);
+    TestAssert(data == 0x09, "Expected 0x09 at 0x0010, got 0x%02X", data);
 
+    cycles = _cpu->step();
+    TestAssert(_cpu->getAccumulator() == 0x3C, "Accumulator should be 0x3C, got 0x%02X", _cpu->getAccumulator());
+    TestAssert(_cpu->getStackPointer() == 0x3C, "Stack pointer should be 0x3C, got 0x%02X", _cpu->getStackPointer());
+    TestAssert(cycles == 4, "LAS absolute,Y should take 4 cycles, took %d", cycles);
 
+    cycles = _cpu->step();
+    _cpu->read(0x024C, data);
+    TestAssert(data == 0x01, "Expected 0x01 at 0x024C, got 0x%02X", data);
+    TestAssert(cycles == 5, "SHY absolute,X should take 5 cycles, took %d", cycles);
 })
 
 
@@ -46,4 +305,13 @@ TestCase(LDA, "LDA", {
 
 TestSuite(TestInstructions, {
     test_LDA();
+    test_STA();
+    test_ADC();
+    test_decimal();
+    test_BNE();
+    test_SBC();
+    test_status_flags();
+    test_illegal_read_modify_write();
+    test_illegal_immediate();
+    test_illegal_load_store();
 });
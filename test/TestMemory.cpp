@@ -102,6 +102,59 @@ TestCase(load, "Load", {
     }
 })
 
+TestCase(copy_on_write, "Copy On Write", {
+
+    // copies share the contents of the original
+    _ram->write(0x0010, 0x11);
+    _ram->write(0x0110, 0x22);
+    Memory copy(*_ram);
+
+    byte data;
+    TestAssert(copy.read(0x0010, data) && data == 0x11, "Copy should read the contents of the original");
+    TestAssert(copy.readPage(0x00) == _ram->readPage(0x00), "Copy should share pages with the original");
+    TestAssert(copy.writePage(0x00) == nullptr, "Shared pages should not be written directly");
+    TestAssert(_ram->writePage(0x00) == nullptr, "Shared pages should not be written directly by the original");
+
+    // writes to either one unshare the page written to
+    copy.write(0x0010, 0x33);
+    _ram->write(0x0110, 0x44);
+    TestAssert(_ram->read(0x0010, data) && data == 0x11, "Write to copy should not affect the original");
+    TestAssert(copy.read(0x0110, data) && data == 0x22, "Write to original should not affect the copy");
+    TestAssert(copy.readPage(0x00) != _ram->readPage(0x00), "Written page should no longer be shared");
+    TestAssert(copy.writePage(0x00) != nullptr, "Unshared page should be written directly");
+    TestAssert(copy.readPage(0x02) == _ram->readPage(0x02), "Pages not written should still be shared");
+})
+
+TestCase(block_access, "Block Access", {
+
+    // blocks spanning pages, partly outside the address space
+    byte buffer[0x0300];
+    for (word i = 0x0000; i < 0x0300; i++) {
+        buffer[i] = byte(i * 7);
+    }
+    TestAssert(_ram->writeBlock(0x0080, buffer, 0x0300), "Write block failed");
+    TestAssert(_ram->writeBlock(0x0700, buffer, 0x0200) == false, "Write past the end should return `false`");
+    TestAssert(_rom->writeBlock(0x0000, buffer, 0x0010) == false, "Write to ROM should return `false`");
+
+    byte data;
+    TestAssert(_ram->read(0x0285, data) && data == buffer[0x0205], "Incorrect data written to 0x0285");
+    TestAssert(_ram->read(0x07FF, data) && data == buffer[0x00FF], "Incorrect data written to 0x07FF");
+
+    byte block[0x0300];
+    TestAssert(_ram->readBlock(0x0080, block, 0x0300), "Read block failed");
+    for (word i = 0x0000; i < 0x0300; i++) {
+        TestAssert(block[i] == buffer[i], "Incorrect data read from address 0x%04X", 0x0080 + i);
+    }
+    TestAssert(_ram->readBlock(0x07FF, block, 0x0002) == false, "Read past the end should return `false`");
+    TestAssert(block[0] == buffer[0x00FF] && block[1] == 0x00, "Bytes past the end should read 0x00");
+
+    // writing a block to a copy unshares only the pages written to
+    Memory copy(*_ram);
+    TestAssert(copy.writeBlock(0x0100, buffer, 0x0100), "Write block to copy failed");
+    TestAssert(_ram->read(0x0100, data) && data == buffer[0x0080], "Write to copy should not affect the original");
+    TestAssert(copy.readPage(0x02) == _ram->readPage(0x02), "Pages not written should still be shared");
+})
+
 
 // test suite ----------------------------------------------------------------------------------------------------------
 
@@ -110,4 +163,6 @@ TestSuite(TestMemory, {
     test_address_range();
     test_rom_mode();
     test_load();
+    test_copy_on_write();
+    test_block_access();
 });
@@ -0,0 +1,190 @@
+//
+//  TestProfiler.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "TestMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+#include "../src/Profiler.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static CPU *_cpu;
+
+TestSetUp({
+    _cpu = new CPU();
+    _cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+
+    word address = 0x0400;
+    for (byte data : {
+        0x58,                           // CLI
+        0xA2, 0x01,                     // LDX #$01
+        0x20, 0x20, 0x04,               // JSR $0420
+        0xCA,                           // DEX
+        0x10, 0xFA,                     // BPL $0403
+        0x4C, 0x09, 0x04,               // JMP $0409
+    }) {
+        _cpu->write(address++, data);
+    }
+
+    address = 0x0420;
+    for (byte data : {
+        0xBD, 0xFF, 0x04,               // LDA $04FF,X
+        0x20, 0x30, 0x04,               // JSR $0430
+        0x60,                           // RTS
+    }) {
+        _cpu->write(address++, data);
+    }
+
+    address = 0x0430;
+    for (byte data : {
+        0xEA,                           // NOP
+        0x60,                           // RTS
+    }) {
+        _cpu->write(address++, data);
+    }
+
+    _cpu->write(0x0480, 0x40);          // IRQ: RTI
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x04);
+    _cpu->write(0xFFFE, 0x80);
+    _cpu->write(0xFFFF, 0x04);
+    _cpu->reset();
+    _cpu->step();
+})
+
+TestTearDown({
+    delete _cpu;
+})
+
+/// Runs the program up to the JMP in place, then services an interrupt.
+static void _run() {
+    while (_cpu->getProgramCounter() != 0x0409) {
+        _cpu->step();
+    }
+    _cpu->irq();
+    _cpu->step();
+    _cpu->step();
+}
+
+/// Gets the folded stacks written by the given profiler.
+static std::string _folded(Profiler &profiler) {
+    FILE *file = tmpfile();
+    profiler.writeFolded(file);
+    fseek(file, 0, SEEK_SET);
+    std::string folded;
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), file)) {
+        folded += buffer;
+    }
+    fclose(file);
+    return folded;
+}
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+#ifndef RT_6502_EMULATOR_NO_TRACE
+TestCase(counts, "Counts", {
+    std::shared_ptr<Profiler> profiler = std::make_shared<Profiler>();
+    _cpu->setProfiler(profiler);
+    _run();
+
+    TestAssert(profiler->getOpCodeExecutions(0x20) == 4, "Expected 4 JSRs, got %llu",
+        (unsigned long long)profiler->getOpCodeExecutions(0x20));
+    TestAssert(profiler->getOpCodeCycles(0x20) == 24, "Expected 24 JSR cycles");
+    TestAssert(profiler->getAddressExecutions(0x0430) == 2, "Expected NOP at 0x0430 to run twice");
+    TestAssert(profiler->getAddressCycles(0x0430) == 4, "Expected NOP at 0x0430 to take 4 cycles");
+    TestAssert(profiler->getInterrupts() == 1 && profiler->getInterruptCycles() == 7, "Expected one interrupt");
+
+    // LDA $04FF,X crosses a page when X is 1 but not when X is 0
+    TestAssert(profiler->getOpCodeExecutions(0xBD) == 2, "Expected 2 executions of LDA absolute,X");
+    TestAssert(profiler->getOpCodePageCrossings(0xBD) == 1, "Expected 1 page crossing for LDA absolute,X");
+    TestAssert(profiler->getOpCodeCycles(0xBD) == 9, "Expected 9 cycles for LDA absolute,X");
+    TestAssert(profiler->getOpCodePageCrossings(0x10) == 0, "Expected no page crossings for BPL");
+})
+#endif
+
+TestCase(cores, "Both Cores", {
+
+    // both cores count the same cycles
+    std::shared_ptr<Profiler> profilers[2];
+    for (int i = 0; i < 2; i++) {
+        profilers[i] = std::make_shared<Profiler>();
+        _cpu->reset();
+        _cpu->step();
+        _cpu->setCycleAccurate(i == 1);
+        _cpu->setProfiler(profilers[i]);
+        _run();
+    }
+    for (int opCode = 0; opCode < 256; opCode++) {
+        TestAssert(profilers[0]->getOpCodeCycles(opCode) == profilers[1]->getOpCodeCycles(opCode),
+            "Cycle mismatch for op code 0x%02X", opCode);
+        TestAssert(profilers[0]->getOpCodePageCrossings(opCode) == profilers[1]->getOpCodePageCrossings(opCode),
+            "Page crossing mismatch for op code 0x%02X", opCode);
+    }
+})
+
+#ifndef RT_6502_EMULATOR_NO_TRACE
+TestCase(folded, "Folded Stacks", {
+    std::shared_ptr<Profiler> profiler = std::make_shared<Profiler>();
+    _cpu->setProfiler(profiler);
+    _run();
+    std::string folded = _folded(*profiler);
+
+    // NOP & RTS, twice, and RTI
+    TestAssert(folded.find("root;$0420;$0430 16\n") != std::string::npos, "Missing nested call stack in:\n%s",
+        folded.c_str());
+    TestAssert(folded.find("root;interrupt@$0480 6\n") != std::string::npos, "Missing interrupt call stack");
+
+    // the flat profile lists the op codes
+    FILE *file = tmpfile();
+    profiler->writeFlat(file);
+    TestAssert(ftell(file) > 0, "Flat profile is empty");
+    fclose(file);
+})
+#endif
+
+TestCase(deep_recursion, "Deep Recursion", {
+    Profiler profiler;
+
+    // JSR $0500, which recurses 300 times from $0503 past the deepest call stack tracked, returns & runs a NOP
+    profiler.record(0x0400, 0x0500, 0x20, 0, 6, false);
+    for (int i = 0; i < 300; i++) {
+        profiler.record(0x0503, 0x0503, 0x20, 0, 6, false);
+    }
+    for (int i = 0; i < 300; i++) {
+        profiler.record(0x0506, 0x0506, 0x60, 0, 6, false);
+    }
+    profiler.record(0x0506, 0x0507, 0xEA, 0, 2, false);
+
+    // the NOP runs in $0500, not in the root
+    std::string folded = _folded(profiler);
+    TestAssert(folded.find("root 6\n") == 0, "Expected the root to take 6 cycles in:\n%s", folded.c_str());
+    TestAssert(folded.find("root;$0500 8\n") != std::string::npos, "Expected $0500 to take 8 cycles in:\n%s",
+        folded.c_str());
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestProfiler, {
+#ifndef RT_6502_EMULATOR_NO_TRACE
+    test_counts();
+#endif
+    test_cores();
+#ifndef RT_6502_EMULATOR_NO_TRACE
+    test_folded();
+#endif
+    test_deep_recursion();
+});
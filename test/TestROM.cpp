@@ -0,0 +1,98 @@
+//
+//  TestROM.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include "TestMacros.hpp"
+#include "../src/BatchRunner.hpp"
+#include "../src/Bus.hpp"
+#include "../src/ROM.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static std::string _path;
+
+// 4K image with the reset vector at the end: LDA #$42; STA $10; JMP $F004
+static void _writeImage() {
+    char path[] = "/tmp/6502-emulator-rom-XXXXXX";
+    int  fd     = mkstemp(path);
+    _path       = path;
+
+    byte image[0x1000];
+    for (std::size_t i = 0; i < sizeof(image); i++) {
+        image[i] = byte(i);
+    }
+    const byte program[] = { 0xA9, 0x42, 0x85, 0x10, 0x4C, 0x04, 0xF0 };
+    std::copy(program, program + sizeof(program), image);
+    image[0x0FFC] = 0x00;
+    image[0x0FFD] = 0xF0;
+
+    FILE *file = fdopen(fd, "wb");
+    fwrite(image, 1, sizeof(image), file);
+    fclose(file);
+}
+
+TestSetUp({
+    _writeImage();
+})
+
+TestTearDown({
+    unlink(_path.c_str());
+})
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(map, "Map", {
+    std::shared_ptr<ROM> rom = ROM::map(_path, 0xF000);
+    TestAssert(rom != nullptr, "Image should be mapped");
+    TestAssert(rom->addressEnd() == 0xFFFF, "Expected ROM to end at 0xFFFF, got 0x%04X", rom->addressEnd());
+
+    // the mapping is shared
+    std::shared_ptr<ROM> other = ROM::map(_path, 0x1000, 0x17FF);
+    TestAssert(other->getImage() == rom->getImage(), "Mappings of the same file should be shared");
+    TestAssert(other->addressEnd() == 0x17FF, "Expected ROM to end at 0x17FF, got 0x%04X", other->addressEnd());
+
+    // reads are served directly from the mapping & writes are ignored
+    Bus bus;
+    bus.attach(rom);
+    byte data = 0x00;
+    TestAssert(bus.readPage(0xF1) == rom->getImage()->data() + 0x0100, "Page should be read from the mapping");
+    TestAssert(bus.read(0xF123, data) && data == 0x23, "Expected 0x23 at 0xF123, got 0x%02X", data);
+    TestAssert(bus.write(0xF123, 0x00) == false, "Write to ROM should fail");
+    TestAssert(bus.read(0xF123, data) && data == 0x23, "ROM should not be written to");
+
+    TestAssert(ROM::map(_path + ".missing", 0xF000) == nullptr, "Missing file should not be mapped");
+})
+
+TestCase(batch_runner, "Batch Runner", {
+    std::shared_ptr<std::vector<byte> > ram = std::make_shared<std::vector<byte> >(0x100, 0x00);
+
+    BatchRunner::Job job;
+    job.memoryMap.push_back((BatchRunner::Region){0x0000, 0x07FF, true,  ram, ""});
+    job.memoryMap.push_back((BatchRunner::Region){0xF000, 0xFFFF, false, nullptr, _path});
+    job.cycleBudget = 1000;
+
+    BatchRunner::Result result = BatchRunner::runJob(job);
+    TestAssert(result.completed, "Program should complete");
+    TestAssert(result.acc == 0x42, "Expected 0x42 in the accumulator, got 0x%02X", result.acc);
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestROM, {
+    test_map();
+    test_batch_runner();
+});
@@ -0,0 +1,272 @@
+//
+//  TestRecompiler.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <string.h>
+#include <vector>
+#include "TestMacros.hpp"
+#include "TestReference.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+#include "../src/Recompiler.hpp"
+#include "../src/Watchpoints.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+// LDX #$00; loop: LDA #$00; STA $0300,X; INC loop+1; INX; BNE loop; KIL
+static const byte _selfModifying[] = { 0xA2, 0x00, 0xA9, 0x00, 0x9D, 0x00, 0x03, 0xEE, 0x03, 0x04,
+                                       0xE8, 0xD0, 0xF5, 0x02 };
+
+TestSetUp({
+    _createCPUs();
+    _cpu->setRecompiling(true);
+})
+
+TestTearDown({
+    _destroyCPUs();
+})
+
+
+// helpers -------------------------------------------------------------------------------------------------------------
+
+/// I/O registers with side effects. Reads return a running count, writes raise & lower the IRQ line or schedule an
+/// event raising it later.
+class Registers: public Addressable {
+public:
+    Registers(CPU *cpu): _cpu(cpu), _count(0) {}
+
+    virtual bool isReadable()   { return true; }
+    virtual bool isWritable()   { return true; }
+    virtual word addressStart() { return 0xC000; }
+    virtual word addressEnd()   { return 0xCFFF; }
+
+    virtual bool read(word address, byte &data) {
+        data = _count++;
+        return true;
+    }
+
+    virtual bool write(word address, byte data) {
+        CPU *cpu = _cpu;
+        switch (address & 0x0003) {
+            case 0: cpu->assertIRQ(0);  break;
+            case 1: cpu->releaseIRQ(0); break;
+            case 2: cpu->getScheduler().schedule(cpu->getCycles() + data, [cpu](uint64_t cycle) { cpu->irq(); });
+                    break;
+            case 3: _count = data;      break;
+        }
+        return true;
+    }
+
+private:
+    CPU *_cpu;
+    byte _count;
+};
+
+/// Pseudo random numbers, the same on every host.
+static uint32_t _random(uint32_t &seed) {
+    seed = seed * 1664525 + 1013904223;
+    return seed >> 16;
+}
+
+/// Gets the length in bytes of the instruction with the given op code.
+static word _length(byte code) {
+    bool odd = (code & 0x10) != 0;
+    switch (code & 0x0F) {
+        case 0x00: return code == 0x20 ? 3 : (odd || code >= 0x80) ? 2 : 1;
+        case 0x02: return (code >= 0x80 && odd == false) ? 2 : 1;
+        case 0x08:
+        case 0x0A: return 1;
+        case 0x09:
+        case 0x0B: return odd ? 3 : 2;
+        case 0x0C:
+        case 0x0D:
+        case 0x0E:
+        case 0x0F: return 3;
+        default:   return 2;
+    }
+}
+
+/// Fills the memory with random data & a loop of random instructions at 0x0400. Control flow is limited to branches
+/// to the next instruction, which end blocks whether taken or not, & the loop itself.
+static void _randomProgram(uint32_t seed, std::vector<byte> &memory) {
+    memory.resize(0x10000);
+    for (byte &data : memory) {
+        data = byte(_random(seed));
+    }
+
+    // LDX #$10; body; DEX; BNE body; JMP $0400
+    word address = 0x0400;
+    memory[address++] = 0xA2;
+    memory[address++] = 0x10;
+    while (address < 0x0470) {
+        byte code = byte(_random(seed));
+        if ((code & 0x1F) == 0x10) {
+            memory[address++] = code;
+            memory[address++] = 0x00;
+            continue;
+        }
+        if ((code & 0x0F) == 0x02 && code < 0x80) continue;      // KIL
+        if (code == 0x92 || code == 0xB2 || code == 0xD2 || code == 0xF2) continue;
+        if (code == 0x00 || code == 0x20 || code == 0x40 || code == 0x60 || code == 0x4C || code == 0x6C) continue;
+
+        memory[address] = code;
+        for (word i = 1; i < _length(code); i++) {
+            memory[address + i] = byte(_random(seed));
+        }
+        address += _length(code);
+    }
+    memory[address++] = 0xCA;
+    memory[address++] = 0xD0;
+    memory[address]   = byte(0x0402 - (address + 1));
+    address++;
+    memory[address++] = 0x4C;
+    memory[address++] = 0x00;
+    memory[address++] = 0x04;
+
+    // the interrupt handlers return straight away
+    memory[0x0300] = 0x40;
+    memory[0xFFFA] = 0x00;
+    memory[0xFFFB] = 0x03;
+    memory[0xFFFC] = 0x00;
+    memory[0xFFFD] = 0x04;
+    memory[0xFFFE] = 0x00;
+    memory[0xFFFF] = 0x03;
+}
+
+/// Loads the given memory & resets the CPU.
+static void _load(CPU *cpu, const std::vector<byte> &memory) {
+    cpu->writeBlock(0x0000, memory.data(), memory.size());
+    cpu->reset();
+}
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(random_programs, "Random Programs", {
+    if (Recompiler::isSupported() == false) {
+        return true;
+    }
+    TestAssert(_cpu->isRecompiling(), "Recompiler should be on");
+
+    // the I/O registers take priority over the RAM beneath
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->attach(std::make_shared<Registers>(cpu));
+        cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+    }
+
+    // accesses to a watched page go through the bus
+    uint32_t hitsExpected = 0;
+    uint32_t hitsActual   = 0;
+    _reference->getWatchpoints().add(0x0200, 0x02FF, Watchpoints::WATCH_READ | Watchpoints::WATCH_WRITE,
+        [&hitsExpected](word address, byte type) { hitsExpected++; });
+    _cpu->getWatchpoints().add(0x0200, 0x02FF, Watchpoints::WATCH_READ | Watchpoints::WATCH_WRITE,
+        [&hitsActual](word address, byte type) { hitsActual++; });
+
+    // an IRQ pulse every 1000 cycles
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->getScheduler().schedule(1000, [cpu](uint64_t cycle) {
+            cpu->irq();
+            cpu->getScheduler().schedule(cycle + 1000, [cpu](uint64_t cycle) { cpu->irq(); });
+        });
+    }
+
+    std::vector<byte> memory;
+    for (uint32_t seed = 1; seed <= 24; seed++) {
+        _randomProgram(seed, memory);
+        _load(_reference, memory);
+        _load(_cpu, memory);
+
+        // the I/O registers are not compared, reading them has side effects
+        if (_compare(50000, 997, 0xC000) == false) {
+            TestAssert(false, "Program %u differs", seed);
+        }
+    }
+    TestAssert(hitsActual == hitsExpected, "Expected %u watchpoint hits, got %u", hitsExpected, hitsActual);
+})
+
+TestCase(self_modifying_code, "Self-Modifying Code", {
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+    }
+
+    std::vector<byte> memory(0x10000, 0x00);
+    memcpy(&memory[0x0400], _selfModifying, sizeof(_selfModifying));
+    memory[0xFFFD] = 0x04;
+
+    // the same program twice, the code changed by the host in between
+    for (int pass = 0; pass < 2; pass++) {
+        _load(_reference, memory);
+        _load(_cpu, memory);
+        TestAssert(_compare(20000, 20000), "Pass %d differs", pass);
+        TestAssert(_cpu->isHalted(), "Pass %d should run to the end", pass);
+
+        for (int i = 0; i < 256; i++) {
+            byte data = 0;
+            _cpu->read(word(0x0300 + i), data);
+            TestAssert(data == byte(i + pass * 0x40), "Pass %d: expected 0x%02X at 0x%04X, got 0x%02X", pass,
+                       byte(i + pass * 0x40), 0x0300 + i, data);
+        }
+        memory[0x0403] = 0x40;
+    }
+})
+
+TestCase(bank_switching, "Bank Switching", {
+
+    // two banks at 0x8000, selected by writing to 0x8FFF
+    _attachBanks();
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+    }
+
+    std::vector<byte> memory(0x8000, 0x00);
+    memcpy(&memory[0x0400], _bankSwitching, sizeof(_bankSwitching));
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->writeBlock(0x0000, memory.data(), memory.size());
+        cpu->write(0xFFFC, 0x00);
+        cpu->write(0xFFFD, 0x04);
+        cpu->reset();
+    }
+
+    TestAssert(_compare(20000, 20000), "Expected the same results as the interpreter");
+    TestAssert(_expectBankRoutines(), "Expected the routine of each bank to run");
+})
+
+TestCase(aliased_bank, "Aliased Bank", {
+
+    // the routine shown at 0x9000 is rewritten through 0x8000
+    _attachAliasedBank();
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+    }
+
+    std::vector<byte> memory(0x8000, 0x00);
+    memcpy(&memory[0x0400], _aliasedBank, sizeof(_aliasedBank));
+    memory[0x0010] = 0x11;
+    memory[0x0020] = 0x22;
+    for (CPU *cpu : { _reference, _cpu }) {
+        cpu->writeBlock(0x0000, memory.data(), memory.size());
+        cpu->write(0xFFFC, 0x00);
+        cpu->write(0xFFFD, 0x04);
+        cpu->reset();
+    }
+
+    TestAssert(_compare(20000, 20000), "Expected the same results as the interpreter");
+    TestAssert(_expectAliasedBank(), "Expected the rewritten routine to run");
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestRecompiler, {
+    test_random_programs();
+    test_self_modifying_code();
+    test_bank_switching();
+    test_aliased_bank();
+})
@@ -0,0 +1,140 @@
+//
+//  TestReference.hpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#ifndef __TEST_REFERENCE_HPP__
+#define __TEST_REFERENCE_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <memory>
+#include "TestMacros.hpp"
+#include "../src/BankedMemory.hpp"
+#include "../src/CPU.hpp"
+
+// Harness for the suites that run a CPU with an alternative execution mode (predecoded, recompiled) side by side with
+// a reference CPU on the interpreter, & expect the same results.
+
+using namespace rt_6502_emulator;
+
+static CPU *_cpu;           // CPU under test
+static CPU *_reference;     // interpreter to compare against
+
+// LDX #$00; loop: STX $8FFF; JSR $8000; STA $0300,X; INX; BNE loop; KIL
+static const byte _bankSwitching[] = { 0xA2, 0x00, 0x8E, 0xFF, 0x8F, 0x20, 0x00, 0x80, 0x9D, 0x00, 0x03,
+                                       0xE8, 0xD0, 0xF4, 0x02 };
+
+// LDA #$11; RTS in bank 0, LDA #$22; RTS in bank 1
+static const byte _routines[] = { 0xA9, 0x11, 0x60, 0xA9, 0x22, 0x60 };
+
+// LDX #$00; loop: JSR $9000; STA $0300,X; INX; BNE loop; LDA #$20; STA $8001; JSR $9000; STA $0200; KIL
+static const byte _aliasedBank[] = { 0xA2, 0x00, 0x20, 0x00, 0x90, 0x9D, 0x00, 0x03, 0xE8, 0xD0, 0xF7, 0xA9, 0x20,
+                                     0x8D, 0x01, 0x80, 0x20, 0x00, 0x90, 0x8D, 0x00, 0x02, 0x02 };
+
+
+/// Constructs the CPU under test & the reference, with no devices attached.
+static inline void _createCPUs() {
+    _cpu       = new CPU();
+    _reference = new CPU();
+}
+
+/// Destroys the CPU under test & the reference.
+static inline void _destroyCPUs() {
+    delete _cpu;
+    delete _reference;
+}
+
+/// Attaches two banks at 0x8000 to both CPUs, after any device already attached, selected by writing to 0x8FFF &
+/// holding the `_routines` at the same address.
+static inline void _attachBanks() {
+    for (CPU *cpu : { _reference, _cpu }) {
+        std::shared_ptr<BankedMemory> banks = std::make_shared<BankedMemory>(0x2000, 0x8000, 0x8FFF, 0x1000);
+        banks->addRegister(0x8FFF, 0);
+        memcpy(banks->data(),          _routines,     3);
+        memcpy(banks->data() + 0x1000, _routines + 3, 3);
+        cpu->attach(banks);
+    }
+}
+
+/// Attaches a bank shown at both 0x8000 & 0x9000 to both CPUs, after any device already attached, holding the
+/// routine `LDA $10; RTS`. Used with `_aliasedBank`, which rewrites the operand of the routine through 0x8000.
+static inline void _attachAliasedBank() {
+    static const byte routine[] = { 0xA5, 0x10, 0x60 };
+    for (CPU *cpu : { _reference, _cpu }) {
+        std::shared_ptr<BankedMemory> banks = std::make_shared<BankedMemory>(0x2000, 0x8000, 0x9FFF, 0x1000);
+        memcpy(banks->data(), routine, sizeof(routine));
+        banks->select(1, 0);
+        cpu->attach(banks);
+    }
+}
+
+/// Checks the results of `_aliasedBank`, with 0x11 at 0x0010 & 0x22 at 0x0020: the routine loads from 0x0020 once
+/// rewritten.
+static inline bool _expectAliasedBank() {
+    TestAssert(_cpu->isHalted(), "Program should run to the end");
+    for (int i = 0; i < 256; i++) {
+        byte data = 0;
+        _cpu->read(word(0x0300 + i), data);
+        TestAssert(data == 0x11, "Expected 0x11 at 0x%04X, got 0x%02X", 0x0300 + i, data);
+    }
+    byte data = 0;
+    _cpu->read(0x0200, data);
+    TestAssert(data == 0x22, "Expected the rewritten routine to load 0x22, got 0x%02X", data);
+    return true;
+}
+
+/// Checks the results of `_bankSwitching`: the routine of each bank stored in turn from 0x0300.
+static inline bool _expectBankRoutines() {
+    TestAssert(_cpu->isHalted(), "Program should run to the end");
+    for (int i = 0; i < 256; i++) {
+        byte data = 0;
+        _cpu->read(word(0x0300 + i), data);
+        TestAssert(data == ((i & 1) ? 0x22 : 0x11), "Expected the routine of bank %d to run, got 0x%02X", i & 1,
+                   data);
+    }
+    return true;
+}
+
+/// Runs both CPUs in slices of the given number of clock cycles & compares their state after every slice.
+///
+/// @param size number of bytes of memory compared from 0x0000. memory with side effects on read is left out
+static inline bool _compare(uint64_t cycles, uint64_t slice, size_t size = 0x10000) {
+    static byte expected[0x10000];
+    static byte actual[0x10000];
+
+    for (uint64_t elapsed = 0; elapsed < cycles; elapsed += slice) {
+        uint64_t excessExpected = _reference->run(slice);
+        uint64_t excessActual   = _cpu->run(slice);
+
+        TestAssert(excessActual == excessExpected, "Run %llu: expected excess of %llu cycles, got %llu",
+                   (unsigned long long)elapsed, (unsigned long long)excessExpected,
+                   (unsigned long long)excessActual);
+        TestAssert(_cpu->getCycles() == _reference->getCycles() &&
+                   _cpu->getProgramCounter() == _reference->getProgramCounter(),
+                   "Run %llu: expected PC 0x%04X at cycle %llu, got 0x%04X at cycle %llu",
+                   (unsigned long long)elapsed, _reference->getProgramCounter(),
+                   (unsigned long long)_reference->getCycles(), _cpu->getProgramCounter(),
+                   (unsigned long long)_cpu->getCycles());
+        TestAssert(_cpu->getAccumulator() == _reference->getAccumulator() &&
+                   _cpu->getIndexX() == _reference->getIndexX() && _cpu->getIndexY() == _reference->getIndexY() &&
+                   _cpu->getStackPointer() == _reference->getStackPointer() &&
+                   _cpu->getStatus() == _reference->getStatus(),
+                   "Run %llu: registers differ. expected A 0x%02X X 0x%02X Y 0x%02X S 0x%02X P 0x%02X, "
+                   "got A 0x%02X X 0x%02X Y 0x%02X S 0x%02X P 0x%02X", (unsigned long long)elapsed,
+                   _reference->getAccumulator(), _reference->getIndexX(), _reference->getIndexY(),
+                   _reference->getStackPointer(), _reference->getStatus(), _cpu->getAccumulator(),
+                   _cpu->getIndexX(), _cpu->getIndexY(), _cpu->getStackPointer(), _cpu->getStatus());
+
+        _reference->readBlock(0x0000, expected, size);
+        _cpu->readBlock(0x0000, actual, size);
+        TestAssert(memcmp(expected, actual, size) == 0, "Run %llu: memory differs", (unsigned long long)elapsed);
+    }
+    return true;
+}
+
+#endif // __TEST_REFERENCE_HPP__
@@ -0,0 +1,147 @@
+//
+//  TestScheduler.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <vector>
+#include "TestMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+#include "../src/Scheduler.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static CPU *_cpu;
+
+TestSetUp({
+    _cpu = new CPU();
+    _cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+
+    // CLI; loop: JMP loop
+    word address = 0x0400;
+    for (byte data : { 0x58, 0x4C, 0x01, 0x04 }) {
+        _cpu->write(address++, data);
+    }
+
+    // IRQ: INY; RTI
+    _cpu->write(0x0480, 0xC8);
+    _cpu->write(0x0481, 0x40);
+
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x04);
+    _cpu->write(0xFFFE, 0x80);
+    _cpu->write(0xFFFF, 0x04);
+    _cpu->reset();
+})
+
+TestTearDown({
+    delete _cpu;
+})
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(order, "Order", {
+    Scheduler        scheduler;
+    std::vector<int> order;
+
+    scheduler.schedule(20, [&order](uint64_t cycle) { order.push_back(3); });
+    scheduler.schedule(10, [&order](uint64_t cycle) { order.push_back(1); });
+    scheduler.schedule(10, [&order](uint64_t cycle) { order.push_back(2); });
+    Scheduler::EventId id = scheduler.schedule(15, [&order](uint64_t cycle) { order.push_back(0); });
+    TestAssert(scheduler.nextEvent() == 10, "Expected next event at 10, got %llu",
+        (unsigned long long)scheduler.nextEvent());
+
+    // cancelled events are not dispatched
+    TestAssert(scheduler.cancel(id), "Event should be cancelled");
+    TestAssert(scheduler.cancel(id) == false, "Event should only be cancelled once");
+
+    scheduler.dispatch(9);
+    TestAssert(order.empty(), "No event should be due");
+
+    // events due on the same cycle are dispatched in the order they were scheduled
+    scheduler.dispatch(25);
+    TestAssert(order.size() == 3, "Expected 3 events dispatched, got %zu", order.size());
+    TestAssert(order[0] == 1 && order[1] == 2 && order[2] == 3, "Events dispatched out of order");
+    TestAssert(scheduler.nextEvent() == UINT64_MAX, "No event should be left");
+})
+
+TestCase(reschedule, "Reschedule", {
+    Scheduler             scheduler;
+    std::vector<uint64_t> cycles;
+
+    // a periodic event reschedules itself from its deadline
+    std::function<void (uint64_t)> tick = [&](uint64_t cycle) {
+        cycles.push_back(cycle);
+        scheduler.schedule(cycle + 100, tick);
+    };
+    scheduler.schedule(100, tick);
+
+    scheduler.dispatch(350);
+    TestAssert(cycles.size() == 3, "Expected 3 events dispatched, got %zu", cycles.size());
+    TestAssert(cycles[2] == 300, "Expected the last event at 300, got %llu", (unsigned long long)cycles[2]);
+    TestAssert(scheduler.size() == 1, "Expected 1 event left, got %zu", scheduler.size());
+    TestAssert(scheduler.nextEvent() == 400, "Expected next event at 400, got %llu",
+        (unsigned long long)scheduler.nextEvent());
+})
+
+TestCase(timer_interrupts, "Timer Interrupts", {
+    _cpu->run(8 + 2);
+
+    // a timer raising an interrupt every 1000 cycles, while the program idles
+    Scheduler &scheduler = _cpu->getScheduler();
+    uint64_t   start     = _cpu->getCycles();
+    std::function<void (uint64_t)> timer = [&](uint64_t cycle) {
+        _cpu->irq();
+        scheduler.schedule(cycle + 1000, timer);
+    };
+    scheduler.schedule(start + 1000, timer);
+
+    // the last interrupt is raised at the end of the run & not serviced yet
+    _cpu->run(10000);
+    TestAssert(_cpu->getIndexY() == 9, "Expected 9 interrupts serviced, got %d", _cpu->getIndexY());
+    TestAssert(scheduler.nextEvent() == start + 11000, "Expected next event at %llu, got %llu",
+        (unsigned long long)(start + 11000), (unsigned long long)scheduler.nextEvent());
+
+    // ticking dispatches events as well
+    while (_cpu->getCycles() < start + 11000 + 20) {
+        _cpu->tick();
+    }
+    TestAssert(_cpu->getIndexY() == 11, "Expected 11 interrupts serviced, got %d", _cpu->getIndexY());
+    scheduler.clear();
+})
+
+TestCase(tick_boundaries, "Tick Boundaries", {
+    _cpu->step();
+    _cpu->step();
+
+    // an event due in the middle of JMP is dispatched once it completes, in both cores
+    Scheduler &scheduler = _cpu->getScheduler();
+    for (int i = 0; i < 2; i++) {
+        _cpu->setCycleAccurate(i == 1);
+        uint64_t start      = _cpu->getCycles();
+        uint64_t dispatched = 0;
+        scheduler.schedule(start + 1, [&dispatched](uint64_t cycle) { dispatched = _cpu->getCycles(); });
+        for (int t = 0; t < 6; t++) {
+            _cpu->tick();
+        }
+        TestAssert(dispatched == start + 3, "Expected the event dispatched at %llu, got %llu",
+            (unsigned long long)(start + 3), (unsigned long long)dispatched);
+    }
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestScheduler, {
+    test_order();
+    test_reschedule();
+    test_timer_interrupts();
+    test_tick_boundaries();
+});
@@ -0,0 +1,150 @@
+//
+//  TestSnapshot.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <initializer_list>
+#include <vector>
+#include "TestMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+#include "../src/Snapshot.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static CPU *_cpu;
+
+/// Builds a system with RAM split over two devices, running a loop that fills 0x2000 - 0x20FF with a counter.
+static CPU *_system() {
+    CPU *cpu = new CPU();
+    cpu->attach(std::make_shared<Memory>(true, 0x0000, 0x7FFF));
+    cpu->attach(std::make_shared<Memory>(true, 0x8000, 0xFFFF));
+
+    word address = 0x0400;
+    for (byte data : {
+        0xA0, 0x00,                     // LDY #$00
+        0x98,                           // TYA
+        0x65, 0x10,                     // ADC $10
+        0x99, 0x00, 0x20,               // STA $2000,Y
+        0xE6, 0x10,                     // INC $10
+        0xC8,                           // INY
+        0xD0, 0xF5,                     // BNE $0402
+        0x4C, 0x00, 0x04,               // JMP $0400
+    }) {
+        cpu->write(address++, data);
+    }
+    cpu->write(0xFFFC, 0x00);
+    cpu->write(0xFFFD, 0x04);
+    cpu->reset();
+    return cpu;
+}
+
+TestSetUp({
+    _cpu = _system();
+})
+
+TestTearDown({
+    delete _cpu;
+})
+
+/// Captures the registers & memory contents of a CPU for comparison.
+static std::vector<uint64_t> _state(CPU &cpu) {
+    std::vector<uint64_t> state = {
+        cpu.getAccumulator(), cpu.getIndexX(), cpu.getIndexY(), cpu.getStackPointer(), cpu.getStatus(),
+        cpu.getProgramCounter(), cpu.getCycles(), cpu.isOperationComplete(),
+    };
+    for (uint32_t address = 0x0000; address <= 0xFFFF; address++) {
+        byte data;
+        cpu.read(word(address), data);
+        state.push_back(data);
+    }
+    return state;
+}
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(round_trip, "Round Trip", {
+    _cpu->run(10000);
+
+    Snapshot snapshot;
+    _cpu->save(snapshot);
+    std::vector<uint64_t> saved = _state(*_cpu);
+
+    _cpu->run(5000);
+    std::vector<uint64_t> expected = _state(*_cpu);
+
+    // restore twice to make sure the snapshot is not consumed
+    for (int i = 0; i < 2; i++) {
+        TestAssert(_cpu->restore(snapshot), "Restore %d failed", i);
+        TestAssert(_state(*_cpu) == saved, "State after restore %d does not match saved state", i);
+
+        _cpu->run(5000);
+        TestAssert(_state(*_cpu) == expected, "Run after restore %d diverged", i);
+    }
+
+    // restore into a fresh system through the serialized form
+    Snapshot copy(snapshot.data().data(), snapshot.data().size());
+    CPU *other = _system();
+    TestAssert(other->restore(copy), "Restore into another system failed");
+    TestAssert(_state(*other) == saved, "State of other system does not match saved state");
+    delete other;
+})
+
+TestCase(operation_in_progress, "Operation In Progress", {
+    _cpu->setCycleAccurate(true);
+    _cpu->run(1000);
+
+    // save part way through an operation
+    while (_cpu->isOperationComplete()) {
+        _cpu->tick();
+    }
+    Snapshot snapshot;
+    _cpu->save(snapshot);
+
+    _cpu->step();
+    _cpu->step();
+    std::vector<uint64_t> expected = _state(*_cpu);
+
+    TestAssert(_cpu->restore(snapshot), "Restore failed");
+    TestAssert(_cpu->isOperationComplete() == false, "Operation in progress was not restored");
+    _cpu->step();
+    _cpu->step();
+    TestAssert(_state(*_cpu) == expected, "Run after restore diverged");
+})
+
+TestCase(invalid, "Invalid Snapshots", {
+    Snapshot snapshot;
+    _cpu->save(snapshot);
+    std::vector<byte> data = snapshot.data();
+
+    // different devices attached
+    CPU other;
+    other.attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+    TestAssert(other.restore(snapshot) == false, "Restore into a different system should fail");
+
+    // truncated
+    Snapshot truncated(data.data(), data.size() - 1);
+    TestAssert(_cpu->restore(truncated) == false, "Restore of a truncated snapshot should fail");
+
+    // bad magic number
+    data[0] ^= 0xFF;
+    Snapshot corrupted(data.data(), data.size());
+    TestAssert(_cpu->restore(corrupted) == false, "Restore of a snapshot with a bad magic number should fail");
+    TestAssert(_cpu->restore(snapshot), "Restore of the valid snapshot failed");
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestSnapshot, {
+    test_round_trip();
+    test_operation_in_progress();
+    test_invalid();
+});
@@ -0,0 +1,245 @@
+//
+//  TestTrace.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <stdio.h>
+#include <initializer_list>
+#include <vector>
+#include "TestMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+#include "../src/TraceRecorder.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static CPU *_cpu;
+
+TestSetUp({
+    _cpu = new CPU();
+    _cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+
+    word address = 0x0400;
+    for (byte data : {
+        0xA2, 0x03,                     // LDX #$03
+        0xBD, 0x00, 0x05,               // LDA $0500,X
+        0x8D, 0x00, 0x06,               // STA $0600
+        0xCA,                           // DEX
+        0xD0, 0xF7,                     // BNE $0402
+        0x58,                           // CLI
+        0x4C, 0x0C, 0x04,               // JMP $040C
+    }) {
+        _cpu->write(address++, data);
+    }
+    _cpu->write(0x0480, 0x40);          // IRQ: RTI
+    _cpu->write(0x0503, 0x42);
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x04);
+    _cpu->write(0xFFFE, 0x80);
+    _cpu->write(0xFFFF, 0x04);
+    _cpu->reset();
+    _cpu->step();
+})
+
+TestTearDown({
+    delete _cpu;
+})
+
+/// Reads back the trace written to the given file.
+static bool _decode(FILE *file, std::vector<TraceRecorder::Entry> &entries) {
+    std::vector<byte> data;
+    byte              buffer[1024];
+    std::size_t       size;
+    fseek(file, 0, SEEK_SET);
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + size);
+    }
+    return TraceRecorder::decode(data.data(), data.size(), entries);
+}
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+#ifndef RT_6502_EMULATOR_NO_TRACE
+TestCase(record, "Record", {
+    std::shared_ptr<TraceRecorder> recorder = std::make_shared<TraceRecorder>();
+    _cpu->setTraceRecorder(recorder);
+
+    // loop, then an interrupt while jumping in place
+    for (int i = 0; i < 14; i++) {
+        _cpu->step();
+    }
+    _cpu->irq();
+    _cpu->step();
+    _cpu->step();
+
+    FILE *file = tmpfile();
+    TestAssert(recorder->write(file), "Writing the trace failed");
+    std::vector<TraceRecorder::Entry> entries;
+    TestAssert(_decode(file, entries), "Decoding the trace failed");
+    fclose(file);
+
+    TestAssert(entries.size() == 16, "Expected 16 records, got %zu", entries.size());
+
+    const TraceRecorder::Entry &load = entries[1];
+    TestAssert(load.pc == 0x0402 && load.opCode == 0xBD, "Expected LDA $0500,X at 0x0402");
+    TestAssert(load.length == 2 && load.operand[0] == 0x00 && load.operand[1] == 0x05, "Incorrect operand");
+    TestAssert(load.hasAddress && load.address == 0x0503, "Expected effective address 0x0503");
+    TestAssert(load.acc == 0x42 && load.idx == 0x03, "Incorrect registers after LDA");
+
+    const TraceRecorder::Entry &branch = entries[4];
+    TestAssert(branch.opCode == 0xD0 && branch.address == 0x0402, "Expected BNE to 0x0402");
+    TestAssert(entries[5].pc == 0x0402, "Expected the loop to continue at 0x0402");
+
+    const TraceRecorder::Entry &irq = entries[14];
+    TestAssert(irq.interruptType == CPU::INTERRUPT_TYPE_MASKABLE, "Expected an IRQ record");
+    TestAssert(irq.pc == 0x040C && irq.stackP == 0xFA, "Incorrect IRQ record");
+    TestAssert(entries[15].pc == 0x0480 && entries[15].opCode == 0x40, "Expected RTI at 0x0480");
+})
+
+TestCase(ring_buffer, "Ring Buffer", {
+    std::shared_ptr<TraceRecorder> recorder = std::make_shared<TraceRecorder>(256, 64);
+    _cpu->setTraceRecorder(recorder);
+    _cpu->run(10000);
+
+    FILE *file = tmpfile();
+    recorder->write(file);
+    std::vector<TraceRecorder::Entry> entries;
+    TestAssert(_decode(file, entries), "Decoding the trace failed");
+    fclose(file);
+
+    // only the most recent records are kept & the last one matches the state of the CPU
+    TestAssert(entries.size() > 0 && entries.size() < 256, "Expected the oldest records to be dropped");
+    const TraceRecorder::Entry &last = entries.back();
+    TestAssert(last.pc == 0x040C && last.opCode == 0x4C, "Expected the last record to be JMP $040C");
+    TestAssert(last.acc == _cpu->getAccumulator() && last.status == _cpu->getStatus(), "Incorrect registers");
+})
+#endif
+
+TestCase(stream, "Stream", {
+
+    // the same trace is recorded by both cores
+    std::vector<TraceRecorder::Entry> entries[2];
+    for (int i = 0; i < 2; i++) {
+        _cpu->reset();
+        _cpu->step();
+        _cpu->setCycleAccurate(i == 1);
+
+        FILE *file = tmpfile();
+        _cpu->setTraceRecorder(std::make_shared<TraceRecorder>(file, 64));
+        _cpu->run(200);
+        _cpu->setTraceRecorder(nullptr);
+        TestAssert(_decode(file, entries[i]), "Decoding the trace failed");
+        fclose(file);
+    }
+
+    TestAssert(entries[0].size() == entries[1].size(), "Record count mismatch");
+    for (std::size_t i = 0; i < entries[0].size(); i++) {
+        const TraceRecorder::Entry &a = entries[0][i];
+        const TraceRecorder::Entry &b = entries[1][i];
+        TestAssert(a.pc == b.pc && a.opCode == b.opCode && a.address == b.address && a.acc == b.acc &&
+                   a.idx == b.idx && a.status == b.status, "Record %zu mismatch", i);
+    }
+})
+
+#ifndef RT_6502_EMULATOR_NO_TRACE
+TestCase(large_blocks, "Large Blocks", {
+
+    // blocks larger than their length prefix can hold are capped
+    FILE *file = tmpfile();
+    _cpu->setTraceRecorder(std::make_shared<TraceRecorder>(file, 1 << 20));
+    _cpu->run(600000);
+    _cpu->setTraceRecorder(nullptr);
+
+    std::vector<TraceRecorder::Entry> entries;
+    TestAssert(_decode(file, entries), "Decoding the trace failed");
+    fclose(file);
+    TestAssert(entries.size() > 0x10000, "Expected more than 0x10000 records, got %zu", entries.size());
+    TestAssert(entries.back().pc == 0x040C && entries.back().opCode == 0x4C,
+               "Expected the last record to be JMP $040C");
+})
+
+TestCase(stream_failure, "Stream Failure", {
+
+    // writes to a stream opened for reading fail, which is reported on flush
+    FILE *file = fopen("/dev/null", "r");
+    TestAssert(file != nullptr, "Opening /dev/null failed");
+    std::shared_ptr<TraceRecorder> recorder = std::make_shared<TraceRecorder>(file, 64);
+    _cpu->setTraceRecorder(recorder);
+    _cpu->run(200);
+    _cpu->setTraceRecorder(nullptr);
+    TestAssert(recorder->flush() == false, "Expected the failed writes to be reported");
+    recorder.reset();
+    fclose(file);
+
+    file = tmpfile();
+    recorder = std::make_shared<TraceRecorder>(file, 64);
+    _cpu->setTraceRecorder(recorder);
+    _cpu->run(200);
+    _cpu->setTraceRecorder(nullptr);
+    TestAssert(recorder->flush(), "Expected the writes to succeed");
+    recorder.reset();
+    fclose(file);
+})
+
+TestCase(self_modified_operand, "Self Modified Operand", {
+
+    // LDA #$55; STA $0703; KIL. the store overwrites its own operand
+    word address = 0x0700;
+    for (byte data : { 0xA9, 0x55, 0x8D, 0x03, 0x07, 0x02 }) {
+        _cpu->write(address++, data);
+    }
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x07);
+
+    // the operands are recorded as both cores read them, not as they are after the operation
+    for (int i = 0; i < 2; i++) {
+        _cpu->write(0x0703, 0x03);
+        _cpu->reset();
+        _cpu->step();
+        _cpu->setCycleAccurate(i == 1);
+
+        std::shared_ptr<TraceRecorder> recorder = std::make_shared<TraceRecorder>();
+        _cpu->setTraceRecorder(recorder);
+        _cpu->run(10);
+        _cpu->setTraceRecorder(nullptr);
+
+        FILE *file = tmpfile();
+        TestAssert(recorder->write(file), "Writing the trace failed");
+        std::vector<TraceRecorder::Entry> entries;
+        TestAssert(_decode(file, entries), "Decoding the trace failed");
+        fclose(file);
+
+        TestAssert(entries.size() >= 2, "Expected at least 2 records, got %zu", entries.size());
+        TestAssert(entries[0].length == 1 && entries[0].operand[0] == 0x55, "Incorrect operand for LDA #$55");
+        TestAssert(entries[1].length == 2 && entries[1].operand[0] == 0x03 && entries[1].operand[1] == 0x07,
+                   "Expected the operand of STA as read, got 0x%02X 0x%02X", entries[1].operand[0],
+                   entries[1].operand[1]);
+        byte data = 0;
+        _cpu->read(0x0703, data);
+        TestAssert(data == 0x55, "Expected the store to overwrite its operand");
+    }
+})
+#endif
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestTrace, {
+#ifndef RT_6502_EMULATOR_NO_TRACE
+    test_record();
+    test_ring_buffer();
+#endif
+    test_stream();
+#ifndef RT_6502_EMULATOR_NO_TRACE
+    test_large_blocks();
+    test_stream_failure();
+    test_self_modified_operand();
+#endif
+});
@@ -0,0 +1,124 @@
+//
+//  TestWatchpoints.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+
+#include <vector>
+#include "TestMacros.hpp"
+#include "../src/CPU.hpp"
+#include "../src/Memory.hpp"
+#include "../src/Watchpoints.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// setup & teardown ----------------------------------------------------------------------------------------------------
+
+static CPU *_cpu;
+
+// loop: LDA $0210; STA $0211; INC $20; JMP loop
+static const byte _program[] = { 0xAD, 0x10, 0x02, 0x8D, 0x11, 0x02, 0xE6, 0x20, 0x4C, 0x00, 0x04 };
+
+TestSetUp({
+    _cpu = new CPU();
+    _cpu->attach(std::make_shared<Memory>(true, 0x0000, 0xFFFF));
+
+    word address = 0x0400;
+    for (byte data : _program) {
+        _cpu->write(address++, data);
+    }
+    _cpu->write(0x0210, 0x42);
+    _cpu->write(0xFFFC, 0x00);
+    _cpu->write(0xFFFD, 0x04);
+    _cpu->reset();
+    _cpu->step();
+})
+
+TestTearDown({
+    delete _cpu;
+})
+
+
+// test cases ----------------------------------------------------------------------------------------------------------
+
+TestCase(access_types, "Access Types", {
+    Watchpoints      &watchpoints = _cpu->getWatchpoints();
+    std::vector<word> reads;
+    std::vector<word> writes;
+    std::vector<word> executes;
+
+    watchpoints.add(0x0210, 0x0211, Watchpoints::WATCH_READ, [&reads](word address, byte type) {
+        reads.push_back(address);
+    });
+    watchpoints.add(0x0200, 0x02FF, Watchpoints::WATCH_WRITE, [&writes](word address, byte type) {
+        writes.push_back(address);
+    });
+    Watchpoints::WatchpointId id = watchpoints.add(0x0406, 0x0406, Watchpoints::WATCH_EXECUTE,
+        [&executes](word address, byte type) {
+        executes.push_back(address);
+    });
+
+    // a single iteration of the loop. INC $20 reads & writes the zero page, which is not watched
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(reads.size() == 1 && reads[0] == 0x0210, "Expected a read of 0x0210");
+    TestAssert(writes.size() == 1 && writes[0] == 0x0211, "Expected a write to 0x0211");
+    TestAssert(executes.size() == 1 && executes[0] == 0x0406, "Expected INC at 0x0406 to be executed");
+
+    // removed watchpoints are not hit
+    TestAssert(watchpoints.remove(id), "Watchpoint should be removed");
+    TestAssert(watchpoints.remove(id) == false, "Watchpoint should only be removed once");
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(executes.size() == 1, "Removed watchpoint should not be hit");
+    TestAssert(reads.size() == 2 && writes.size() == 2, "Expected a read & a write per iteration");
+
+    // the cycle accurate core watches the same accesses
+    _cpu->setCycleAccurate(true);
+    _cpu->step();
+    _cpu->step();
+    _cpu->step();
+    TestAssert(reads.size() == 3 && writes.size() == 3, "Expected a read & a write per iteration");
+    watchpoints.clear();
+    TestAssert(watchpoints.isWatched(0x02, Watchpoints::WATCH_READ) == false, "No page should be watched");
+})
+
+TestCase(stop, "Stop", {
+
+    // break on the 5th write to the counter
+    int count = 0;
+    _cpu->getWatchpoints().add(0x0020, 0x0020, Watchpoints::WATCH_WRITE, [&count](word address, byte type) {
+        if (++count == 5) {
+            _cpu->stop();
+        }
+    });
+
+    _cpu->run(100000);
+    TestAssert(_cpu->isStopped(), "Run should be stopped");
+    TestAssert(count == 5, "Expected to stop on the 5th write, got %d", count);
+    TestAssert(_cpu->getProgramCounter() == 0x0408, "Expected to stop after INC, at 0x0408, got 0x%04X",
+        _cpu->getProgramCounter());
+
+    byte data = 0x00;
+    _cpu->read(0x0020, data);
+    TestAssert(data == 5, "Expected counter of 5, got %d", data);
+
+    // running again carries on
+    _cpu->getWatchpoints().clear();
+    _cpu->run(100);
+    TestAssert(_cpu->isStopped() == false, "Run should not be stopped");
+})
+
+
+// test suite ----------------------------------------------------------------------------------------------------------
+
+TestSuite(TestWatchpoints, {
+    test_access_types();
+    test_stop();
+});
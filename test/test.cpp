@@ -13,5 +13,17 @@ int main() {
     RunTestSuite(TestMemory);
     RunTestSuite(TestBus);
     RunTestSuite(TestInstructions);
+    RunTestSuite(TestExecution);
+    RunTestSuite(TestCycleAccurate);
+    RunTestSuite(TestBatchRunner);
+    RunTestSuite(TestSnapshot);
+    RunTestSuite(TestTrace);
+    RunTestSuite(TestProfiler);
+    RunTestSuite(TestScheduler);
+    RunTestSuite(TestROM);
+    RunTestSuite(TestBankedMemory);
+    RunTestSuite(TestWatchpoints);
+    RunTestSuite(TestBlockCache);
+    RunTestSuite(TestRecompiler);
     return 0;
 }
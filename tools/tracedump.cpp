@@ -0,0 +1,115 @@
+//
+//  tracedump.cpp
+//  6502-emulator
+//
+//  Created by Rakesh Ayyaswami on 18 Oct 2026.
+//  Copyright (c) 2026 Rakesh Ayyaswami. All rights reserved.
+//
+//  Decodes a trace file written by `TraceRecorder` into a disassembly listing with the registers after each
+//  operation.
+//
+//  usage: tracedump <trace file>
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "../src/TraceRecorder.hpp"
+
+using namespace rt_6502_emulator;
+
+
+// op codes ------------------------------------------------------------------------------------------------------------
+
+typedef struct _OpCode {
+    const char *inst;
+    const char *addr;
+} OpCode;
+
+static OpCode _opCodes[256];
+
+static void _initOpCodes() {
+    #define CPU_OP(code, inst, addr, cycles) _opCodes[code] = (OpCode){ #inst, #addr };
+    #include "../src/CPUOperations.def"
+    #undef CPU_OP
+}
+
+/// Formats the operand of an instruction in assembler syntax.
+static void _formatOperand(const TraceRecorder::Entry &entry, char *buffer, std::size_t size) {
+    const char *addr    = _opCodes[entry.opCode].addr;
+    unsigned    operand = entry.operand[0] | (entry.length > 1 ? entry.operand[1] << 8 : 0);
+
+    if      (strcmp(addr, "IMP") == 0) snprintf(buffer, size, "%s", "");
+    else if (strcmp(addr, "ACC") == 0) snprintf(buffer, size, "A");
+    else if (strcmp(addr, "IMM") == 0) snprintf(buffer, size, "#$%02X", operand);
+    else if (strcmp(addr, "ZPG") == 0) snprintf(buffer, size, "$%02X", operand);
+    else if (strcmp(addr, "ZPX") == 0) snprintf(buffer, size, "$%02X,X", operand);
+    else if (strcmp(addr, "ZPY") == 0) snprintf(buffer, size, "$%02X,Y", operand);
+    else if (strcmp(addr, "REL") == 0) snprintf(buffer, size, "$%04X", entry.address);
+    else if (strcmp(addr, "ABS") == 0) snprintf(buffer, size, "$%04X", operand);
+    else if (strcmp(addr, "ABX") == 0) snprintf(buffer, size, "$%04X,X", operand);
+    else if (strcmp(addr, "ABY") == 0) snprintf(buffer, size, "$%04X,Y", operand);
+    else if (strcmp(addr, "IND") == 0) snprintf(buffer, size, "($%04X)", operand);
+    else if (strcmp(addr, "IZX") == 0) snprintf(buffer, size, "($%02X,X)", operand);
+    else if (strcmp(addr, "IZY") == 0) snprintf(buffer, size, "($%02X),Y", operand);
+    else                               snprintf(buffer, size, "???");
+}
+
+
+// main ----------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <trace file>\n", argv[0]);
+        return 1;
+    }
+
+    // read the trace file
+    FILE *file = fopen(argv[1], "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+    std::vector<byte> data;
+    byte              buffer[4096];
+    std::size_t       size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + size);
+    }
+    fclose(file);
+
+    std::vector<TraceRecorder::Entry> entries;
+    if (TraceRecorder::decode(data.data(), data.size(), entries) == false) {
+        fprintf(stderr, "%s: %s is not a valid trace\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    // one line per operation
+    _initOpCodes();
+    for (const TraceRecorder::Entry &entry : entries) {
+        char bytes[16], instruction[32], operand[16], address[16];
+        if (entry.interruptType) {
+            snprintf(bytes, sizeof(bytes), "%s", "");
+            snprintf(instruction, sizeof(instruction), "*** %s ***", entry.interruptType == 1 ? "IRQ" : "NMI");
+            snprintf(address, sizeof(address), "%s", "");
+        }
+        else {
+            snprintf(bytes, sizeof(bytes), "%02X", entry.opCode);
+            for (byte i = 0; i < entry.length; i++) {
+                snprintf(bytes + 2 + i * 3, sizeof(bytes) - 2 - i * 3, " %02X", entry.operand[i]);
+            }
+            _formatOperand(entry, operand, sizeof(operand));
+            snprintf(instruction, sizeof(instruction), "%s %s", _opCodes[entry.opCode].inst, operand);
+            if (entry.hasAddress) {
+                snprintf(address, sizeof(address), "[$%04X]", entry.address);
+            }
+            else {
+                snprintf(address, sizeof(address), "%s", "");
+            }
+        }
+
+        printf("%04X  %-9s %-16s %-8s A=%02X X=%02X Y=%02X SP=%02X P=%02X\n", entry.pc, bytes, instruction, address,
+               entry.acc, entry.idx, entry.idy, entry.stackP, entry.status);
+    }
+    return 0;
+}